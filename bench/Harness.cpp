@@ -0,0 +1,57 @@
+#include "Harness.h"
+
+#include <omp.h>
+
+#include <chrono>
+#include <cmath>
+#include <random>
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+double runBatch(Fixture &fixture, size_t batch) {
+  const auto start = Clock::now();
+  for (size_t i = 0; i < batch; i++) fixture.run();
+  return std::chrono::duration<double>(Clock::now() - start).count();
+}
+}  // namespace
+
+BenchResult measure(const Kernel &kernel, const BenchParameters &parameters, unsigned int samples, double min_time) {
+  omp_set_num_threads(parameters.threads);
+  const auto fixture = kernel.create(parameters);
+
+  BenchResult result{kernel.name, kernel.unit, parameters, 1, {}, 0};
+  // the first call warms up caches and the thread pool and estimates the duration of a call
+  const double first = runBatch(*fixture, 1);
+  if (first < min_time) result.batch = static_cast<size_t>(std::ceil(min_time / std::max(first, 1e-9)));
+
+  std::vector<double> times;
+  for (unsigned int i = 0; i < samples; i++) {
+    times.push_back(runBatch(*fixture, result.batch) / static_cast<double>(result.batch));
+  }
+  result.seconds = Benchmark::summarize(times);
+  if (result.seconds.median > 0) result.items_per_second = fixture->items() / result.seconds.median;
+  return result;
+}
+
+std::vector<Particle> latticeParticles(const BenchParameters &parameters, Vector3 &domain) {
+  const auto per_side = static_cast<size_t>(std::ceil(std::cbrt(static_cast<double>(parameters.particles))));
+  const double spacing = std::cbrt(1.0 / parameters.density);
+  const double side = static_cast<double>(per_side) * spacing;
+  domain = {side, side, side};
+
+  // fixed seed, so every run measures the same configuration
+  std::mt19937_64 random(42);
+  std::uniform_real_distribution<double> jitter(-0.1 * spacing, 0.1 * spacing);
+  std::vector<Particle> particles;
+  particles.reserve(parameters.particles);
+  for (size_t i = 0; i < parameters.particles; i++) {
+    const size_t x = i % per_side;
+    const size_t y = i / per_side % per_side;
+    const size_t z = i / (per_side * per_side);
+    particles.emplace_back(Vector3{(x + 0.5) * spacing + jitter(random), (y + 0.5) * spacing + jitter(random),
+                                   (z + 0.5) * spacing + jitter(random)},
+                           Vector3{0, 0, 0}, 1.0, 0);
+  }
+  return particles;
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "benchmark/Benchmark.h"
+
+/**
+ * @struct BenchParameters
+ * @brief Parameters of a single micro-benchmark run
+ */
+struct BenchParameters {
+  /** @brief Number of particles */
+  size_t particles = 1000;
+  /** @brief Particles per unit volume */
+  double density = 0.8;
+  /** @brief Number of OpenMP threads */
+  int threads = 1;
+};
+
+/**
+ * @class Fixture
+ * @brief State of a kernel that is prepared once and then executed repeatedly
+ */
+class Fixture {
+ public:
+  virtual ~Fixture() = default;
+
+  /**
+   * @brief Executes the measured operation once
+   */
+  virtual void run() = 0;
+
+  /**
+   * @return Number of items (e.g. particles or pairs) processed by one run()
+   */
+  [[nodiscard]] virtual double items() const = 0;
+};
+
+/**
+ * @struct Kernel
+ * @brief A named micro-benchmark
+ */
+struct Kernel {
+  /** @brief Name used for filtering and in the results */
+  std::string name;
+  /** @brief What items() counts, e.g. "particles" or "pairs" */
+  std::string unit;
+  /** @brief Creates the fixture for the given parameters. Called after the number of threads was set */
+  std::function<std::unique_ptr<Fixture>(const BenchParameters &)> create;
+};
+
+/**
+ * @struct BenchResult
+ * @brief Measured time of one kernel with one set of parameters
+ */
+struct BenchResult {
+  /** @brief Name of the kernel */
+  std::string kernel;
+  /** @brief Unit of the items */
+  std::string unit;
+  /** @brief Parameters of the run */
+  BenchParameters parameters;
+  /** @brief Number of run() calls per sample */
+  size_t batch = 1;
+  /** @brief Seconds per run() over all samples */
+  BenchmarkStatistics seconds;
+  /** @brief Items per second based on the median time */
+  double items_per_second = 0;
+};
+
+/**
+ * @return All available kernels
+ */
+std::vector<Kernel> allKernels();
+
+/**
+ * @brief Measures a kernel
+ *
+ * The fixture is created, run once to warm up and to choose how many calls make up a sample of at least min_time
+ * seconds. Then the given number of samples is taken.
+ *
+ * @param kernel Kernel to measure
+ * @param parameters Parameters of the fixture, the number of threads is set before it is created
+ * @param samples Number of samples
+ * @param min_time Minimal duration of a sample in seconds
+ * @return Statistics of the time per call
+ */
+BenchResult measure(const Kernel &kernel, const BenchParameters &parameters, unsigned int samples, double min_time);
+
+/**
+ * @brief Creates particles on a simple cubic lattice with a small random displacement
+ * @param parameters Number of particles and density
+ * @param domain Set to the size of a domain that contains all particles
+ * @return The particles
+ */
+std::vector<Particle> latticeParticles(const BenchParameters &parameters, Vector3 &domain);
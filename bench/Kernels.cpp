@@ -0,0 +1,274 @@
+#include <filesystem>
+#include <limits>
+
+#include "Harness.h"
+#include "Settings.h"
+#include "container/linkedCells/LinkedCells.h"
+#include "outputWriter/CheckpointWriter.h"
+#include "outputWriter/TrajectoryWriter.h"
+#ifdef ENABLE_VTK_OUTPUT
+#include "outputWriter/VTKWriter.h"
+#endif
+#include "outputWriter/XYZWriter.h"
+#include "simulations/Physics.h"
+#include "simulations/Thermostat.h"
+
+namespace {
+constexpr double CUTOFF = 2.5;
+/** @brief Reflecting and periodic borders, so both kinds of ghost particles are created */
+constexpr std::array<BorderType, 6> BORDERS = {BorderType::REFLECTION, BorderType::PERIODIC, BorderType::REFLECTION,
+                                               BorderType::REFLECTION, BorderType::PERIODIC, BorderType::REFLECTION};
+
+/** @brief Written by the kernels, so the compiler can not remove their results */
+volatile double sink = 0;
+
+/**
+ * @brief LinkedCells with access to the single loops of the traversal and the ghost update
+ */
+class BenchLinkedCells : public LinkedCells {
+ public:
+  using LinkedCells::applyToPairsInCells;
+  using LinkedCells::applyToPairsOfBorderCells;
+  using LinkedCells::applyToPairsOfInnerCells;
+  using LinkedCells::LinkedCells;
+  using LinkedCells::updateGhost;
+};
+
+/**
+ * @brief Particles on a lattice sorted into linked cells
+ */
+class CellsFixture : public Fixture {
+ public:
+  explicit CellsFixture(const BenchParameters &parameters)
+      : particles(latticeParticles(parameters, domain)), cells(particles, domain, CUTOFF, false, BORDERS) {
+    cells.updateGhost();
+  }
+
+  [[nodiscard]] double items() const override { return static_cast<double>(particles.size()); }
+
+ protected:
+  Vector3 domain{};
+  std::vector<Particle> particles;
+  BenchLinkedCells cells;
+};
+
+/**
+ * @brief Lennard-Jones force between every particle and its eight successors
+ * @tparam Fast If Physics::LennardJones::fastForce is used instead of Physics::LennardJones::force
+ */
+template <bool Fast>
+class ForceFixture : public Fixture {
+ public:
+  explicit ForceFixture(const BenchParameters &parameters) {
+    Vector3 domain{};
+    particles = latticeParticles(parameters, domain);
+    for (size_t i = 0; i < particles.size(); i++) {
+      for (size_t k = 1; k <= 8 && i + k < particles.size(); k++) pairs.emplace_back(i, i + k);
+    }
+  }
+
+  void run() override {
+    double sum = 0;
+#pragma omp parallel for reduction(+ : sum)
+    for (size_t k = 0; k < pairs.size(); k++) {
+      Particle &p1 = particles[pairs[k].first];
+      Particle &p2 = particles[pairs[k].second];
+      const Vector3 f = Fast ? Physics::LennardJones::fastForce(p1, p2, 1.0, 24.0)
+                             : Physics::LennardJones::force(p1, p2, 1.0, 1.0);
+      sum += f[0] + f[1] + f[2];
+    }
+    sink = sum;
+  }
+
+  [[nodiscard]] double items() const override { return static_cast<double>(pairs.size()); }
+
+ private:
+  std::vector<Particle> particles;
+  std::vector<std::pair<size_t, size_t>> pairs;
+};
+
+/**
+ * @brief Force calculation of the linked cells, completely or one of its three loops
+ */
+class TraversalFixture : public CellsFixture {
+ public:
+  /** @brief Measured part of the traversal */
+  enum class Loop { ALL, CELL, INNER, BORDER };
+
+  TraversalFixture(const BenchParameters &parameters, Loop loop) : CellsFixture(parameters), loop(loop) {}
+
+  void run() override {
+    auto f = [](Particle &p1, Particle &p2) {
+      const Vector3 force = Physics::LennardJones::fastForce(p1, p2, 1.0, 24.0);
+      p1.addF(force);
+      p2.subF(force);
+    };
+    switch (loop) {
+      case Loop::ALL:
+        cells.applyToPairs(f);
+        break;
+      case Loop::CELL:
+#pragma omp parallel
+        cells.applyToPairsInCells<false>(f);
+        break;
+      case Loop::INNER:
+#pragma omp parallel
+        cells.applyToPairsOfInnerCells<false>(f);
+        break;
+      case Loop::BORDER:
+#pragma omp parallel
+        cells.applyToPairsOfBorderCells<false>(f);
+        break;
+    }
+  }
+
+ private:
+  Loop loop;
+};
+
+/**
+ * @brief Moves all particles back and forth by a third of the lattice spacing and updates the cells
+ *
+ * LinkedCells::moveParticles() also updates the ghost particles, subtract update_ghost to get the move alone.
+ */
+class MoveFixture : public CellsFixture {
+ public:
+  explicit MoveFixture(const BenchParameters &parameters)
+      : CellsFixture(parameters), shift(std::cbrt(1.0 / parameters.density) / 3) {}
+
+  void run() override {
+    shift = -shift;
+    const double dx = shift;
+    cells.applyToParticles([dx](Particle &p) { p.setX(p.getX() + Vector3{dx, dx, dx}); });
+    cells.moveParticles();
+  }
+
+ private:
+  double shift;
+};
+
+/**
+ * @brief Recreates the ghost particles of all border cells
+ */
+class GhostFixture : public CellsFixture {
+ public:
+  using CellsFixture::CellsFixture;
+
+  void run() override { cells.updateGhost(); }
+};
+
+/**
+ * @brief Velocity scaling of the thermostat including the kinetic energy reduction
+ */
+class ThermostatFixture : public CellsFixture {
+ public:
+  explicit ThermostatFixture(const BenchParameters &parameters)
+      : CellsFixture(parameters), thermostat(particles, false, 1, 1.0, std::numeric_limits<double>::infinity()) {
+    for (size_t i = 0; i < particles.size(); i++) particles[i].setV({0.1 * (i % 7), -0.2 * (i % 3), 0.05 * (i % 5)});
+  }
+
+  void run() override {
+    const double ekin = cells.reduceMobileParticles([](Particle &p) { return Physics::kineticEnergy(p); });
+    const double factor = thermostat.updateScalingFactor(ekin, cells.alive_particles);
+    cells.applyToMobileParticles([factor](Particle &p) { p.setV(factor * p.getV()); });
+  }
+
+ private:
+  Thermostat thermostat;
+};
+
+/**
+ * @brief Writes the particles with one of the output writers into a temporary directory
+ */
+class WriterFixture : public Fixture {
+ public:
+  /** @brief Output format, VTK only exists if the VTK writer is compiled in */
+  enum class Format {
+    XYZ,
+#ifdef ENABLE_VTK_OUTPUT
+    VTK,
+#endif
+    TRAJECTORY,
+    CHECKPOINT
+  };
+
+  WriterFixture(const BenchParameters &parameters, Format format)
+      : directory(std::filesystem::temp_directory_path() / "molsim_bench"), format(format), settings(particles) {
+    Vector3 domain{};
+    particles = latticeParticles(parameters, domain);
+    // the simulation takes the snapshot before handing it to the writers, so it is not part of the measured time
+    snapshot.assign(particles);
+    std::filesystem::create_directories(directory);
+    if (format == Format::TRAJECTORY) {
+      trajectory = std::make_unique<outputWriter::TrajectoryWriter>(directory / "bench.trj", TrajectoryOptions{});
+    }
+  }
+
+  ~WriterFixture() override {
+    trajectory.reset();
+    std::filesystem::remove_all(directory);
+  }
+
+  void run() override {
+    const std::string prefix = (directory / "bench").string();
+    switch (format) {
+      case Format::XYZ:
+        xyz.plotParticles(snapshot, prefix, 0);
+        break;
+#ifdef ENABLE_VTK_OUTPUT
+      case Format::VTK:
+        vtk.plotParticles(snapshot, prefix, 0, 0.0);
+        break;
+#endif
+      case Format::TRAJECTORY:
+        trajectory->writeFrame(snapshot, iteration++, 0.0);
+        break;
+      case Format::CHECKPOINT:
+        outputWriter::writeCheckpoint(particles, settings, directory / "bench.checkpoint", 0, 0.0, 0.001);
+        break;
+    }
+  }
+
+  [[nodiscard]] double items() const override { return static_cast<double>(particles.size()); }
+
+ private:
+  std::filesystem::path directory;
+  Format format;
+  std::vector<Particle> particles;
+  outputWriter::ParticleSnapshot snapshot;
+  Settings settings;
+  outputWriter::XYZWriter xyz;
+#ifdef ENABLE_VTK_OUTPUT
+  outputWriter::VTKWriter vtk;
+#endif
+  std::unique_ptr<outputWriter::TrajectoryWriter> trajectory;
+  int iteration = 0;
+};
+
+template <typename T, typename... Args>
+std::function<std::unique_ptr<Fixture>(const BenchParameters &)> factory(Args... args) {
+  return [args...](const BenchParameters &parameters) { return std::make_unique<T>(parameters, args...); };
+}
+}  // namespace
+
+std::vector<Kernel> allKernels() {
+  using Loop = TraversalFixture::Loop;
+  using Format = WriterFixture::Format;
+  return {
+      {"lj_force", "pairs", factory<ForceFixture<false>>()},
+      {"lj_fast_force", "pairs", factory<ForceFixture<true>>()},
+      {"pairs_all", "particles", factory<TraversalFixture>(Loop::ALL)},
+      {"pairs_cell", "particles", factory<TraversalFixture>(Loop::CELL)},
+      {"pairs_inner", "particles", factory<TraversalFixture>(Loop::INNER)},
+      {"pairs_border", "particles", factory<TraversalFixture>(Loop::BORDER)},
+      {"move_particles", "particles", factory<MoveFixture>()},
+      {"update_ghost", "particles", factory<GhostFixture>()},
+      {"thermostat", "particles", factory<ThermostatFixture>()},
+      {"write_xyz", "particles", factory<WriterFixture>(Format::XYZ)},
+#ifdef ENABLE_VTK_OUTPUT
+      {"write_vtk", "particles", factory<WriterFixture>(Format::VTK)},
+#endif
+      {"write_trajectory", "particles", factory<WriterFixture>(Format::TRAJECTORY)},
+      {"write_checkpoint", "particles", factory<WriterFixture>(Format::CHECKPOINT)},
+  };
+}
@@ -0,0 +1,219 @@
+/**
+ * @file MolSimBench.cpp
+ *
+ * Micro-benchmarks of the simulation kernels, see printHelp()
+ */
+#include <getopt.h>
+#include <omp.h>
+#include <spdlog/fmt/fmt.h>
+#include <spdlog/spdlog.h>
+#include <unistd.h>
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "Harness.h"
+
+#ifndef MOLSIM_GIT_COMMIT
+#define MOLSIM_GIT_COMMIT "unknown"
+#endif
+#ifndef MOLSIM_BUILD_TYPE
+#define MOLSIM_BUILD_TYPE "unknown"
+#endif
+
+namespace {
+void printHelp() {
+  std::cout << "Micro-benchmarks of the simulation kernels\n\n"
+               "Usage:\n"
+               "  --filter=LIST                   Only runs kernels containing one of the comma separated names\n"
+               "  --particles=LIST                Comma separated particle counts (default 1000,10000)\n"
+               "  --density=LIST                  Comma separated particles per unit volume (default 0.8)\n"
+               "  --threads=LIST                  Comma separated thread counts (default 1 and the maximum)\n"
+               "  --samples=UINT                  Samples per measurement (default 10)\n"
+               "  --min-time=DOUBLE               Minimal duration of a sample in seconds (default 0.01)\n"
+               "  --output=FILE                   Writes the results as JSON to the specified file\n"
+               "  --list                          Lists the kernels and terminates the program\n"
+               "  -h, --help                      Show this help text and terminates the program.\n\n"
+               "Example:\n"
+               "  MolSimBench --filter=pairs,move --particles=10000 --threads=1,2,4 --output=bench.json"
+            << "\n";
+}
+
+template <typename T>
+std::vector<T> parseList(const std::string &list) {
+  std::vector<T> result;
+  std::stringstream stream(list);
+  std::string item;
+  while (std::getline(stream, item, ',')) {
+    if (item.empty()) continue;
+    if constexpr (std::is_same_v<T, std::string>) {
+      result.push_back(item);
+    } else {
+      result.push_back(static_cast<T>(std::stod(item)));
+    }
+  }
+  return result;
+}
+
+/**
+ * @return Name of the CPU from /proc/cpuinfo, empty if not available
+ */
+std::string cpuName() {
+  std::ifstream cpuinfo("/proc/cpuinfo");
+  std::string line;
+  while (std::getline(cpuinfo, line)) {
+    if (line.rfind("model name", 0) != 0) continue;
+    const auto colon = line.find(':');
+    if (colon != std::string::npos) return line.substr(line.find_first_not_of(' ', colon + 1));
+  }
+  return "";
+}
+
+std::string hostName() {
+  char name[256] = {};
+  gethostname(name, sizeof(name) - 1);
+  return name;
+}
+
+/**
+ * @brief Escapes quotes and backslashes for a JSON string
+ */
+std::string escape(const std::string &text) {
+  std::string result;
+  for (const char c : text) {
+    if (c == '"' || c == '\\') result += '\\';
+    result += c;
+  }
+  return result;
+}
+
+void writeJSON(const std::string &filename, const std::vector<BenchResult> &results) {
+  std::ofstream file(filename);
+  if (!file.is_open()) {
+    SPDLOG_ERROR("Error opening {}", filename);
+    exit(EXIT_FAILURE);
+  }
+
+  file << "{\n"
+       << fmt::format("  \"commit\": \"{}\",\n", MOLSIM_GIT_COMMIT)
+       << fmt::format("  \"build_type\": \"{}\",\n", MOLSIM_BUILD_TYPE)
+       << fmt::format("  \"compiler\": \"{}\",\n", escape(__VERSION__))
+       << fmt::format("  \"host\": \"{}\",\n", escape(hostName()))
+       << fmt::format("  \"cpu\": \"{}\",\n", escape(cpuName()))
+       << fmt::format("  \"max_threads\": {},\n", omp_get_max_threads()) << "  \"results\": [\n";
+  for (size_t i = 0; i < results.size(); i++) {
+    const auto &r = results[i];
+    file << fmt::format(
+        "    {{\"kernel\": \"{}\", \"unit\": \"{}\", \"particles\": {}, \"density\": {}, \"threads\": {}, "
+        "\"batch\": {}, \"seconds\": {{\"median\": {}, \"mean\": {}, \"stddev\": {}, \"min\": {}, \"max\": {}}}, "
+        "\"items_per_second\": {}}}{}\n",
+        r.kernel, r.unit, r.parameters.particles, r.parameters.density, r.parameters.threads, r.batch,
+        r.seconds.median, r.seconds.mean, r.seconds.stddev, r.seconds.min, r.seconds.max, r.items_per_second,
+        i + 1 < results.size() ? "," : "");
+  }
+  file << "  ]\n}\n";
+}
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  std::vector<std::string> filters;
+  std::vector<size_t> particle_counts = {1000, 10000};
+  std::vector<double> densities = {0.8};
+  std::vector<int> thread_counts = {1};
+  if (omp_get_max_threads() > 1) thread_counts.push_back(omp_get_max_threads());
+  unsigned int samples = 10;
+  double min_time = 0.01;
+  std::string output;
+  bool list = false;
+
+  enum Option { FILTER = 256, PARTICLES, DENSITY, THREADS, SAMPLES, MIN_TIME, OUTPUT, LIST };
+  const option long_opts[] = {{"filter", required_argument, nullptr, FILTER},
+                              {"particles", required_argument, nullptr, PARTICLES},
+                              {"density", required_argument, nullptr, DENSITY},
+                              {"threads", required_argument, nullptr, THREADS},
+                              {"samples", required_argument, nullptr, SAMPLES},
+                              {"min-time", required_argument, nullptr, MIN_TIME},
+                              {"output", required_argument, nullptr, OUTPUT},
+                              {"list", no_argument, nullptr, LIST},
+                              {"help", no_argument, nullptr, 'h'},
+                              {nullptr, no_argument, nullptr, 0}};
+
+  try {
+    for (int opt; (opt = getopt_long(argc, argv, "h", long_opts, nullptr)) != -1;) {
+      switch (opt) {
+        case FILTER:
+          filters = parseList<std::string>(optarg);
+          break;
+        case PARTICLES:
+          particle_counts = parseList<size_t>(optarg);
+          break;
+        case DENSITY:
+          densities = parseList<double>(optarg);
+          break;
+        case THREADS:
+          thread_counts = parseList<int>(optarg);
+          break;
+        case SAMPLES:
+          samples = std::stoul(optarg);
+          break;
+        case MIN_TIME:
+          min_time = std::stod(optarg);
+          break;
+        case OUTPUT:
+          output = optarg;
+          break;
+        case LIST:
+          list = true;
+          break;
+        case 'h':
+          printHelp();
+          return EXIT_SUCCESS;
+        default:
+          SPDLOG_ERROR("An error occurred while passing the arguments.");
+          return EXIT_FAILURE;
+      }
+    }
+  } catch (const std::invalid_argument &e) {
+    SPDLOG_ERROR("Could not parse arguments! Is the Type of the Arguments correct?");
+    return EXIT_FAILURE;
+  }
+
+  std::vector<Kernel> kernels;
+  for (auto &kernel : allKernels()) {
+    bool selected = filters.empty();
+    for (const auto &filter : filters) selected |= kernel.name.find(filter) != std::string::npos;
+    if (selected) kernels.push_back(std::move(kernel));
+  }
+  if (list) {
+    for (const auto &kernel : kernels) std::cout << kernel.name << "\n";
+    return EXIT_SUCCESS;
+  }
+
+  // the simulation code logs at info level, which would distort the measurements
+  spdlog::set_level(spdlog::level::warn);
+  std::vector<BenchResult> results;
+  std::cout << fmt::format("{:<18}{:>10}{:>9}{:>9}{:>14}{:>12}{:>16}\n", "kernel", "particles", "density", "threads",
+                           "median [us]", "stddev", "items/s");
+  for (const auto &kernel : kernels) {
+    for (const size_t particles : particle_counts) {
+      for (const double density : densities) {
+        for (const int threads : thread_counts) {
+          const auto result = measure(kernel, {particles, density, threads}, samples, min_time);
+          std::cout << fmt::format("{:<18}{:>10}{:>9.3f}{:>9}{:>14.2f}{:>11.1f}%{:>16.4g}\n", result.kernel,
+                                   particles, density, threads, result.seconds.median * 1e6,
+                                   result.seconds.median > 0 ? result.seconds.stddev / result.seconds.median * 100 : 0,
+                                   result.items_per_second)
+                    << std::flush;
+          results.push_back(result);
+        }
+      }
+    }
+  }
+
+  if (!output.empty()) writeJSON(output, results);
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,32 @@
+# Micro-benchmarks of the simulation kernels, see bench/MolSimBench.cpp
+option(ENABLE_BENCHMARK_TARGET "Enable the MolSimBench target" ON)
+if (ENABLE_BENCHMARK_TARGET)
+    file(GLOB_RECURSE MY_BENCH
+            "${CMAKE_CURRENT_SOURCE_DIR}/bench/*.cpp"
+    )
+
+    add_executable(MolSimBench ${MY_BENCH})
+    target_link_libraries(MolSimBench MolSimLib)
+
+    # results are compared across commits, so the commit is part of them. It is only updated when cmake runs
+    find_package(Git QUIET)
+    if (GIT_FOUND)
+        execute_process(
+                COMMAND ${GIT_EXECUTABLE} rev-parse --short HEAD
+                WORKING_DIRECTORY ${CMAKE_CURRENT_SOURCE_DIR}
+                OUTPUT_VARIABLE MOLSIM_GIT_COMMIT
+                OUTPUT_STRIP_TRAILING_WHITESPACE
+                ERROR_QUIET
+        )
+    endif ()
+    if (MOLSIM_GIT_COMMIT)
+        target_compile_definitions(MolSimBench PRIVATE MOLSIM_GIT_COMMIT="${MOLSIM_GIT_COMMIT}")
+    endif ()
+    target_compile_definitions(MolSimBench PRIVATE MOLSIM_BUILD_TYPE="${CMAKE_BUILD_TYPE}")
+
+    # a quick run of all kernels as part of the tests, so the benchmarks keep working
+    if (ENABLE_TEST_TARGET)
+        add_test(NAME MolSimBench.Smoke
+                COMMAND MolSimBench --particles=200 --threads=1 --samples=1 --min-time=0)
+    endif ()
+endif ()
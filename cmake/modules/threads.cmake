@@ -0,0 +1,4 @@
+# std::thread is used by the asynchronous output writer
+find_package(Threads REQUIRED)
+
+target_link_libraries(MolSimLib Threads::Threads)
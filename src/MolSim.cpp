@@ -9,25 +9,22 @@
 #include <memory>
 
 #include "Settings.h"
-#include "container/directSum/ParticleContainer.h"
-#include "container/linkedCells/LinkedCells.h"
+#include "benchmark/Benchmark.h"
+#include "benchmark/Scaling.h"
+#include "outputWriter/AsyncWriter.h"
+#include "outputWriter/CellCostWriter.h"
+#include "outputWriter/CheckpointWriter.h"
+#include "outputWriter/TrajectoryWriter.h"
 #include "outputWriter/VTKWriter.h"
 #include "outputWriter/XYZWriter.h"
 #include "outputWriter/YAMLWriter.h"
-#include "simulations/CollisionSimulation.h"
-#include "simulations/CutoffSimulation.h"
-#include "simulations/MembraneSimulation.h"
-#include "simulations/PlanetSimulation.h"
-#include "simulations/ThermostatSimulation.h"
+#include "simulations/SimulationFactory.h"
 #include "simulations/nanoScale/NanoScaleSimulation.h"
-#include "simulations/nanoScale/NanoScaleThermostat.h"
-
-/**
- * @brief plot the particles to a xyz-file or to a vtk-file.
- *
- * If ENABLE_VTK_OUTPUT is set, this function creates a vtk-file. Otherwise it creates a xyz-file
- */
-void plotParticles(std::vector<Particle> &particles, int iteration, const std::filesystem::path &filename);
+#include "utils/MemoryUsage.h"
+#include "utils/PerfCounters.h"
+#include "utils/PhaseTimers.h"
+#include "utils/Signals.h"
+#include "utils/Tracing.h"
 
 int main(int argc, char *argsv[]) {
   initializeLogging();
@@ -37,7 +34,9 @@ int main(int argc, char *argsv[]) {
   settings.parseArguments(argc, argsv);
   spdlog::set_level(settings.output.log_level);
 
-  if (input_particles.empty()) {
+  // a scaling study can generate its own particles
+  const bool generated = settings.scaling.has_value() && settings.scaling->particles.has_value();
+  if (input_particles.empty() && !generated) {
     SPDLOG_WARN("No particles to simulate");
     exit(EXIT_SUCCESS);
   }
@@ -56,147 +55,183 @@ int main(int argc, char *argsv[]) {
     exit(EXIT_SUCCESS);
   }
 
-#ifndef ENABLE_TIME_MEASURE
-  if (settings.output.directory.has_value()) {
+  if (settings.timer_interval.has_value()) PhaseTimers::enable();
+  if (settings.perf_counters.has_value()) PerfCounters::enable(settings.perf_counters.value());
+  if (settings.trace.has_value()) Tracing::enable(settings.trace->file, settings.trace->first, settings.trace->last);
+  if (settings.scaling.has_value() || settings.benchmark.has_value()) {
+    const int result = settings.scaling.has_value() ? Scaling::run(input_particles, settings)
+                                                    : Benchmark::run(input_particles, settings);
+    // the trace covers the first run, it is written here if that run ended inside the step window
+    Tracing::finish();
+    return result;
+  }
+
+  if (settings.output.directory.has_value() && !settings.dry_run) {
     Settings::createOutputDirectory(settings.output.directory.value());
   }
-#endif
+  Signals::installHandlers();
 
-  // select simulation
-  std::unique_ptr<Simulation> simulation = nullptr;
-  std::unique_ptr<Thermostat> thermostat = nullptr;
-  std::unique_ptr<LinkedCells> linkedCells = nullptr;
+  // periodic and emergency checkpoints go to the checkpoint file or next to the output files
+  std::optional<std::filesystem::path> checkpoint_path = settings.output.checkpoint_filename;
+  if (!checkpoint_path && settings.output.directory) {
+    checkpoint_path = settings.output.directory.value() / (settings.output.prefix + ".checkpoint");
+  }
 
-#ifdef ENABLE_TIME_MEASURE
-  std::chrono::milliseconds total_runtime(0);
-  std::vector<Particle> original = input_particles;  // keep a copy of the starting particles
+  SimulationSetup setup = SimulationFactory::create(input_particles, settings);
+  auto &simulation = setup.simulation;
+
+  // snapshot buffers of the output, only set while the simulation runs
+  const outputWriter::AsyncWriter *output_buffers = nullptr;
+  const auto measure_memory = [&]() {
+    Memory::Usage usage;
+    usage[Memory::PARTICLES] = input_particles.capacity() * sizeof(Particle);
+    usage[Memory::BONDS] = settings.membrane.bonds.bonds.capacity() * sizeof(Bond);
+    for (const auto &group : settings.force_groups) usage[Memory::BONDS] += group.indices.capacity() * sizeof(size_t);
+    if (setup.linked_cells) setup.linked_cells->addMemoryUsage(usage);
+    if (output_buffers) usage[Memory::OUTPUT] = output_buffers->memoryUsage();
+    Memory::record(usage);
+  };
+
+  if (settings.dry_run) {
+    measure_memory();
+    // every snapshot buffer grows to the size of the particle vector once it was used
+    Memory::Usage usage = Memory::current();
+    if (settings.output.directory.has_value() && settings.output.frequency > 0) {
+      usage[Memory::OUTPUT] =
+          settings.output.buffers * input_particles.size() * outputWriter::ParticleSnapshot::BYTES_PER_PARTICLE;
+    }
+    Memory::record(usage);
+    SPDLOG_INFO("Estimated memory of {} particles at the start of the simulation, growing ghost buffers excluded:\n{}",
+                input_particles.size(), Memory::format());
+    return 0;
+  }
 
-  for (int i = 0; i < ENABLE_TIME_MEASURE; i++) {
-    SPDLOG_INFO("Benchmark iteration {}/{}", i + 1, ENABLE_TIME_MEASURE);
-#endif
+  if (settings.pair_statistics) {
+    if (setup.linked_cells) {
+      setup.linked_cells->collectPairStatistics();
+    } else {
+      SPDLOG_WARN("Pair statistics are only collected for linked cells simulations");
+    }
+  }
 
-    switch (settings.simulation.worksheet.value()) {
-      case 1:
-        simulation = std::make_unique<PlanetSimulation>(input_particles, settings.simulation.start_time,
-                                                        settings.simulation.end_time.value(),
-                                                        settings.simulation.delta_t.value());
-        break;
-
-      case 2:
-        simulation = std::make_unique<CollisionSimulation>(
-            input_particles, settings.simulation.start_time, settings.simulation.end_time.value(),
-            settings.simulation.delta_t.value(), settings.simulation.brown_motion_avg_velocity);
-        break;
-
-      case 3:
-        if (settings.useAlternateParallelisation) {
-          linkedCells = std::make_unique<LinkedCellsV2>(input_particles, settings.simulation.domain.value(),
-                                                        settings.simulation.cutoff_radius.value(),
-                                                        settings.simulation.is2D, settings.simulation.borders.value());
-        } else {
-          linkedCells = std::make_unique<LinkedCells>(input_particles, settings.simulation.domain.value(),
-                                                      settings.simulation.cutoff_radius.value(),
-                                                      settings.simulation.is2D, settings.simulation.borders.value());
-        }
+  const auto report_memory = [&](const unsigned int iteration) {
+    if (!settings.memory_interval) return;
+    measure_memory();
+    if (settings.memory_interval.value() == 0 || iteration == 0) return;
+    if (iteration % settings.memory_interval.value() != 0) return;
+    SPDLOG_INFO("Memory after iteration {}:\n{}", iteration, Memory::format());
+  };
+  if (settings.memory_interval.has_value()) {
+    measure_memory();
+    SPDLOG_INFO("Memory at the start of the simulation:\n{}", Memory::format());
+  }
+
+  // Source for duration measurement- https://stackoverflow.com/a/19312610
+  auto start_time_iteration = std::chrono::high_resolution_clock::now();
+
+  // intermediate reports of the phase timers only cover the iterations since the previous report
+  PhaseTimers::Totals last_report;
+  const auto report_timers = [&](const unsigned int iteration) {
+    if (!settings.timer_interval || settings.timer_interval.value() == 0 || iteration == 0) return;
+    if (iteration % settings.timer_interval.value() != 0) return;
+    const auto totals = PhaseTimers::snapshot();
+    SPDLOG_INFO("Phase timers of the last {} iterations:\n{}{}", settings.timer_interval.value(),
+                PhaseTimers::format(totals - last_report), PhaseTimers::formatCounters(totals - last_report));
+    last_report = totals;
+  };
+
+  auto last_checkpoint = std::chrono::steady_clock::now();
+  // called after every iteration. Writes the periodic checkpoints and stops the simulation when the job is terminated
+  const auto checkpoint = [&]() {
+    const int signal = Signals::received();
+    if (signal == 0 && !settings.output.checkpoint_interval) return;
+
+    const auto now = std::chrono::steady_clock::now();
+    const bool due = settings.output.checkpoint_interval &&
+                     std::chrono::duration<double>(now - last_checkpoint).count() >=
+                         settings.output.checkpoint_interval.value();
+    if (signal == 0 && !due) return;
+
+    if (signal != 0) {
+      SPDLOG_WARN("Received signal {}, stopping after iteration {}", signal, simulation->getCurrentIteration());
+      simulation->stop();
+    }
+    if (!checkpoint_path) {
+      SPDLOG_WARN("No checkpoint_filename or output folder set, can't write a checkpoint");
+      return;
+    }
+    outputWriter::writeCheckpoint(input_particles, settings, checkpoint_path.value(), simulation->getCurrentIteration(),
+                                  simulation->getCurrentTime(), simulation->getDeltaT(), setup.cellOrder());
+    last_checkpoint = now;
+  };
 
-        simulation = std::make_unique<CutoffSimulation>(
-            *linkedCells, settings.simulation.start_time, settings.simulation.end_time.value(),
-            settings.simulation.delta_t.value(), settings.simulation.brown_motion_avg_velocity,
-            settings.simulation.domain.value(), settings.simulation.cutoff_radius.value(),
-            settings.simulation.borders.value(), settings.simulation.is2D, settings.simulation.gravity.value_or(0.0));
-        break;
-
-      case 4: {
-        if (settings.useAlternateParallelisation) {
-          linkedCells = std::make_unique<LinkedCellsV2>(input_particles, settings.simulation.domain.value(),
-                                                        settings.simulation.cutoff_radius.value(),
-                                                        settings.simulation.is2D, settings.simulation.borders.value());
-        } else {
-          linkedCells = std::make_unique<LinkedCells>(input_particles, settings.simulation.domain.value(),
-                                                      settings.simulation.cutoff_radius.value(),
-                                                      settings.simulation.is2D, settings.simulation.borders.value());
-        }
-        thermostat = std::make_unique<Thermostat>(
-            input_particles, settings.simulation.is2D, settings.simulation.t_frequency.value(),
-            settings.simulation.t_final.value_or(settings.simulation.t_initial.value()),
-            settings.simulation.t_max_change.value_or(std::numeric_limits<double>::infinity()));
-        simulation = std::make_unique<ThermostatSimulation>(
-            *linkedCells, settings.simulation.start_time, settings.simulation.end_time.value(),
-            settings.simulation.delta_t.value(), settings.simulation.brown_motion_avg_velocity,
-            settings.simulation.domain.value(), settings.simulation.cutoff_radius.value(),
-            settings.simulation.borders.value(), settings.simulation.is2D, settings.simulation.gravity.value_or(0.0),
-            settings.simulation.t_initial, *thermostat);
-      } break;
-      case 5: {
-        if (settings.useAlternateParallelisation) {
-          linkedCells = std::make_unique<LinkedCellsV2>(input_particles, settings.simulation.domain.value(),
-                                                        settings.simulation.cutoff_radius.value(),
-                                                        settings.simulation.is2D, settings.simulation.borders.value());
-        } else {
-          linkedCells = std::make_unique<LinkedCells>(input_particles, settings.simulation.domain.value(),
-                                                      settings.simulation.cutoff_radius.value(),
-                                                      settings.simulation.is2D, settings.simulation.borders.value());
-        }
-        thermostat = std::make_unique<Thermostat>(
-            input_particles, settings.simulation.is2D,
-            settings.simulation.t_frequency.value_or(std::numeric_limits<int>::max()),
-            settings.simulation.t_final.value_or(settings.simulation.t_initial.value_or(0.0)),
-            settings.simulation.t_max_change.value_or(std::numeric_limits<double>::infinity()));
-        simulation = std::make_unique<MembraneSimulation>(
-            *linkedCells, settings.simulation.start_time, settings.simulation.end_time.value(),
-            settings.simulation.delta_t.value(), settings.simulation.brown_motion_avg_velocity,
-            settings.simulation.domain.value(), pow(2, (1.0 / 6.0)) * settings.membrane.sigma.value_or(1.0),
-            settings.simulation.borders.value(), settings.simulation.is2D, settings.simulation.gravity.value_or(0.0),
-            settings.simulation.t_initial, *thermostat, settings.membrane.r0.value(), settings.membrane.k.value(),
-            settings.membrane.f_zUp.value(), settings.membrane.upwardsParticles);
-
-      } break;
-      case 6: {
-        if (settings.useAlternateParallelisation) {
-          linkedCells = std::make_unique<LinkedCellsV2>(input_particles, settings.simulation.domain.value(),
-                                                        settings.simulation.cutoff_radius.value(),
-                                                        settings.simulation.is2D, settings.simulation.borders.value());
-        } else {
-          linkedCells = std::make_unique<LinkedCells>(input_particles, settings.simulation.domain.value(),
-                                                      settings.simulation.cutoff_radius.value(),
-                                                      settings.simulation.is2D, settings.simulation.borders.value());
-        }
-        thermostat = std::make_unique<NanoScaleThermostat>(
-            input_particles, settings.simulation.is2D,
-            settings.simulation.t_frequency.value_or(std::numeric_limits<int>::max()),
-            settings.simulation.t_final.value_or(settings.simulation.t_initial.value_or(0.0)),
-            settings.simulation.t_max_change.value_or(std::numeric_limits<double>::infinity()));
-        simulation = std::make_unique<NanoScaleSimulation>(
-            *linkedCells, settings.simulation.start_time, settings.simulation.end_time.value(),
-            settings.simulation.delta_t.value(), settings.simulation.brown_motion_avg_velocity,
-            settings.simulation.domain.value(), pow(2, (1.0 / 6.0)) * settings.membrane.sigma.value_or(1.0),
-            settings.simulation.borders.value(), settings.simulation.is2D, settings.simulation.gravity.value_or(0.0),
-            settings.simulation.t_initial, *thermostat);
-      } break;
-
-      default:
-        SPDLOG_ERROR("Invalid worksheet number {}", settings.simulation.worksheet.value());
-        exit(EXIT_FAILURE);
-    };
-
-    // Source for duration measurement- https://stackoverflow.com/a/19312610
-    auto start_time_iteration = std::chrono::high_resolution_clock::now();
-
-#ifdef ENABLE_TIME_MEASURE
-    // Disable logging
-    spdlog::set_level(spdlog::level::off);
-
-    simulation->run([](const unsigned int _) {});
-
-    // Enable logging
-    spdlog::set_level(settings.output.log_level);
-#else
   if (settings.output.directory.has_value()) {
     SPDLOG_INFO("Writing files to {}", settings.output.directory.value().string());
-    simulation->run([&simulation, &input_particles, &settings](const unsigned int iteration) {
-      if (iteration % settings.output.frequency == 0) {
+    // With an adaptive timestep, output is scheduled by simulation time instead of by iteration
+    const double output_interval = settings.output.frequency * settings.simulation.delta_t.value();
+    double next_output_time = settings.simulation.start_time;
+
+    // If ENABLE_VTK_OUTPUT is set, vtk-files are created. Otherwise xyz-files are created
+#ifdef ENABLE_VTK_OUTPUT
+    outputWriter::VTKWriter writer(settings.output.vtk_mode, settings.output.vtk_compression);
+#else
+    outputWriter::XYZWriter writer;
+#endif
+    // the cell costs of an output cover the iterations since the previous one
+    auto cell_costs_first = static_cast<unsigned int>(settings.restart ? settings.restart->iteration : 0);
+    if (settings.output.cell_costs.has_value()) {
+      if (setup.linked_cells) {
+        setup.linked_cells->measureCellCosts();
+      } else {
+        SPDLOG_WARN("Cell costs are only measured for linked cells simulations");
+      }
+    }
+
+    std::unique_ptr<outputWriter::TrajectoryWriter> trajectory_writer;
+    if (settings.output.trajectory.has_value()) {
+      const auto filename = settings.output.directory.value() / (settings.output.prefix + ".trj");
+      trajectory_writer = std::make_unique<outputWriter::TrajectoryWriter>(filename, settings.output.trajectory.value());
+    }
+
+    // files are formatted and written on a background thread while the simulation continues
+    outputWriter::AsyncWriter async_writer(
+        [&writer, &trajectory_writer](outputWriter::AsyncWriter::Frame &frame) {
+          if (trajectory_writer) {
+            trajectory_writer->writeFrame(frame.particles, frame.iteration, frame.time);
+            return;
+          }
+#ifdef ENABLE_VTK_OUTPUT
+          writer.plotParticles(frame.particles, frame.filename, frame.iteration, frame.time);
+#else
+          writer.plotParticles(frame.particles, frame.filename, frame.iteration);
+#endif
+        },
+        settings.output.buffers);
+
+    output_buffers = &async_writer;
+    simulation->run([&](const unsigned int iteration) {
+      checkpoint();
+      report_timers(iteration);
+      report_memory(iteration);
+
+      bool plot = iteration % settings.output.frequency == 0;
+      if (settings.simulation.adaptive_timestep.has_value()) {
+        plot = output_interval > 0 && simulation->getCurrentTime() >= next_output_time;
+        // skip output times that were stepped over by a large timestep
+        while (plot && next_output_time <= simulation->getCurrentTime()) next_output_time += output_interval;
+      }
+
+      if (plot) {
+        PhaseTimers::ScopedTimer timer(PhaseTimers::OUTPUT);
         const auto filename = settings.output.directory.value() / settings.output.prefix;
-        plotParticles(input_particles, static_cast<int>(iteration), filename);
+        async_writer.submit(input_particles, filename.string(), static_cast<int>(iteration),
+                            simulation->getCurrentTime());
+        if (settings.output.cell_costs.has_value() && setup.linked_cells) {
+          outputWriter::writeCellCosts(*setup.linked_cells, filename.string(), static_cast<int>(iteration),
+                                       iteration + 1 - cell_costs_first, settings.output.cell_costs.value());
+          setup.linked_cells->resetCellCosts();
+          cell_costs_first = iteration + 1;
+        }
       }
 
       if (auto s = dynamic_cast<NanoScaleSimulation *>(simulation.get())) {
@@ -208,50 +243,43 @@ int main(int argc, char *argsv[]) {
         s->calculateStatistics(filename);
       }
     });
+    output_buffers = nullptr;
   } else {
     SPDLOG_WARN("No output folder set, running simulation without plotting");
-    simulation->run([](const unsigned int _) {});
+    simulation->run([&](const unsigned int iteration) {
+      checkpoint();
+      report_timers(iteration);
+      report_memory(iteration);
+    });
   }
-#endif
-
-    auto end_time_iteration = std::chrono::high_resolution_clock::now();
-    SPDLOG_INFO(
-        "Program has been running for {} ms",
-        std::chrono::duration_cast<std::chrono::milliseconds>(end_time_iteration - start_time_iteration).count());
 
-#ifdef ENABLE_TIME_MEASURE
-    // copy original particles to start simulation from scratch
-    input_particles.clear();
-    for (const auto &p : original) {
-      input_particles.push_back(p);
-    }
+  Tracing::finish();
 
-    // Rebuild the linkedCells container
-    linkedCells->moveParticles();
-
-    // add to total runtime
-    total_runtime += std::chrono::duration_cast<std::chrono::milliseconds>(end_time_iteration - start_time_iteration);
+  auto end_time_iteration = std::chrono::high_resolution_clock::now();
+  SPDLOG_INFO("Program has been running for {} ms",
+              std::chrono::duration_cast<std::chrono::milliseconds>(end_time_iteration - start_time_iteration).count());
+  if (settings.timer_interval.has_value()) {
+    const auto totals = PhaseTimers::snapshot();
+    SPDLOG_INFO("Phase timers of all iterations:\n{}{}", PhaseTimers::format(totals),
+                PhaseTimers::formatCounters(totals));
+  }
+  if (settings.memory_interval.has_value()) {
+    SPDLOG_INFO("Memory at the end of the simulation:\n{}", Memory::format());
+  }
+  if (settings.pair_statistics && setup.linked_cells) {
+    SPDLOG_INFO("Pair statistics of all iterations:\n{}", setup.linked_cells->pairStatistics().format());
   }
-
-  // molecule updates per second = particles times iterations per second
-  std::chrono::milliseconds average_runtime = total_runtime / ENABLE_TIME_MEASURE;
-  double iterations = settings.simulation.end_time.value() / settings.simulation.delta_t.value();
-  double mups = input_particles.size() * iterations / average_runtime.count();
-  SPDLOG_INFO("Benchmark finished: total={}ms, average={}ms, mups={:.0f}mol/s", total_runtime.count(),
-              average_runtime.count(), mups);
-
-#endif
 
   if (settings.output.export_filename.has_value())
     outputWriter::exportYAML(input_particles, settings, settings.output.export_filename.value());
-  return 0;
-}
 
-void plotParticles(std::vector<Particle> &particles, int iteration, const std::filesystem::path &filename) {
-#ifdef ENABLE_VTK_OUTPUT
-  outputWriter::VTKWriter writer;
-#else
-  outputWriter::XYZWriter writer;
-#endif
-  writer.plotParticles(particles, filename.string(), iteration);
+  // the checkpoint was already written when the signal arrived. Exit like a terminated process, so job scripts can
+  // tell an interrupted run from a finished one
+  if (const int signal = Signals::received(); signal != 0) return 128 + signal;
+  if (settings.output.checkpoint_filename.has_value()) {
+    outputWriter::writeCheckpoint(input_particles, settings, settings.output.checkpoint_filename.value(),
+                                  simulation->getCurrentIteration(), simulation->getCurrentTime(),
+                                  simulation->getDeltaT(), setup.cellOrder());
+  }
+  return 0;
 }
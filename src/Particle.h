@@ -62,6 +62,7 @@ class Particle {
    * State of the particle.
    * -1 := dead
    * 0 := alive
+   * 1 := static (never moved, no interactions with other static particles)
    */
   int state;
 
@@ -73,10 +74,6 @@ class Particle {
    * σ-Value for Lorentz-Berthelot mixing rule
    */
   double sigma;
-  /**
-   * Neighbors of a Particle in a membrane
-   */
-  std::array<Particle *, 8> neighbors;
 
  public:
   /**
@@ -188,6 +185,12 @@ class Particle {
    */
   [[nodiscard]] int getState() const { return state; }
 
+  /**
+   * @brief Checks if the particle is static
+   * @return true if the particle is never moved by the simulation
+   */
+  [[nodiscard]] bool isStatic() const { return state == 1; }
+
   /**
    *@return Epsilon of this particle
    */
@@ -198,18 +201,6 @@ class Particle {
    */
   [[nodiscard]] double getSigma() const { return sigma; }
 
-  /**
-   *
-   * @return a Reference of the Neighbors array
-   */
-  [[nodiscard]] std::array<Particle *, 8> &getNeighbors() { return neighbors; }
-  /**
-   *
-   * @param index index of the neighbor you wanna get
-   * @return Pointer to the Neighbor
-   */
-  [[nodiscard]] Particle *getNeighbor(int index) const { return neighbors[index]; }
-
   /**
    * @brief Sets new effective Force and updates Old Force to the current Force
    * @param new_f new Force - 3D-"Vector" (std::array<double, 3>)
@@ -284,19 +275,6 @@ class Particle {
    */
   void setState(int new_state) { state = new_state; }
 
-  /**
-   * @brief replaces the whole neighbor Array with a new one -> meight be useless
-   * @param new_neighbors Array with the new Neighbors
-   */
-  void setNeighbors(std::array<Particle *, 8> new_neighbors) { neighbors = new_neighbors; }
-
-  /**
-   * @brief replaces the neighbor at a given index, with a new one
-   * @param new_neighbour new neighbor
-   * @param index index (0 - 7) of the neighbor which should be replaced
-   */
-  void setNeighbour(Particle *new_neighbour, int index) { neighbors[index] = new_neighbour; }
-
   /**
    * @brief Comparte two particles
    *
@@ -6,8 +6,10 @@
 #include <yaml-cpp/yaml.h>
 
 #include <algorithm>
+#include <sstream>
 #include <unordered_map>
 
+#include "inputReader/CheckpointReader.h"
 #include "inputReader/CuboidReader.h"
 #include "inputReader/FileReader.h"
 #include "inputReader/XYZReader.h"
@@ -25,26 +27,82 @@ void Settings::printHelp() {
                "  -s, --single=FILE               Reads particles from the specified file in xyz format\n"
                "  -c, --cuboid=FILE               Reads particles from the specified file in cuboid format\n"
                "  -y, --yaml=FILE                 Reads particles and settings from the specified file in yaml format\n"
+               "  -r, --restart=FILE              Restores particles and settings from a binary checkpoint\n"
                "  -l, --loglevel=STRING           Set the log level (trace, debug, info, warn, error)\n"
+               "      --timers[=UINT]             Measures the phases of the iterations, reports every UINT of them\n"
+               "      --perf-counters[=RAW]       Counts hardware events per phase, RAW adds a raw event (hex)\n"
+               "      --memory[=UINT]             Reports the memory of the subsystems, every UINT iterations\n"
+               "      --dry-run                   Estimates a lower bound of the memory without running it\n"
+               "      --pair-statistics           Counts the distance tests and interactions of the linked cells\n"
+               "      --trace=FILE                Writes a Chrome trace of the phases and loop chunks of every thread\n"
+               "      --trace-steps=FIRST:LAST    Iterations that are traced (default 0:9)\n"
+               "      --benchmark[=UINT]          Benchmarks the simulation with the given number of repetitions\n"
+               "      --warmup=UINT               Iterations per repetition that are not measured (default 10)\n"
+               "      --benchmark-output=FILE     Writes the benchmark results as JSON to the specified file\n"
+               "      --cell-costs[=FORMAT]       Writes the cost of every linked cell with the output (vti, csv)\n"
+               "      --scaling=MODE              Runs a strong or weak scaling study over a sweep of thread counts\n"
+               "      --scaling-threads=LIST      Comma separated thread counts of the sweep (default 1, 2, 4, ...)\n"
+               "      --scaling-particles=UINT    Generates this many particles instead of using the input particles\n"
+               "      --scaling-density=DOUBLE    Number density of the generated particles (default 0.8)\n"
+               "      --scaling-shape=STRING      Shape of the generated particles (cuboid, disc)\n"
                "  -h, --help                      Show this help text and terminates the program.\n\n"
                "Example:\n"
                "  MolSim -e 100.0 -c ../input/eingabe-cuboid.txt"
             << "\n";
 }
 
+namespace {
+/** @brief Values of the options without a short form, outside the range of characters */
+enum LongOption {
+  TIMERS = 256,
+  PERF_COUNTERS,
+  MEMORY,
+  DRY_RUN,
+  PAIR_STATISTICS,
+  TRACE,
+  TRACE_STEPS,
+  BENCHMARK,
+  WARMUP,
+  BENCHMARK_OUTPUT,
+  CELL_COSTS,
+  SCALING,
+  SCALING_THREADS,
+  SCALING_PARTICLES,
+  SCALING_DENSITY,
+  SCALING_SHAPE
+};
+}  // namespace
+
 void Settings::parseArguments(int argc, char *argv[]) {
-  const char *const short_opts = "e:d:w:s:c:y:b:ho:f:l:";
+  const char *const short_opts = "e:d:w:s:c:y:r:b:ho:f:l:";
   const option long_opts[] = {{"end-time", required_argument, nullptr, 'e'},
                               {"delta-t", required_argument, nullptr, 'd'},
                               {"worksheet", required_argument, nullptr, 'w'},
                               {"single", required_argument, nullptr, 's'},
                               {"cuboid", required_argument, nullptr, 'c'},
                               {"yaml", required_argument, nullptr, 'y'},
+                              {"restart", required_argument, nullptr, 'r'},
                               {"brown-motion-avg", required_argument, nullptr, 'b'},
                               {"help", no_argument, nullptr, 'h'},
                               {"out", required_argument, nullptr, 'o'},
                               {"frequency", required_argument, nullptr, 'f'},
                               {"loglevel", required_argument, nullptr, 'l'},
+                              {"timers", optional_argument, nullptr, TIMERS},
+                              {"perf-counters", optional_argument, nullptr, PERF_COUNTERS},
+                              {"memory", optional_argument, nullptr, MEMORY},
+                              {"dry-run", no_argument, nullptr, DRY_RUN},
+                              {"pair-statistics", no_argument, nullptr, PAIR_STATISTICS},
+                              {"trace", required_argument, nullptr, TRACE},
+                              {"trace-steps", required_argument, nullptr, TRACE_STEPS},
+                              {"benchmark", optional_argument, nullptr, BENCHMARK},
+                              {"warmup", required_argument, nullptr, WARMUP},
+                              {"benchmark-output", required_argument, nullptr, BENCHMARK_OUTPUT},
+                              {"cell-costs", optional_argument, nullptr, CELL_COSTS},
+                              {"scaling", required_argument, nullptr, SCALING},
+                              {"scaling-threads", required_argument, nullptr, SCALING_THREADS},
+                              {"scaling-particles", required_argument, nullptr, SCALING_PARTICLES},
+                              {"scaling-density", required_argument, nullptr, SCALING_DENSITY},
+                              {"scaling-shape", required_argument, nullptr, SCALING_SHAPE},
                               {nullptr, no_argument, nullptr, 0}};
 
   while (true) {
@@ -78,13 +136,23 @@ void Settings::parseArguments(int argc, char *argv[]) {
         case 'y':
           try {
             YAMLReader::readFile(particles, optarg, *this);
-          } catch (YAML::Exception e) {
+          } catch (const YAML::Exception &e) {
             SPDLOG_ERROR("Error parsing YAML file, aborting");
             SPDLOG_ERROR("{}", e.msg);
             exit(EXIT_FAILURE);
           }
           break;
 
+        case 'r':
+          try {
+            CheckpointReader::readFile(particles, optarg, *this);
+          } catch (const YAML::Exception &e) {
+            SPDLOG_ERROR("Error parsing settings of checkpoint, aborting");
+            SPDLOG_ERROR("{}", e.msg);
+            exit(EXIT_FAILURE);
+          }
+          break;
+
         case 'b':
           simulation.brown_motion_avg_velocity = std::stod(optarg);
           break;
@@ -101,6 +169,115 @@ void Settings::parseArguments(int argc, char *argv[]) {
           output.log_level = spdlog::level::from_str(optarg);
           break;
 
+        case TIMERS:
+          timer_interval = optarg ? std::stoul(optarg) : 0;
+          break;
+
+        case PERF_COUNTERS:
+          perf_counters = optarg ? std::stoull(optarg, nullptr, 16) : 0;
+          // the counters are reported together with the phase timers
+          if (!timer_interval) timer_interval = 0;
+          break;
+
+        case MEMORY:
+          memory_interval = optarg ? std::stoul(optarg) : 0;
+          break;
+
+        case DRY_RUN:
+          dry_run = true;
+          break;
+
+        case PAIR_STATISTICS:
+          pair_statistics = true;
+          break;
+
+        case TRACE:
+          if (!trace) trace.emplace();
+          trace->file = optarg;
+          // the phases are recorded by the phase timers
+          if (!timer_interval) timer_interval = 0;
+          break;
+
+        case TRACE_STEPS: {
+          if (!trace) trace.emplace();
+          const std::string steps = optarg;
+          const auto colon = steps.find(':');
+          if (colon == std::string::npos) throw std::invalid_argument("expected FIRST:LAST");
+          trace->first = std::stoull(steps.substr(0, colon));
+          trace->last = std::stoull(steps.substr(colon + 1));
+          if (trace->last < trace->first) throw std::invalid_argument("last step before the first one");
+          break;
+        }
+
+        case BENCHMARK:
+          if (!benchmark) benchmark.emplace();
+          if (optarg) benchmark->repetitions = std::stoul(optarg);
+          break;
+
+        case WARMUP:
+          if (!benchmark) benchmark.emplace();
+          benchmark->warmup = std::stoul(optarg);
+          break;
+
+        case BENCHMARK_OUTPUT:
+          if (!benchmark) benchmark.emplace();
+          benchmark->output = optarg;
+          break;
+
+        case CELL_COSTS:
+          output.cell_costs = optarg ? string_to_cell_cost_format(optarg) : CellCostFormat::VTI;
+          break;
+
+        case SCALING: {
+          if (!scaling) scaling.emplace();
+          const std::string mode = optarg;
+          if (mode == "strong") {
+            scaling->mode = Scaling::Mode::STRONG;
+          } else if (mode == "weak") {
+            scaling->mode = Scaling::Mode::WEAK;
+          } else {
+            SPDLOG_ERROR("Unknown scaling mode {}, expected strong or weak", mode);
+            exit(EXIT_FAILURE);
+          }
+          break;
+        }
+
+        case SCALING_THREADS: {
+          if (!scaling) scaling.emplace();
+          scaling->threads.clear();
+          std::stringstream list(optarg);
+          std::string threads;
+          while (std::getline(list, threads, ',')) {
+            if (std::stoul(threads) == 0) throw std::invalid_argument("thread count must be positive");
+            scaling->threads.push_back(std::stoul(threads));
+          }
+          break;
+        }
+
+        case SCALING_PARTICLES:
+          if (!scaling) scaling.emplace();
+          scaling->particles = std::stoul(optarg);
+          break;
+
+        case SCALING_DENSITY:
+          if (!scaling) scaling.emplace();
+          scaling->density = std::stod(optarg);
+          break;
+
+        case SCALING_SHAPE: {
+          if (!scaling) scaling.emplace();
+          const std::string shape = optarg;
+          if (shape == "cuboid") {
+            scaling->shape = Scaling::Shape::CUBOID;
+          } else if (shape == "disc") {
+            scaling->shape = Scaling::Shape::DISC;
+          } else {
+            SPDLOG_ERROR("Unknown scaling shape {}, expected cuboid or disc", shape);
+            exit(EXIT_FAILURE);
+          }
+          break;
+        }
+
         case 'h':
           printHelp();
           exit(EXIT_SUCCESS);
@@ -119,6 +296,17 @@ void Settings::parseArguments(int argc, char *argv[]) {
       exit(EXIT_FAILURE);
     }
   }
+
+  // the dry run only estimates a regular simulation, the benchmark and the scaling study set up their own
+  if (dry_run && (benchmark || scaling)) {
+    SPDLOG_ERROR("--dry-run can not be combined with --benchmark or --scaling");
+    exit(EXIT_FAILURE);
+  }
+  // --trace-steps only selects the window of a trace, it does not name a file to write it to
+  if (trace && trace->file.empty()) {
+    SPDLOG_ERROR("--trace-steps requires --trace=FILE");
+    exit(EXIT_FAILURE);
+  }
 }
 
 void Settings::createOutputDirectory(const std::filesystem::path &directory) {
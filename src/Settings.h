@@ -3,11 +3,21 @@
 #include <getopt.h>
 #include <spdlog/spdlog.h>
 
+#include <cstdint>
 #include <filesystem>
 #include <iostream>
 #include <optional>
+#include <utility>
+#include <vector>
 
+#include "container/bonds/BondList.h"
 #include "container/linkedCells/Cell.h"
+#include "outputWriter/CellCostFormat.h"
+#include "outputWriter/TrajectoryWriter.h"
+#include "outputWriter/VTKWriter.h"
+#include "simulations/ForceGroup.h"
+#include "simulations/PlanetSimulation.h"
+#include "simulations/Simulation.h"
 
 /**
  * @class Settings
@@ -27,6 +37,27 @@ class Settings {
 
     /** @brief Path to the filename to export */
     std::optional<std::filesystem::path> export_filename;
+    /** @brief Path to write a binary checkpoint to at the end of the simulation */
+    std::optional<std::filesystem::path> checkpoint_filename;
+    /** @brief Wall clock time in seconds between two checkpoints during the simulation */
+    std::optional<double> checkpoint_interval;
+
+    /** @brief If set, all frames are written into a single binary trajectory file `<prefix>.trj` */
+    std::optional<TrajectoryOptions> trajectory;
+
+    /** @brief Number of particle snapshots that may wait to be written before the simulation blocks */
+    unsigned int buffers = 2;
+
+    /** @brief Encoding of the data arrays in vtu files, only used if ENABLE_VTK_OUTPUT is set */
+    VTKDataMode vtk_mode = VTKDataMode::APPENDED;
+    /** @brief Compress the data arrays of vtu files (binary and appended mode) */
+    bool vtk_compression = true;
+
+    /**
+     * @brief If set, the costs of every linked cell are measured and written with the particles, summed up over the
+     * iterations since the previous output
+     */
+    std::optional<CellCostFormat> cell_costs;
 
     /** @brief Log level for console/file output */
     spdlog::level::level_enum log_level = spdlog::level::info;
@@ -40,13 +71,14 @@ class Settings {
     std::optional<double> k;
     /** @brief Material Specific Epsilon Value of the membrane*/
     std::optional<double> sigma;
-    /** @brief Upwards Force for specific membrane Particles*/
-    std::optional<double> f_zUp;
-    /** @brief Membrane Particles, to which f_zUp should be applied*/
-    std::vector<Particle *> upwardsParticles;
+    /** @brief Bonds between the membrane particles */
+    BondList bonds;
   };
   struct Membrane membrane;
 
+  /** @brief External forces acting on groups of particles. The particle indices are resolved when reading the input */
+  std::vector<ForceGroup> force_groups;
+
   struct Simulation {
     /** @brief Which worksheet to run */
     std::optional<unsigned int> worksheet;
@@ -57,6 +89,14 @@ class Settings {
     std::optional<double> end_time;
     /** @brief amount of time that passes each iteration */
     std::optional<double> delta_t;
+    /** @brief Bounds for the adaptive timestep. If set, delta_t is only used for the first iteration */
+    std::optional<AdaptiveTimestep> adaptive_timestep;
+    /** @brief Time integration scheme for the direct sum simulations (worksheet 1 and 2) */
+    std::optional<Integrator> integrator;
+    /** @brief Number of levels of the block timestep integrator */
+    std::optional<unsigned int> block_levels;
+    /** @brief Accuracy parameter of the block timestep integrator */
+    std::optional<double> block_eta;
 
     /** @brief Domain */
     std::optional<Vector3> domain;
@@ -81,6 +121,96 @@ class Settings {
   };
   struct Simulation simulation;
 
+  /**
+   * @brief State of an interrupted run that is not part of the input settings
+   */
+  struct Restart {
+    /** @brief Number of iterations finished before the checkpoint */
+    std::uint64_t iteration = 0;
+    /** @brief Timestep of the next iteration */
+    double delta_t = 0;
+    /** @brief Pairs of cell index and particle index, see LinkedCells::getCellOrder() */
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> cell_order;
+  };
+  /** @brief Set if the simulation continues from a checkpoint */
+  std::optional<Restart> restart;
+
+  /**
+   * @brief Settings of the benchmark mode
+   */
+  struct Benchmark {
+    /** @brief Number of measured runs, each starting from the input particles with a newly built container */
+    unsigned int repetitions = 5;
+    /** @brief Iterations at the start of every run that are not part of the measured time */
+    unsigned int warmup = 10;
+    /** @brief File the results are written to as JSON */
+    std::optional<std::filesystem::path> output;
+  };
+  /** @brief Set if the simulation should be benchmarked instead of run normally */
+  std::optional<Benchmark> benchmark;
+
+  /**
+   * @brief Settings of the scaling study
+   */
+  struct Scaling {
+    /** @brief Strong scaling keeps the number of particles, weak scaling grows it with the number of threads */
+    enum class Mode { STRONG, WEAK };
+    /** @brief Shape of the generated particles */
+    enum class Shape { CUBOID, DISC };
+
+    Mode mode = Mode::STRONG;
+    /** @brief Thread counts of the sweep. The first one is the reference of the efficiency */
+    std::vector<unsigned int> threads;
+    /**
+     * @brief Number of generated particles for the first thread count. If not set, the input particles are used
+     * instead of a generated scenario, which is only possible for strong scaling
+     */
+    std::optional<size_t> particles;
+    /** @brief Particles per unit volume (per unit area for 2D simulations) of the generated scenario */
+    double density = 0.8;
+    Shape shape = Shape::CUBOID;
+  };
+  /** @brief Set if a scaling study should be run instead of the simulation. Uses the repetitions of benchmark */
+  std::optional<Scaling> scaling;
+
+  /**
+   * @brief Set if the phase timers are enabled. Iterations between intermediate reports, 0 to only report at the end
+   */
+  std::optional<unsigned int> timer_interval;
+
+  /**
+   * @brief Set if the phase timers also read the hardware performance counters. Config of an additional raw event, 0
+   * for none
+   */
+  std::optional<std::uint64_t> perf_counters;
+
+  /**
+   * @brief Set if the memory of the subsystems is measured after every iteration. Iterations between intermediate
+   * reports, 0 to only report at the start and at the end
+   */
+  std::optional<unsigned int> memory_interval;
+
+  /** @brief If the memory of the scenario should be estimated without running the simulation */
+  bool dry_run = false;
+
+  /** @brief If the distance tests, interactions and cell occupancy of the linked cells are counted and reported */
+  bool pair_statistics = false;
+
+  /**
+   * @struct Trace
+   * @brief Settings of the timeline export
+   */
+  struct Trace {
+    /** @brief File the Chrome trace is written to */
+    std::filesystem::path file;
+    /** @brief First traced iteration, counted from the start of the run */
+    std::uint64_t first = 0;
+    /** @brief Last traced iteration, counted from the start of the run */
+    std::uint64_t last = 9;
+  };
+  /** @brief Set if a timeline of the phases and loop chunks of every thread should be exported */
+  std::optional<Trace> trace;
+
   /** If the simulation should use the LinkedCellsV2 container */
   bool useAlternateParallelisation = false;
 
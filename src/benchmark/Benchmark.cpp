@@ -0,0 +1,221 @@
+#include "benchmark/Benchmark.h"
+
+#include <omp.h>
+#include <spdlog/fmt/fmt.h>
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <numeric>
+#include <string>
+
+#include "simulations/SimulationFactory.h"
+#include "utils/PerfCounters.h"
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+double seconds(Clock::time_point start, Clock::time_point end) {
+  return std::chrono::duration<double>(end - start).count();
+}
+
+std::string toJSON(const BenchmarkStatistics &statistics) {
+  return fmt::format(R"({{"median": {}, "mean": {}, "stddev": {}, "min": {}, "max": {}}})", statistics.median,
+                     statistics.mean, statistics.stddev, statistics.min, statistics.max);
+}
+}  // namespace
+
+BenchmarkRepetition Benchmark::runOnce(const std::vector<Particle> &particles, Settings &settings) {
+  std::vector<Particle> copy = particles;
+  BenchmarkRepetition result;
+  const unsigned int warmup = settings.benchmark->warmup;
+
+  const auto setup_start = Clock::now();
+  SimulationSetup setup = SimulationFactory::create(copy, settings);
+  const auto start = Clock::now();
+  result.setup = seconds(setup_start, start);
+
+  auto warmup_end = start;
+  PhaseTimers::Totals warmup_timers = PhaseTimers::snapshot();
+  unsigned int steps = 0;
+  setup.simulation->run([&](unsigned int) {
+    if (++steps != warmup) return;
+    warmup_end = Clock::now();
+    warmup_timers = PhaseTimers::snapshot();
+  });
+  const auto end = Clock::now();
+
+  if (steps <= warmup) {
+    // everything was warmup, there is nothing to measure
+    result.warmup = seconds(start, end);
+    result.warmup_steps = steps;
+    return result;
+  }
+  result.warmup = seconds(start, warmup_end);
+  result.measured = seconds(warmup_end, end);
+  result.warmup_steps = warmup;
+  result.measured_steps = steps - warmup;
+  if (PhaseTimers::enabled) result.timers = PhaseTimers::snapshot() - warmup_timers;
+  return result;
+}
+
+std::string Benchmark::containerName(const Settings &settings) {
+  if (settings.simulation.worksheet.value() < 3) return "DirectSum";
+  return settings.useAlternateParallelisation ? "LinkedCellsV2" : "LinkedCells";
+}
+
+BenchmarkStatistics Benchmark::summarize(std::vector<double> samples) {
+  BenchmarkStatistics result;
+  if (samples.empty()) return result;
+
+  std::sort(samples.begin(), samples.end());
+  const size_t n = samples.size();
+  result.median = n % 2 == 1 ? samples[n / 2] : (samples[n / 2 - 1] + samples[n / 2]) / 2;
+  result.mean = std::accumulate(samples.begin(), samples.end(), 0.0) / static_cast<double>(n);
+  result.min = samples.front();
+  result.max = samples.back();
+  if (n > 1) {
+    double squares = 0;
+    for (const double sample : samples) squares += (sample - result.mean) * (sample - result.mean);
+    result.stddev = std::sqrt(squares / static_cast<double>(n - 1));
+  }
+  return result;
+}
+
+int Benchmark::run(const std::vector<Particle> &particles, Settings &settings) {
+  const auto &options = settings.benchmark.value();
+  if (options.repetitions == 0) {
+    SPDLOG_ERROR("The benchmark needs at least one repetition");
+    return EXIT_FAILURE;
+  }
+  SPDLOG_INFO("Benchmarking worksheet {} with {} particles, {} threads, {} repetitions and {} warmup iterations",
+              settings.simulation.worksheet.value(), particles.size(), omp_get_max_threads(), options.repetitions,
+              options.warmup);
+
+  std::vector<BenchmarkRepetition> repetitions;
+  for (unsigned int i = 0; i < options.repetitions; i++) {
+    // the per iteration logging would be part of the measurement
+    spdlog::set_level(std::max(settings.output.log_level, spdlog::level::warn));
+    repetitions.push_back(runOnce(particles, settings));
+    spdlog::set_level(settings.output.log_level);
+    SPDLOG_INFO("Repetition {}/{}: setup {:.3f}s, warmup {:.3f}s, measured {:.3f}s", i + 1, options.repetitions,
+                repetitions.back().setup, repetitions.back().warmup, repetitions.back().measured);
+  }
+
+  if (repetitions.front().measured_steps == 0) {
+    SPDLOG_WARN("The simulation has only {} iterations, all of them are warmup", repetitions.front().warmup_steps);
+  }
+
+  const auto phases = summarize(repetitions, particles.size());
+  std::cout << fmt::format("{:<10}{:>12}{:>12}{:>12}{:>12}{:>10}\n", "phase", "median [s]", "stddev [s]", "min [s]",
+                           "MUPS", "steps");
+  for (const auto &phase : phases) {
+    std::cout << fmt::format("{:<10}{:>12.4f}{:>12.4f}{:>12.4f}{:>12.3f}{:>10}\n", phase.name, phase.seconds.median,
+                             phase.seconds.stddev, phase.seconds.min, phase.mups.median, phase.steps);
+  }
+
+  if (PhaseTimers::enabled) {
+    PhaseTimers::Totals timers;
+    for (const auto &repetition : repetitions) timers += repetition.timers;
+    std::cout << "\nPhases of the measured iterations of all repetitions:\n"
+              << PhaseTimers::format(timers) << PhaseTimers::formatCounters(timers);
+  }
+
+  if (options.output.has_value()) writeJSON(options.output.value(), phases, repetitions, particles.size(), settings);
+  return EXIT_SUCCESS;
+}
+
+std::vector<BenchmarkPhase> Benchmark::summarize(const std::vector<BenchmarkRepetition> &repetitions,
+                                                 size_t particle_count) {
+  const auto phase = [&](const std::string &name, unsigned int steps, auto time) {
+    std::vector<double> seconds;
+    std::vector<double> mups;
+    for (const auto &repetition : repetitions) {
+      seconds.push_back(repetition.*time);
+      mups.push_back(steps > 0 && repetition.*time > 0 ? particle_count * steps / (repetition.*time) * 1e-6 : 0);
+    }
+    return BenchmarkPhase{name, steps, summarize(seconds), summarize(mups)};
+  };
+
+  return {phase("setup", 0, &BenchmarkRepetition::setup),
+          phase("warmup", repetitions.front().warmup_steps, &BenchmarkRepetition::warmup),
+          phase("measured", repetitions.front().measured_steps, &BenchmarkRepetition::measured)};
+}
+
+void Benchmark::writeJSON(const std::filesystem::path &filename, const std::vector<BenchmarkPhase> &phases,
+                          const std::vector<BenchmarkRepetition> &repetitions, size_t particle_count,
+                          const Settings &settings) {
+  std::ofstream file(filename);
+  if (!file.is_open()) {
+    SPDLOG_ERROR("Error opening {}", filename.string());
+    exit(EXIT_FAILURE);
+  }
+
+  file << "{\n"
+       << fmt::format("  \"worksheet\": {},\n", settings.simulation.worksheet.value())
+       << fmt::format("  \"container\": \"{}\",\n", containerName(settings))
+       << fmt::format("  \"particles\": {},\n", particle_count)
+       << fmt::format("  \"threads\": {},\n", omp_get_max_threads())
+       << fmt::format("  \"delta_t\": {},\n", settings.simulation.delta_t.value()) << "  \"phases\": {\n";
+  for (size_t i = 0; i < phases.size(); i++) {
+    file << fmt::format("    \"{}\": {{\"steps\": {}, \"seconds\": {}, \"mups\": {}}}{}\n", phases[i].name,
+                        phases[i].steps, toJSON(phases[i].seconds), toJSON(phases[i].mups),
+                        i + 1 < phases.size() ? "," : "");
+  }
+  file << "  },\n";
+
+  if (PhaseTimers::enabled) {
+    // wall time per iteration of every phase, e.g. to compare the force calculation of two containers
+    std::vector<std::string> entries;
+    for (int phase = 0; phase < PhaseTimers::PHASE_COUNT; phase++) {
+      if (repetitions.front().timers.calls[phase] == 0) continue;
+      std::vector<double> per_step;
+      for (const auto &r : repetitions) {
+        per_step.push_back(r.measured_steps > 0 ? r.timers.wall[phase] / r.measured_steps : 0);
+      }
+      entries.push_back(fmt::format("    \"{}\": {}", PhaseTimers::name(static_cast<PhaseTimers::Phase>(phase)),
+                                    toJSON(summarize(per_step))));
+    }
+    file << "  \"seconds_per_step\": {\n";
+    for (size_t i = 0; i < entries.size(); i++) file << entries[i] << (i + 1 < entries.size() ? ",\n" : "\n");
+    file << "  },\n";
+  }
+
+  if (PerfCounters::enabled) {
+    // counters per iteration of every phase summed over all threads and repetitions
+    PhaseTimers::Totals timers;
+    unsigned int steps = 0;
+    for (const auto &r : repetitions) {
+      timers += r.timers;
+      steps += r.measured_steps;
+    }
+    const auto sums = PhaseTimers::counterTotals(timers);
+    std::vector<std::string> entries;
+    for (int phase = 0; phase < PhaseTimers::PHASE_COUNT && steps > 0 && !timers.counters.empty(); phase++) {
+      if (timers.calls[phase] == 0) continue;
+      std::string values;
+      for (int event = 0; event < PerfCounters::EVENT_COUNT; event++) {
+        const auto e = static_cast<PerfCounters::Event>(event);
+        if (!PerfCounters::available(e)) continue;
+        values += fmt::format("{}\"{}\": {}", values.empty() ? "" : ", ", PerfCounters::name(e), sums[phase][e] / steps);
+      }
+      entries.push_back(
+          fmt::format("    \"{}\": {{{}}}", PhaseTimers::name(static_cast<PhaseTimers::Phase>(phase)), values));
+    }
+    file << "  \"counters_per_step\": {\n";
+    for (size_t i = 0; i < entries.size(); i++) file << entries[i] << (i + 1 < entries.size() ? ",\n" : "\n");
+    file << "  },\n";
+  }
+
+  file << "  \"repetitions\": [\n";
+  for (size_t i = 0; i < repetitions.size(); i++) {
+    const auto &r = repetitions[i];
+    file << fmt::format("    {{\"setup\": {}, \"warmup\": {}, \"measured\": {}}}{}\n", r.setup, r.warmup, r.measured,
+                        i + 1 < repetitions.size() ? "," : "");
+  }
+  file << "  ]\n}\n";
+  SPDLOG_INFO("Benchmark results written to {}", filename.string());
+}
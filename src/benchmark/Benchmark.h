@@ -0,0 +1,118 @@
+#pragma once
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "Particle.h"
+#include "Settings.h"
+#include "utils/PhaseTimers.h"
+
+/**
+ * @struct BenchmarkRepetition
+ * @brief Measured times of a single benchmark run
+ */
+struct BenchmarkRepetition {
+  /** @brief Seconds needed to build the container and the simulation */
+  double setup = 0;
+  /** @brief Seconds of the warmup iterations */
+  double warmup = 0;
+  /** @brief Seconds of the measured iterations */
+  double measured = 0;
+  /** @brief Number of warmup iterations */
+  unsigned int warmup_steps = 0;
+  /** @brief Number of measured iterations */
+  unsigned int measured_steps = 0;
+  /** @brief Phase times of the measured iterations, empty if the phase timers are disabled */
+  PhaseTimers::Totals timers;
+};
+
+/**
+ * @struct BenchmarkStatistics
+ * @brief Statistics of one phase over all repetitions
+ */
+struct BenchmarkStatistics {
+  /** @brief Median of the samples */
+  double median = 0;
+  /** @brief Arithmetic mean of the samples */
+  double mean = 0;
+  /** @brief Sample standard deviation, 0 for less than two samples */
+  double stddev = 0;
+  /** @brief Smallest sample */
+  double min = 0;
+  /** @brief Largest sample */
+  double max = 0;
+};
+
+/**
+ * @struct BenchmarkPhase
+ * @brief Summary of one phase over all repetitions
+ */
+struct BenchmarkPhase {
+  /** @brief Name of the phase */
+  std::string name;
+  /** @brief Iterations per repetition, 0 for phases without iterations */
+  unsigned int steps = 0;
+  /** @brief Duration in seconds */
+  BenchmarkStatistics seconds;
+  /** @brief Million particle updates per second, only meaningful if steps is not 0 */
+  BenchmarkStatistics mups;
+};
+
+/**
+ * @class Benchmark
+ * @brief Runtime benchmark of a simulation, replaces a normal run if `--benchmark` is given
+ *
+ * Every repetition starts from a copy of the input particles and builds a new container and simulation, so no state
+ * is carried over between repetitions. The first iterations of each repetition warm up caches and the thread pool and
+ * are reported separately. No output files are written while benchmarking. With `--timers`, the measured iterations
+ * are also broken down into the phases of PhaseTimers.
+ */
+class Benchmark {
+ public:
+  /**
+   * @brief Runs all repetitions, prints a summary and writes the JSON report if an output file is set
+   *
+   * @param particles Input particles, every repetition starts from a copy
+   * @param settings Settings of the simulation, settings.benchmark must be set
+   * @return Exit code of the program
+   */
+  static int run(const std::vector<Particle> &particles, Settings &settings);
+
+  /**
+   * @brief Runs the simulation once from a copy of the particles
+   *
+   * @param particles Input particles
+   * @param settings Settings of the simulation, settings.benchmark must be set
+   * @return Times of the phases
+   */
+  static BenchmarkRepetition runOnce(const std::vector<Particle> &particles, Settings &settings);
+
+  /**
+   * @param samples Measured values, at least one
+   * @return Median, mean, standard deviation, minimum and maximum of the samples
+   */
+  static BenchmarkStatistics summarize(std::vector<double> samples);
+
+  /**
+   * @param repetitions Measured repetitions, at least one
+   * @param particle_count Number of simulated particles
+   * @return Statistics of the setup, warmup and measured phase
+   */
+  static std::vector<BenchmarkPhase> summarize(const std::vector<BenchmarkRepetition> &repetitions,
+                                               size_t particle_count);
+
+  /**
+   * @param settings Settings of the simulation
+   * @return Name of the particle container the simulation uses
+   */
+  static std::string containerName(const Settings &settings);
+
+ private:
+  /**
+   * @brief Writes the results as JSON
+   */
+  static void writeJSON(const std::filesystem::path &filename, const std::vector<BenchmarkPhase> &phases,
+                        const std::vector<BenchmarkRepetition> &repetitions, size_t particle_count,
+                        const Settings &settings);
+};
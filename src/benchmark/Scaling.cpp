@@ -0,0 +1,233 @@
+#include "benchmark/Scaling.h"
+
+#include <omp.h>
+#include <spdlog/fmt/fmt.h>
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "benchmark/Benchmark.h"
+#include "utils/ParticleGenerator.h"
+
+namespace {
+/**
+ * @return 1, 2, 4, ... up to the maximum number of threads, which is always part of the sweep
+ */
+std::vector<unsigned int> defaultThreads() {
+  const auto max_threads = static_cast<unsigned int>(omp_get_max_threads());
+  std::vector<unsigned int> threads;
+  for (unsigned int t = 1; t < max_threads; t *= 2) threads.push_back(t);
+  threads.push_back(max_threads);
+  return threads;
+}
+
+/**
+ * @return Phases that were measured in the reference run
+ */
+std::vector<PhaseTimers::Phase> measuredPhases(const std::vector<ScalingRun> &runs) {
+  std::vector<PhaseTimers::Phase> phases;
+  for (int phase = 0; phase < PhaseTimers::PHASE_COUNT; phase++) {
+    if (runs.front().seconds_per_step[phase] > 0) phases.push_back(static_cast<PhaseTimers::Phase>(phase));
+  }
+  return phases;
+}
+}  // namespace
+
+void Scaling::generateScenario(std::vector<Particle> &particles, Settings &settings, const size_t count,
+                               const std::vector<Particle> &templates) {
+  const auto &options = settings.scaling.value();
+  const bool is2D = settings.simulation.is2D;
+  const double spacing = std::pow(1.0 / options.density, is2D ? 1.0 / 2.0 : 1.0 / 3.0);
+  const double mass = templates.empty() ? 1.0 : templates.front().getM();
+  std::optional<double> epsilon;
+  std::optional<double> sigma;
+  if (!templates.empty()) {
+    epsilon = templates.front().getEpsilon();
+    sigma = templates.front().getSigma();
+  }
+  // the linked cells need at least one cell in every direction
+  const double min_size = settings.simulation.cutoff_radius.value_or(0.0);
+  const double depth = is2D ? settings.simulation.domain.value_or(Vector3{0, 0, 1})[2] : 0.0;
+
+  if (options.shape == Settings::Scaling::Shape::DISC) {
+    if (!is2D) {
+      SPDLOG_ERROR("Disc scenarios are only available for 2D simulations");
+      exit(EXIT_FAILURE);
+    }
+    // a disc of radius r contains about pi (r - 1)^2 particles
+    const int radius = static_cast<int>(std::ceil(std::sqrt(static_cast<double>(count) / M_PI))) + 1;
+    const double size = std::max(2 * radius * spacing, min_size);
+    settings.simulation.domain = Vector3{size, size, depth};
+    ParticleGenerator::disc(particles, {size / 2, size / 2, 0}, radius, spacing, mass, epsilon, sigma, {0, 0, 0});
+  } else {
+    std::array<unsigned int, 3> n{};
+    if (is2D) {
+      n[0] = std::max(1u, static_cast<unsigned int>(std::lround(std::sqrt(static_cast<double>(count)))));
+      n[1] = static_cast<unsigned int>((count + n[0] - 1) / n[0]);
+      n[2] = 1;
+    } else {
+      n[0] = std::max(1u, static_cast<unsigned int>(std::lround(std::cbrt(static_cast<double>(count)))));
+      n[1] = n[0];
+      n[2] = static_cast<unsigned int>((count + n[0] * n[1] - 1) / (n[0] * n[1]));
+    }
+    Vector3 domain{depth, depth, depth};
+    for (int axis = 0; axis < (is2D ? 2 : 3); axis++) domain[axis] = std::max(n[axis] * spacing, min_size);
+    settings.simulation.domain = domain;
+    // the first layer keeps half the spacing to the border, like its periodic images on the other side
+    const Vector3 corner{spacing / 2, spacing / 2, is2D ? 0 : spacing / 2};
+    ParticleGenerator::cuboid(particles, corner, n, spacing, mass, epsilon, sigma, {0, 0, 0});
+  }
+
+  if (!settings.force_groups.empty() || settings.membrane.bonds.size() != 0) {
+    SPDLOG_WARN("Bonds and force groups of the input are not part of the generated scenario");
+    settings.force_groups.clear();
+    settings.membrane.bonds = BondList{};
+  }
+  settings.restart.reset();
+}
+
+void Scaling::calculateEfficiency(std::vector<ScalingRun> &runs) {
+  if (runs.empty()) return;
+  const ScalingRun &reference = runs.front();
+  for (auto &run : runs) {
+    for (int phase = 0; phase < PhaseTimers::PHASE_COUNT; phase++) {
+      // seconds per particle and thread
+      const double reference_cost =
+          reference.seconds_per_step[phase] * reference.threads / static_cast<double>(reference.particles);
+      const double cost = run.seconds_per_step[phase] * run.threads / static_cast<double>(run.particles);
+      run.efficiency[phase] = cost > 0 ? reference_cost / cost : 0;
+    }
+  }
+}
+
+int Scaling::run(const std::vector<Particle> &particles, Settings &settings) {
+  auto &options = settings.scaling.value();
+  if (!settings.benchmark) settings.benchmark.emplace();
+  const auto &benchmark = settings.benchmark.value();
+  if (benchmark.repetitions == 0) {
+    SPDLOG_ERROR("The scaling study needs at least one repetition");
+    return EXIT_FAILURE;
+  }
+  if (options.mode == Settings::Scaling::Mode::WEAK && !options.particles) {
+    SPDLOG_ERROR("Weak scaling needs a generated scenario, set the particles per reference run with "
+                 "--scaling-particles");
+    return EXIT_FAILURE;
+  }
+  if (options.threads.empty()) options.threads = defaultThreads();
+
+  const int max_threads = omp_get_max_threads();
+  const bool weak = options.mode == Settings::Scaling::Mode::WEAK;
+  SPDLOG_INFO("{} scaling of worksheet {} with {} over {} thread counts", weak ? "Weak" : "Strong",
+              settings.simulation.worksheet.value(), Benchmark::containerName(settings), options.threads.size());
+
+  std::vector<ScalingRun> runs;
+  for (const unsigned int threads : options.threads) {
+    std::vector<Particle> scenario;
+    if (options.particles) {
+      size_t count = options.particles.value();
+      if (weak) count = count * threads / options.threads.front();
+      generateScenario(scenario, settings, count, particles);
+    } else {
+      scenario = particles;
+    }
+
+    omp_set_num_threads(static_cast<int>(threads));
+    // also sizes the per thread busy times for this thread count
+    PhaseTimers::enable();
+
+    ScalingRun run;
+    run.threads = threads;
+    run.particles = scenario.size();
+    std::vector<BenchmarkRepetition> repetitions;
+    for (unsigned int i = 0; i < benchmark.repetitions; i++) {
+      spdlog::set_level(std::max(settings.output.log_level, spdlog::level::warn));
+      repetitions.push_back(Benchmark::runOnce(scenario, settings));
+      spdlog::set_level(settings.output.log_level);
+    }
+    run.steps = repetitions.front().measured_steps;
+    if (run.steps == 0) {
+      SPDLOG_ERROR("The simulation has only {} iterations, all of them are warmup",
+                   repetitions.front().warmup_steps);
+      omp_set_num_threads(max_threads);
+      return EXIT_FAILURE;
+    }
+
+    for (int phase = 0; phase < PhaseTimers::PHASE_COUNT; phase++) {
+      std::vector<double> per_step;
+      for (const auto &r : repetitions) per_step.push_back(r.timers.wall[phase] / r.measured_steps);
+      run.seconds_per_step[phase] = Benchmark::summarize(per_step).median;
+    }
+    run.mups = Benchmark::summarize(repetitions, run.particles).back().mups.median;
+    SPDLOG_INFO("{} threads, {} particles: {:.4f} ms per iteration, {:.3f} MUPS", threads, run.particles,
+                run.seconds_per_step[PhaseTimers::STEP] * 1e3, run.mups);
+    runs.push_back(run);
+  }
+  omp_set_num_threads(max_threads);
+  if (!settings.timer_interval) PhaseTimers::disable();
+  calculateEfficiency(runs);
+
+  std::cout << fmt::format("{:>8}{:>12}{:>14}{:>10}{:>12}{:>10}\n", "threads", "particles", "step [ms]", "speedup",
+                           "efficiency", "MUPS");
+  for (const auto &run : runs) {
+    const double efficiency = run.efficiency[PhaseTimers::STEP];
+    const double speedup = efficiency * run.threads / runs.front().threads;
+    std::cout << fmt::format("{:>8}{:>12}{:>14.4f}{:>10.2f}{:>12.2f}{:>10.3f}\n", run.threads, run.particles,
+                             run.seconds_per_step[PhaseTimers::STEP] * 1e3, speedup, efficiency, run.mups);
+  }
+
+  std::cout << fmt::format("\nEfficiency of the phases:\n{:<16}", "phase");
+  for (const auto &run : runs) std::cout << fmt::format("{:>10}", fmt::format("{} thr", run.threads));
+  std::cout << "\n";
+  for (const auto phase : measuredPhases(runs)) {
+    std::cout << fmt::format("{:<16}", PhaseTimers::name(phase));
+    for (const auto &run : runs) std::cout << fmt::format("{:>10.2f}", run.efficiency[phase]);
+    std::cout << "\n";
+  }
+
+  if (benchmark.output.has_value()) writeJSON(benchmark.output.value(), runs, settings);
+  return EXIT_SUCCESS;
+}
+
+void Scaling::writeJSON(const std::filesystem::path &filename, const std::vector<ScalingRun> &runs,
+                        const Settings &settings) {
+  std::ofstream file(filename);
+  if (!file.is_open()) {
+    SPDLOG_ERROR("Error opening {}", filename.string());
+    exit(EXIT_FAILURE);
+  }
+
+  const auto &options = settings.scaling.value();
+  std::string scenario = "input";
+  if (options.particles) scenario = options.shape == Settings::Scaling::Shape::DISC ? "disc" : "cuboid";
+  file << "{\n"
+       << fmt::format("  \"mode\": \"{}\",\n", options.mode == Settings::Scaling::Mode::WEAK ? "weak" : "strong")
+       << fmt::format("  \"worksheet\": {},\n", settings.simulation.worksheet.value())
+       << fmt::format("  \"container\": \"{}\",\n", Benchmark::containerName(settings))
+       << fmt::format("  \"scenario\": \"{}\",\n", scenario);
+  if (options.particles) file << fmt::format("  \"density\": {},\n", options.density);
+  file << fmt::format("  \"delta_t\": {},\n", settings.simulation.delta_t.value()) << "  \"runs\": [\n";
+
+  const auto phases = measuredPhases(runs);
+  const auto object = [&phases](const std::array<double, PhaseTimers::PHASE_COUNT> &values) {
+    std::string result = "{";
+    for (size_t i = 0; i < phases.size(); i++) {
+      result += fmt::format("\"{}\": {}{}", PhaseTimers::name(phases[i]), values[phases[i]],
+                            i + 1 < phases.size() ? ", " : "");
+    }
+    return result + "}";
+  };
+  for (size_t i = 0; i < runs.size(); i++) {
+    const auto &run = runs[i];
+    file << fmt::format(
+        "    {{\"threads\": {}, \"particles\": {}, \"steps\": {}, \"mups\": {}, \"seconds_per_step\": {}, "
+        "\"efficiency\": {}}}{}\n",
+        run.threads, run.particles, run.steps, run.mups, object(run.seconds_per_step), object(run.efficiency),
+        i + 1 < runs.size() ? "," : "");
+  }
+  file << "  ]\n}\n";
+  SPDLOG_INFO("Scaling results written to {}", filename.string());
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <array>
+#include <filesystem>
+#include <vector>
+
+#include "Particle.h"
+#include "Settings.h"
+#include "utils/PhaseTimers.h"
+
+/**
+ * @struct ScalingRun
+ * @brief Measured times of the scaling study for one thread count
+ */
+struct ScalingRun {
+  /** @brief Number of OpenMP threads */
+  unsigned int threads = 0;
+  /** @brief Number of simulated particles */
+  size_t particles = 0;
+  /** @brief Measured iterations per repetition */
+  unsigned int steps = 0;
+  /** @brief Median over all repetitions of the wall time per iteration of every phase, 0 if it was not measured */
+  std::array<double, PhaseTimers::PHASE_COUNT> seconds_per_step{};
+  /** @brief Parallel efficiency of every phase compared to the first run of the study */
+  std::array<double, PhaseTimers::PHASE_COUNT> efficiency{};
+  /** @brief Median of the million particle updates per second of the measured iterations */
+  double mups = 0;
+};
+
+/**
+ * @class Scaling
+ * @brief Strong and weak scaling study, replaces a normal run if `--scaling` is given
+ *
+ * Runs the benchmark of the simulation for every thread count of the sweep. For strong scaling, all runs simulate the
+ * same particles. For weak scaling, the number of particles grows proportional to the number of threads. The
+ * particles are either the input particles or a generated cuboid or disc of the requested size and density, all other
+ * parameters come from the input settings. The phase timers are enabled for the study, so the efficiency is reported
+ * for every phase of the iterations.
+ */
+class Scaling {
+ public:
+  /**
+   * @brief Runs the study, prints the efficiencies and writes the JSON report if a benchmark output file is set
+   *
+   * @param particles Input particles, used if the study does not generate its own
+   * @param settings Settings of the simulation, settings.scaling must be set
+   * @return Exit code of the program
+   */
+  static int run(const std::vector<Particle> &particles, Settings &settings);
+
+  /**
+   * @brief Generates a cuboid or disc filling the whole domain with the density of the scaling settings
+   *
+   * The lattice spacing follows from the density, the domain is resized to fit the lattice. The mass, sigma and
+   * epsilon are taken from the first template particle. Bonds and force groups of the input refer to the input
+   * particles, so they are removed.
+   * @param[out] particles Vector to append the generated particles to
+   * @param settings Settings of the simulation, settings.scaling must be set. The domain is overwritten
+   * @param count Requested number of particles, the lattice contains at least as many
+   * @param templates Particles to copy the properties of the generated particles from, may be empty
+   */
+  static void generateScenario(std::vector<Particle> &particles, Settings &settings, size_t count,
+                               const std::vector<Particle> &templates);
+
+  /**
+   * @brief Calculates the efficiency of all phases compared to the first run
+   *
+   * The efficiency is the time per particle and thread of the reference divided by that of the run. For strong
+   * scaling this is \f$ \frac{T_1 p_1}{T_p p} \f$, for weak scaling with a constant number of particles per thread it
+   * reduces to \f$ \frac{T_1}{T_p} \f$.
+   * @param runs Measured runs, the first one is the reference
+   */
+  static void calculateEfficiency(std::vector<ScalingRun> &runs);
+
+ private:
+  /**
+   * @brief Writes the results as JSON
+   */
+  static void writeJSON(const std::filesystem::path &filename, const std::vector<ScalingRun> &runs,
+                        const Settings &settings);
+};
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <omp.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "Particle.h"
+
+/**
+ * @brief Type of a bond
+ *
+ * Only used to distinguish bonds, the physical parameters are stored in the bond itself
+ */
+enum class BondType : std::uint8_t { STRAIGHT, DIAGONAL };
+
+/**
+ * @struct Bond
+ * @brief Bond between two particles, referenced by their index in the particles vector
+ */
+struct Bond {
+  /** @brief Index of the first particle */
+  std::uint32_t i;
+  /** @brief Index of the second particle */
+  std::uint32_t j;
+  /** @brief Type of the bond */
+  BondType type;
+  /** @brief Length of the bond where the force vanishes */
+  double rest_length;
+};
+
+/**
+ * @class BondList
+ * Bond topology used in Assignment 5.1
+ *
+ * Stores all bonds as a flat edge list. Each bond is stored exactly once, so the force of a bond is evaluated once and
+ * applied to both particles (Newton's third law). Since particles are referenced by index, the bonds stay valid when
+ * the particles vector is reallocated.
+ */
+class BondList {
+ public:
+  /**
+   * All bonds in the simulation
+   */
+  std::vector<Bond> bonds;
+
+  /**
+   * @brief Adds a bond between particles i and j
+   * @param i index of the first particle
+   * @param j index of the second particle
+   * @param type type of the bond
+   * @param rest_length length of the bond where the force vanishes
+   */
+  void add(size_t i, size_t j, BondType type, double rest_length) {
+    bonds.push_back({static_cast<std::uint32_t>(i), static_cast<std::uint32_t>(j), type, rest_length});
+  }
+
+  /**
+   * @return number of bonds
+   */
+  [[nodiscard]] size_t size() const { return bonds.size(); }
+
+  /**
+   * @brief Applies the given function to all bonds in parallel
+   *
+   * The function is called as f(p1, p2, bond). Since a particle can be part of multiple bonds, the function has to
+   * update forces atomically (i.e. with Particle::addF and Particle::subF).
+   * @param particles particles referenced by the bonds
+   * @param f function to apply
+   */
+  template <typename Function>
+  inline void applyToBonds(std::vector<Particle> &particles, Function f) {
+#pragma omp parallel for schedule(static)
+    for (size_t b = 0; b < bonds.size(); b++) {
+      const Bond &bond = bonds[b];
+      f(particles[bond.i], particles[bond.j], bond);
+    }
+  }
+};
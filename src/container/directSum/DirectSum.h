@@ -44,4 +44,23 @@ class DirectSum {
       }
     }
   }
+
+  /**
+   * @brief Applies the given function to all ordered pairs (p, q), where p is one of the selected particles and q any
+   * other particle
+   *
+   * Parallelized over the selected particles, so the function may only modify its first argument.
+   * @param indices indices of the selected particles
+   * @param f function called as f(p, q)
+   */
+  template <typename Function>
+  inline void applyToPartners(const std::vector<size_t> &indices, Function f) {
+#pragma omp parallel for schedule(dynamic, 16)
+    for (size_t k = 0; k < indices.size(); k++) {
+      const size_t i = indices[k];
+      for (size_t j = 0; j < particles.size(); j++) {
+        if (i != j) f(particles[i], particles[j]);
+      }
+    }
+  }
 };
@@ -38,6 +38,12 @@ class Cell {
    */
   std::vector<Particle *> particles;
 
+  /**
+   * Vector that contains pointers to all static particles in the cell. Static particles never move, so they are
+   * neither moved between cells nor do they interact with each other
+   */
+  std::vector<Particle *> static_particles;
+
   /**
    * Vector that contains Ghost Particles (real Particles and not only references to particles)
    */
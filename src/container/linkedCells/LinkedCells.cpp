@@ -6,6 +6,8 @@
 
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
+
 #include "simulations/Physics.h"
 #include "utils/ArrayUtils.h"
 
@@ -71,8 +73,22 @@ LinkedCells::LinkedCells(std::vector<Particle> &particles, const Vector3 domain,
     }
   }
 
+  sortParticlesIntoCells();
+}
+
+void LinkedCells::sortParticlesIntoCells() {
+  for (auto &cell : cells) {
+    cell.particles.clear();
+    cell.static_particles.clear();
+  }
+  mobile_indices.clear();
+  has_static_particles = false;
+
   // add particles to the correct cell
-  for (auto &p : particles) {
+  for (size_t i = 0; i < particles.size(); i++) {
+    auto &p = particles[i];
+    if (!p.isStatic()) mobile_indices.push_back(i);
+
     auto [x, y, z] = p.getX();
 
     const int cellIndex = coordinate3dToIndex1d(x, y, z);
@@ -82,11 +98,89 @@ LinkedCells::LinkedCells(std::vector<Particle> &particles, const Vector3 domain,
       continue;
     }
     SPDLOG_DEBUG("Particle with coordinates: ({} {} {}) added to cell {}/{}", x, y, z, cellIndex, cells.size());
-    cells[cellIndex].particles.push_back(&p);
+    if (p.isStatic()) {
+      cells[cellIndex].static_particles.push_back(&p);
+      has_static_particles = true;
+    } else {
+      cells[cellIndex].particles.push_back(&p);
+    }
   }
   // initialize alive particles
+  alive_particles = 0;
   for (auto &p : particles)
-    if (p.getState() != -1) alive_particles++;
+    if (p.getState() == 0) alive_particles++;
+}
+
+std::vector<std::pair<std::uint32_t, std::uint32_t>> LinkedCells::getCellOrder() const {
+  std::vector<std::pair<std::uint32_t, std::uint32_t>> order;
+  order.reserve(mobile_indices.size());
+  for (size_t i = 0; i < cells.size(); i++) {
+    for (const Particle *p : cells[i].particles) {
+      order.emplace_back(i, p - particles.data());
+    }
+  }
+  return order;
+}
+
+bool LinkedCells::setCellOrder(const std::vector<std::pair<std::uint32_t, std::uint32_t>> &order) {
+  // the order has to describe exactly the particles that are currently sorted into the cells
+  size_t sorted = 0;
+  for (const auto &cell : cells) sorted += cell.particles.size();
+  bool valid = order.size() == sorted;
+  std::vector<bool> seen(particles.size(), false);
+  for (size_t i = 0; valid && i < order.size(); i++) {
+    const auto &[cell, particle] = order[i];
+    valid = cell < cells.size() && particle < particles.size() && !seen[particle] && !particles[particle].isStatic();
+    if (!valid) break;
+    seen[particle] = true;
+    const auto [x, y, z] = particles[particle].getX();
+    valid = coordinate3dToIndex1d(x, y, z) == static_cast<int>(cell);
+  }
+  if (!valid) {
+    SPDLOG_WARN("The cell order of the checkpoint does not match the particles and cells, keeping the sorted order");
+    return false;
+  }
+
+  for (auto &cell : cells) cell.particles.clear();
+  for (const auto &[cell, particle] : order) {
+    cells[cell].particles.push_back(&particles[particle]);
+  }
+  return true;
+}
+
+void LinkedCells::measureCellCosts(const bool enable) {
+  if (enable) {
+    cell_costs.assign(cells.size(), CellCost{});
+  } else {
+    cell_costs.clear();
+    cell_costs.shrink_to_fit();
+  }
+}
+
+void LinkedCells::resetCellCosts() { std::fill(cell_costs.begin(), cell_costs.end(), CellCost{}); }
+
+void LinkedCells::collectPairStatistics(const bool enable) {
+  pair_statistics.assign(enable ? omp_get_max_threads() : 0, PairStatistics{});
+  pair_statistics.shrink_to_fit();
+}
+
+PairStatistics LinkedCells::pairStatistics() const {
+  PairStatistics sum;
+  for (const auto &thread : pair_statistics) sum += thread;
+  return sum;
+}
+
+void LinkedCells::addMemoryUsage(Memory::Usage &usage) const {
+  usage[Memory::CELLS] += cells.capacity() * (sizeof(Cell) - sizeof(NeighBourIndices));
+  usage[Memory::NEIGHBOURS] += cells.capacity() * sizeof(NeighBourIndices);
+  for (const auto &cell : cells) {
+    usage[Memory::CELLS] += (cell.particles.capacity() + cell.static_particles.capacity()) * sizeof(Particle *);
+    usage[Memory::GHOSTS] += cell.ghost_particles.capacity() * sizeof(Particle);
+  }
+  usage[Memory::CELLS] += (innerCells.capacity() + borderCells.capacity() + ghostCells.capacity()) * sizeof(int);
+  usage[Memory::CELLS] += mobile_indices.capacity() * sizeof(size_t);
+  usage[Memory::DIAGNOSTICS] += cell_costs.capacity() * sizeof(CellCost);
+  usage[Memory::DIAGNOSTICS] += pair_statistics.capacity() * sizeof(PairStatistics);
 }
 
 void LinkedCells::setNeighbourCells(const int cellIndex) {
@@ -169,6 +263,7 @@ int LinkedCells::getSharedBorder(int ownIndex1d, int otherIndex1d) {
 }
 
 void LinkedCells::moveParticles() {
+  PhaseTimers::ScopedTimer timer(PhaseTimers::MOVE_PARTICLES);
   for (int i = 0; i < cells.size(); i++) {
     Cell &current_cell = cells[i];
 
@@ -235,10 +330,12 @@ void LinkedCells::moveParticles() {
       j--;
     }
   }
+  timer.stop();
   updateGhost();
 }
 
 void LinkedCells::updateGhost() {
+  PhaseTimers::ScopedTimer timer(PhaseTimers::UPDATE_GHOST);
   for (int cell_index : ghostCells) {
     auto &cell = cells[cell_index];
     cell.size_ghost_particles = 0;
@@ -249,6 +346,9 @@ void LinkedCells::updateGhost() {
       // iterate over all particles of the BORDER cell and create ghost particles for each of them
       createGhostParticles(*particle, cell_index, cell);
     }
+    for (auto particle : cell.static_particles) {
+      createGhostParticles(*particle, cell_index, cell);
+    }
   }
 }
 
@@ -5,14 +5,24 @@
 #pragma once
 
 #include <omp.h>
+#include <spdlog/spdlog.h>
 
+#include <algorithm>
 #include <array>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <utility>
 #include <vector>
 
 #include "container/directSum/ParticleContainer.h"
 #include "container/linkedCells/Cell.h"
+#include "container/linkedCells/PairStatistics.h"
 #include "simulations/Physics.h"
 #include "utils/ArrayUtils.h"
+#include "utils/MemoryUsage.h"
+#include "utils/PhaseTimers.h"
+#include "utils/Tracing.h"
 
 /**
  * @class LinkedCells
@@ -37,10 +47,30 @@ class LinkedCells {
   std::vector<Particle> &particles;
 
   /**
-   * amount of particles still alive
+   * amount of particles still alive (static particles are not counted)
    */
   int alive_particles = 0;
 
+  /**
+   * Indices of all particles that are not static
+   */
+  std::vector<size_t> mobile_indices;
+
+  /**
+   * If the container holds any static particles. Otherwise mobile_indices covers all particles
+   */
+  bool has_static_particles = false;
+
+  /**
+   * Costs of every cell in the pair traversal, indexed like cells. Empty if the costs are not measured
+   */
+  std::vector<CellCost> cell_costs;
+
+  /**
+   * Counters of the pair traversal of every thread. Empty if they are not collected
+   */
+  std::vector<PairStatistics> pair_statistics;
+
   /**
    * Domain size of the simulation
    */
@@ -119,6 +149,65 @@ Describes how many cells the overall structure has in Y-direction
   LinkedCells(std::vector<Particle> &particles, const Vector3 domain, const double cutoff, bool is2D,
               std::array<BorderType, 6> borders = {BorderType::OUTFLOW});
 
+  /**
+   * @brief (Re-)sorts all particles into their cells
+   *
+   * Static particles are stored separately in Cell::static_particles. Needs to be called again, if the static state of
+   * particles changed after the container was created.
+   */
+  void sortParticlesIntoCells();
+
+  /**
+   * @brief Order of the mobile particles inside the cells
+   *
+   * The order depends on how the particles moved between the cells and determines the order of the force summation.
+   * @return Pairs of cell index and particle index, ordered by cell and by position inside the cell
+   */
+  [[nodiscard]] std::vector<std::pair<std::uint32_t, std::uint32_t>> getCellOrder() const;
+
+  /**
+   * @brief Replaces the mobile particles of all cells, e.g. to continue a simulation from a checkpoint
+   *
+   * The order is only applied if it covers exactly the particles in the cells and every particle lies in its recorded
+   * cell. This is not the case if particles were added after the checkpoint or the domain or cutoff changed.
+   * @param order Pairs of cell index and particle index as returned by getCellOrder()
+   * @return true if the order was applied, false if it does not match and the sorted order was kept
+   */
+  bool setCellOrder(const std::vector<std::pair<std::uint32_t, std::uint32_t>> &order);
+
+  /**
+   * @brief Starts or stops measuring the costs of every cell in applyToPairs
+   * @param enable If the costs are measured. Disabling frees cell_costs
+   */
+  void measureCellCosts(bool enable = true);
+
+  /**
+   * @brief Sets the measured costs of all cells back to zero, e.g. after writing them
+   */
+  void resetCellCosts();
+
+  /**
+   * @brief Starts or stops collecting the pair statistics in applyToPairs
+   *
+   * Every thread counts into its own PairStatistics. They are sized by the number of OpenMP threads and grow at the
+   * start of applyToPairs if the number of threads was raised in the meantime.
+   * @param enable If the statistics are collected. Disabling discards them
+   */
+  void collectPairStatistics(bool enable = true);
+
+  /**
+   * @return Sum of the pair statistics of all threads
+   */
+  [[nodiscard]] PairStatistics pairStatistics() const;
+
+  /**
+   * @brief Adds the memory of the cells, ghost particles, neighbour indices, cell costs and pair statistics to usage
+   *
+   * The particles themselves are owned by the particle vector and not included.
+   * @param usage Accounting the bytes are added to
+   */
+  void addMemoryUsage(Memory::Usage &usage) const;
+
   /**
    *
    * @tparam Function
@@ -128,119 +217,457 @@ Describes how many cells the overall structure has in Y-direction
    */
   template <typename Function>
   inline void applyToPairs(Function f) {
-// Calculate forces in own cell
-#pragma omp parallel for collapse(1) schedule(dynamic, 16)
-    for (Cell &cell : cells) {
-      for (int i = 0; i < cell.particles.size(); i++) {
-        const auto p1 = cell.particles[i];
+    // the measurements are compiled into a separate traversal, so they cost nothing while they are disabled
+    if (cell_costs.empty() && pair_statistics.empty()) {
+      traversePairs<false>(f);
+    } else {
+      traversePairs<true>(f);
+    }
+  };
 
-        for (int j = i + 1; j < cell.particles.size(); j++) {
-          const auto p2 = cell.particles[j];
+  /**
+   * @brief Iterates over all particles in the simulation and applies the function f
+   * @tparam Function
+   * @param f A function modifying a particle
+   */
+  template <typename Function>
+  inline void applyToParticles(Function f) {
+#pragma omp parallel
+    {
+      PhaseTimers::ThreadTimer thread_timer;
+#pragma omp for nowait
+      for (auto &p : particles) {
+        f(p);
+      }
+    }
+  };
 
-          const Vector3 diff = p1->getX() - p2->getX();
-          const double r2 = diff[0] * diff[0] + diff[1] * diff[1] + diff[2] * diff[2];
-          if (r2 > cutoffSquared) continue;
+  /**
+   * @brief Iterates over all particles that are not static and applies the function f
+   * @tparam Function
+   * @param f A function modifying a particle
+   */
+  template <typename Function>
+  inline void applyToMobileParticles(Function f) {
+    if (!has_static_particles) {
+      applyToParticles(f);
+      return;
+    }
+#pragma omp parallel
+    {
+      PhaseTimers::ThreadTimer thread_timer;
+#pragma omp for nowait
+      for (size_t i = 0; i < mobile_indices.size(); i++) {
+        f(particles[mobile_indices[i]]);
+      }
+    }
+  };
 
-          // SPDLOG_WARN("{} <-> {}", p1->toString(), p2->toString());
-          f(*p1, *p2);
-          // SPDLOG_WARN("{} <-> {}", p1->toString(), p2->toString());
-          // SPDLOG_INFO("F: {} {} {}", f[0], f[1], f[2]);
+  /**
+   * @brief Iterates over all particles that are not static, applies the function f and sums up its return values
+   * @tparam Function
+   * @param f A function modifying a particle and returning its contribution to the sum
+   * @return Sum of the return values of f
+   */
+  template <typename Function>
+  inline double reduceMobileParticles(Function f) {
+    double sum = 0;
+    if (!has_static_particles) {
+#pragma omp parallel
+      {
+        PhaseTimers::ThreadTimer thread_timer;
+#pragma omp for reduction(+ : sum) nowait
+        for (auto &p : particles) {
+          sum += f(p);
         }
       }
+      return sum;
+    }
+#pragma omp parallel
+    {
+      PhaseTimers::ThreadTimer thread_timer;
+#pragma omp for reduction(+ : sum) nowait
+      for (size_t i = 0; i < mobile_indices.size(); i++) {
+        sum += f(particles[mobile_indices[i]]);
+      }
+    }
+    return sum;
+  };
+
+  /**
+   * @brief Moves the particles that left a cell into their new cell according to the border type of the cells
+   */
+  void moveParticles();
+
+ protected:
+  /**
+   * If applyToPairs distributes the cells with taskloops instead of worksharing loops, set by LinkedCellsV2
+   */
+  bool use_taskloops = false;
+
+  /**
+   * @brief Applies f to all pairs with worksharing loops or taskloops
+   * @tparam Measured If the cell costs and pair statistics are counted
+   * @tparam Function
+   * @param f A function modifying a pair of particles
+   */
+  template <bool Measured, typename Function>
+  inline void traversePairs(Function &f) {
+    if constexpr (Measured) countTraversal();
+    if (use_taskloops) {
+      applyToPairsWithTaskloops<Measured>(f);
+      return;
+    }
+
+    // Calculate forces in own cell
+    {
+      PhaseTimers::ScopedTimer timer(PhaseTimers::PAIRS_CELL);
+#pragma omp parallel
+      {
+        PhaseTimers::ThreadTimer thread_timer;
+        applyToPairsInCells<Measured>(f);
+      }
     }
 
     // Calculate forces with neighbour cells
+    {
+      PhaseTimers::ScopedTimer timer(PhaseTimers::PAIRS_INNER);
+#pragma omp parallel
+      {
+        PhaseTimers::ThreadTimer thread_timer;
+        applyToPairsOfInnerCells<Measured>(f);
+      }
+    }
+    {
+      PhaseTimers::ScopedTimer timer(PhaseTimers::PAIRS_BORDER);
+#pragma omp parallel
+      {
+        PhaseTimers::ThreadTimer thread_timer;
+        applyToPairsOfBorderCells<Measured>(f);
+      }
+    }
+    if (Tracing::active) Tracing::closeChunks();
+  }
 
-#pragma omp parallel for collapse(1) schedule(dynamic, 16)
-    for (const int i : innerCells) {
-      auto &c1 = cells[i];
-      NeighBourIndices neighbourCellsIndex = getNeighbourCells(i);
+  /**
+   * @brief Applies f to all pairs, distributing the cells with taskloops
+   * @tparam Measured If the cell costs and pair statistics are counted
+   * @tparam Function
+   * @param f A function modifying a pair of particles
+   */
+  template <bool Measured, typename Function>
+  inline void applyToPairsWithTaskloops(Function &f) {
+    // Calculate forces in own cell
+    {
+      PhaseTimers::ScopedTimer timer(PhaseTimers::PAIRS_CELL);
+#pragma omp parallel
+#pragma omp single
+#pragma omp taskloop
+      for (size_t c = 0; c < cells.size(); c++) {
+        Tracing::Iteration iteration(PhaseTimers::name(PhaseTimers::PAIRS_CELL), c);
+        if constexpr (Measured) countOccupancy(cells[c]);
+        applyToCell<Measured>(c, f, [this, c](auto &g, CellCost *cost) { applyToPairsInCell(cells[c], g, cost); });
+      }
+    }
 
-      for (const int j : neighbourCellsIndex) {
-        auto &c2 = cells[j];
-        if (j < i && c2.cell_type != CellType::BORDER) continue;
-        for (const auto p1 : c1.particles) {
-          for (const auto p2 : c2.particles) {
-            const Vector3 diff = p1->getX() - p2->getX();
-            const double r2 = diff[0] * diff[0] + diff[1] * diff[1] + diff[2] * diff[2];
-            if (r2 > cutoffSquared) continue;
-            f(*p1, *p2);
-            // SPDLOG_INFO("F: {} {} {}", f[0], f[1], f[2]);
-          }
+    // Calculate forces with neighbour cells
+    {
+      PhaseTimers::ScopedTimer timer(PhaseTimers::PAIRS_INNER);
+#pragma omp parallel
+#pragma omp single
+#pragma omp taskloop
+      for (size_t n = 0; n < innerCells.size(); n++) {
+        Tracing::Iteration iteration(PhaseTimers::name(PhaseTimers::PAIRS_INNER), n);
+        const int i = innerCells[n];
+        applyToCell<Measured>(i, f, [this, i](auto &g, CellCost *cost) { applyToPairsOfInnerCell(i, g, cost); });
+      }
+    }
+    {
+      PhaseTimers::ScopedTimer timer(PhaseTimers::PAIRS_BORDER);
+#pragma omp parallel
+#pragma omp single
+#pragma omp taskloop
+      for (size_t n = 0; n < borderCells.size(); n++) {
+        Tracing::Iteration iteration(PhaseTimers::name(PhaseTimers::PAIRS_BORDER), n);
+        const int i = borderCells[n];
+        applyToCell<Measured>(i, f, [this, i](auto &g, CellCost *cost) { applyToPairsOfBorderCell(i, g, cost); });
+      }
+    }
+    if (Tracing::active) Tracing::closeChunks();
+  }
+
+  /**
+   * @brief Applies f to all pairs inside the same cell
+   *
+   * Must be called inside a parallel region, the cells are distributed over its threads without a barrier at the end.
+   * @tparam Measured If the cell costs and pair statistics are counted
+   * @tparam Function
+   * @param f A function modifying a pair of particles
+   */
+  template <bool Measured, typename Function>
+  inline void applyToPairsInCells(Function &f) {
+#pragma omp for schedule(dynamic, 16) nowait
+    for (size_t c = 0; c < cells.size(); c++) {
+      Tracing::Iteration iteration(PhaseTimers::name(PhaseTimers::PAIRS_CELL), c);
+      if constexpr (Measured) countOccupancy(cells[c]);
+      applyToCell<Measured>(c, f, [this, c](auto &g, CellCost *cost) { applyToPairsInCell(cells[c], g, cost); });
+    }
+  }
+
+  /**
+   * @brief Applies f to all pairs of an inner cell and its neighbours
+   *
+   * Must be called inside a parallel region, the cells are distributed over its threads without a barrier at the end.
+   * @tparam Measured If the cell costs and pair statistics are counted
+   * @tparam Function
+   * @param f A function modifying a pair of particles
+   */
+  template <bool Measured, typename Function>
+  inline void applyToPairsOfInnerCells(Function &f) {
+#pragma omp for schedule(dynamic, 16) nowait
+    for (size_t n = 0; n < innerCells.size(); n++) {
+      Tracing::Iteration iteration(PhaseTimers::name(PhaseTimers::PAIRS_INNER), n);
+      const int i = innerCells[n];
+      applyToCell<Measured>(i, f, [this, i](auto &g, CellCost *cost) { applyToPairsOfInnerCell(i, g, cost); });
+    }
+  }
+
+  /**
+   * @brief Applies f to all pairs of a border cell and its neighbours, including the ghost particles
+   *
+   * Must be called inside a parallel region, the cells are distributed over its threads without a barrier at the end.
+   * @tparam Measured If the cell costs and pair statistics are counted
+   * @tparam Function
+   * @param f A function modifying a pair of particles
+   */
+  template <bool Measured, typename Function>
+  inline void applyToPairsOfBorderCells(Function &f) {
+#pragma omp for schedule(dynamic, 16) nowait
+    for (size_t n = 0; n < borderCells.size(); n++) {
+      Tracing::Iteration iteration(PhaseTimers::name(PhaseTimers::PAIRS_BORDER), n);
+      const int i = borderCells[n];
+      applyToCell<Measured>(i, f, [this, i](auto &g, CellCost *cost) { applyToPairsOfBorderCell(i, g, cost); });
+    }
+  }
+
+  /**
+   * @brief Traverses the pairs of one cell and adds the work to its cost and the pair statistics of the thread
+   *
+   * Every cell is handed to only one thread per loop, so its cost is updated without synchronisation.
+   * @tparam Measured If the work is counted, otherwise f is passed on unchanged
+   * @tparam Function
+   * @tparam Traverse
+   * @param index Index of the cell
+   * @param f A function modifying a pair of particles
+   * @param traverse Applies the function it is given to the pairs of the cell and counts the tests in the cost
+   */
+  template <bool Measured, typename Function, typename Traverse>
+  inline void applyToCell(const size_t index, Function &f, Traverse traverse) {
+    if constexpr (!Measured) {
+      traverse(f, nullptr);
+    } else {
+      CellCost cost;
+      auto counted = [&f, &cost](Particle &p1, Particle &p2) {
+        cost.interactions++;
+        f(p1, p2);
+      };
+      if (cell_costs.empty()) {
+        traverse(counted, &cost);
+      } else {
+        const auto begin = std::chrono::steady_clock::now();
+        traverse(counted, &cost);
+        cost.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+        cell_costs[index] += cost;
+      }
+      if (auto *statistics = threadStatistics()) *statistics += cost;
+    }
+  }
+
+  /**
+   * @return Pair statistics of the calling thread, nullptr if they are not collected
+   */
+  PairStatistics *threadStatistics() {
+    const auto thread = static_cast<size_t>(omp_get_thread_num());
+    if (thread < pair_statistics.size()) return &pair_statistics[thread];
+    if (!pair_statistics.empty()) {
+      static std::once_flag warned;
+      std::call_once(warned, [thread] {
+        SPDLOG_WARN("Thread {} has no pair statistics, its pairs are not counted", thread);
+      });
+    }
+    return nullptr;
+  }
+
+  /**
+   * @brief Adds the mobile particles of a cell to the occupancy in the pair statistics of the calling thread
+   * @param cell The cell
+   */
+  void countOccupancy(const Cell &cell) {
+    auto *statistics = threadStatistics();
+    if (statistics == nullptr || cell.cell_type == CellType::GHOST) return;
+    statistics->cells++;
+    statistics->particles += cell.particles.size();
+    if (cell.particles.empty()) statistics->empty_cells++;
+    statistics->max_occupancy = std::max<std::uint64_t>(statistics->max_occupancy, cell.particles.size());
+  }
+
+  /**
+   * @brief Counts a call of applyToPairs in the pair statistics
+   *
+   * Called before the parallel regions of the traversal, so the statistics can grow to the number of threads
+   */
+  void countTraversal() {
+    if (pair_statistics.empty()) return;
+    const auto threads = static_cast<size_t>(omp_get_max_threads());
+    if (pair_statistics.size() < threads) pair_statistics.resize(threads);
+    pair_statistics[0].traversals++;
+  }
+
+  /**
+   * @brief Applies f to all pairs inside a cell
+   * @tparam Function
+   * @param cell The cell
+   * @param f A function modifying a pair of particles
+   * @param cost Cost the distance tests are added to, nullptr if they are not counted
+   */
+  template <typename Function>
+  inline void applyToPairsInCell(Cell &cell, Function &f, CellCost *cost) {
+    if (cost) cost->pair_tests += cell.particles.size() * (cell.particles.size() - 1) / 2;
+    for (int i = 0; i < cell.particles.size(); i++) {
+      const auto p1 = cell.particles[i];
+
+      for (int j = i + 1; j < cell.particles.size(); j++) {
+        const auto p2 = cell.particles[j];
+
+        const Vector3 diff = p1->getX() - p2->getX();
+        const double r2 = diff[0] * diff[0] + diff[1] * diff[1] + diff[2] * diff[2];
+        if (r2 > cutoffSquared) continue;
+
+        f(*p1, *p2);
+      }
+    }
+    applyToPairsBetween(cell.particles, cell.static_particles, f, cost);
+  }
+
+  /**
+   * @brief Applies f to all pairs of an inner cell and its neighbours
+   * @tparam Function
+   * @param i Index of the inner cell
+   * @param f A function modifying a pair of particles
+   * @param cost Cost the distance tests are added to, nullptr if they are not counted
+   */
+  template <typename Function>
+  inline void applyToPairsOfInnerCell(const int i, Function &f, CellCost *cost) {
+    auto &c1 = cells[i];
+    NeighBourIndices neighbourCellsIndex = getNeighbourCells(i);
+
+    for (const int j : neighbourCellsIndex) {
+      auto &c2 = cells[j];
+      if (j < i && c2.cell_type != CellType::BORDER) continue;
+      if (cost) cost->pair_tests += c1.particles.size() * c2.particles.size();
+      for (const auto p1 : c1.particles) {
+        for (const auto p2 : c2.particles) {
+          const Vector3 diff = p1->getX() - p2->getX();
+          const double r2 = diff[0] * diff[0] + diff[1] * diff[1] + diff[2] * diff[2];
+          if (r2 > cutoffSquared) continue;
+          f(*p1, *p2);
+          // SPDLOG_INFO("F: {} {} {}", f[0], f[1], f[2]);
         }
       }
+      applyToPairsBetween(c1.particles, c2.static_particles, f, cost);
+      applyToPairsBetween(c1.static_particles, c2.particles, f, cost);
     }
-#pragma omp parallel for collapse(1) schedule(dynamic, 16)
-    for (const int i : borderCells) {
-      auto &c1 = cells[i];
-      NeighBourIndices neighbourCellsIndex = getNeighbourCells(i);
-      for (const int j : neighbourCellsIndex) {
-        auto &c2 = cells[j];
-        if (j < i && c2.cell_type != CellType::GHOST) continue;
-        if (c2.cell_type == CellType::GHOST) {
-          auto borderType = getSharedBorderType(i, j);
-          if (borderType == BorderType::PERIODIC) {
-            for (const auto p1 : c1.particles) {
-              for (int k = 0; k < c2.size_ghost_particles; k++) {
-                Particle &p2 = c2.ghost_particles[k];
-                const Vector3 diff = p1->getX() - p2.getX();
-                const double r2 = diff[0] * diff[0] + diff[1] * diff[1] + diff[2] * diff[2];
-                if (r2 > cutoffSquared) continue;
-                f(*p1, p2);
-              }
-            }
-          } else {
-            for (const auto p1 : c1.particles) {
-              for (int k = 0; k < c2.size_ghost_particles; k++) {
-                Particle &p2 = c2.ghost_particles[k];
-                const Vector3 diff = p1->getX() - p2.getX();
-                const double r2 = diff[0] * diff[0] + diff[1] * diff[1] + diff[2] * diff[2];
-                // for ghost particles the force should only be computed if its repulsing
-                // normally cutoffRadius >> repulsing_distance but i'm letting it stand since it's an or statement
-                SPDLOG_TRACE("reached radius check for ghost particles");
-                const double repusling_distance = calcRepulsingDistance(p1->getSigma(), p2.getSigma());
-                if (r2 >= repusling_distance * repusling_distance || r2 > cutoffSquared) continue;
-
-                f(*p1, p2);
-              }
+  }
+
+  /**
+   * @brief Applies f to all pairs of a border cell and its neighbours, including the ghost particles
+   * @tparam Function
+   * @param i Index of the border cell
+   * @param f A function modifying a pair of particles
+   * @param cost Cost the distance tests are added to, nullptr if they are not counted
+   */
+  template <typename Function>
+  inline void applyToPairsOfBorderCell(const int i, Function &f, CellCost *cost) {
+    auto &c1 = cells[i];
+    NeighBourIndices neighbourCellsIndex = getNeighbourCells(i);
+    for (const int j : neighbourCellsIndex) {
+      auto &c2 = cells[j];
+      if (j < i && c2.cell_type != CellType::GHOST) continue;
+      if (c2.cell_type == CellType::GHOST) {
+        const std::uint64_t interactions_before = cost ? cost->interactions : 0;
+        if (cost) {
+          cost->pair_tests += c1.particles.size() * c2.size_ghost_particles;
+          cost->ghost_pair_tests += c1.particles.size() * c2.size_ghost_particles;
+        }
+        auto borderType = getSharedBorderType(i, j);
+        if (borderType == BorderType::PERIODIC) {
+          for (const auto p1 : c1.particles) {
+            for (int k = 0; k < c2.size_ghost_particles; k++) {
+              Particle &p2 = c2.ghost_particles[k];
+              const Vector3 diff = p1->getX() - p2.getX();
+              const double r2 = diff[0] * diff[0] + diff[1] * diff[1] + diff[2] * diff[2];
+              if (r2 > cutoffSquared) continue;
+              f(*p1, p2);
             }
           }
         } else {
-          // case for regular cells
           for (const auto p1 : c1.particles) {
-            for (const auto p2 : c2.particles) {
-              const Vector3 diff = p1->getX() - p2->getX();
+            for (int k = 0; k < c2.size_ghost_particles; k++) {
+              Particle &p2 = c2.ghost_particles[k];
+              const Vector3 diff = p1->getX() - p2.getX();
               const double r2 = diff[0] * diff[0] + diff[1] * diff[1] + diff[2] * diff[2];
-              if (r2 > cutoffSquared) continue;
-              f(*p1, *p2);
-              // SPDLOG_INFO("F: {} {} {}", f[0], f[1], f[2]);
+              // for ghost particles the force should only be computed if its repulsing
+              // normally cutoffRadius >> repulsing_distance but i'm letting it stand since it's an or statement
+              SPDLOG_TRACE("reached radius check for ghost particles");
+              const double repusling_distance = calcRepulsingDistance(p1->getSigma(), p2.getSigma());
+              if (r2 >= repusling_distance * repusling_distance || r2 > cutoffSquared) continue;
+
+              f(*p1, p2);
             }
           }
         }
+        // the function passed in counts the interactions, the ghost interactions are the ones of this neighbour
+        if (cost) cost->ghost_interactions += cost->interactions - interactions_before;
+      } else {
+        // case for regular cells
+        if (cost) cost->pair_tests += c1.particles.size() * c2.particles.size();
+        for (const auto p1 : c1.particles) {
+          for (const auto p2 : c2.particles) {
+            const Vector3 diff = p1->getX() - p2->getX();
+            const double r2 = diff[0] * diff[0] + diff[1] * diff[1] + diff[2] * diff[2];
+            if (r2 > cutoffSquared) continue;
+            f(*p1, *p2);
+            // SPDLOG_INFO("F: {} {} {}", f[0], f[1], f[2]);
+          }
+        }
+        applyToPairsBetween(c1.particles, c2.static_particles, f, cost);
+        applyToPairsBetween(c1.static_particles, c2.particles, f, cost);
       }
     }
-  };
+  }
 
   /**
-   * @brief Iterates over all particles in the simulation and applies the function f
+   * @brief Applies f to all pairs (p1, p2) with p1 from the first and p2 from the second list within the cutoff radius
    * @tparam Function
-   * @param f A function modifying a particle
+   * @param first particles of the first cell
+   * @param second particles of the second cell
+   * @param f A function modifying a pair of particles
+   * @param cost Cost the distance tests are added to, nullptr if they are not counted
    */
   template <typename Function>
-  inline void applyToParticles(Function f) {
-    // double sum;
-#pragma omp parallel for  // reduce(sum)
-    for (auto &p : particles) {
-      f(p);
+  inline void applyToPairsBetween(const std::vector<Particle *> &first, const std::vector<Particle *> &second,
+                                  Function &f, CellCost *cost = nullptr) {
+    if (cost) cost->pair_tests += first.size() * second.size();
+    for (const auto p1 : first) {
+      for (const auto p2 : second) {
+        const Vector3 diff = p1->getX() - p2->getX();
+        const double r2 = diff[0] * diff[0] + diff[1] * diff[1] + diff[2] * diff[2];
+        if (r2 > cutoffSquared) continue;
+        f(*p1, *p2);
+      }
     }
-  };
-
-  /**
-   * @brief Moves the particles that left a cell into their new cell according to the border type of the cells
-   */
-  void moveParticles();
+  }
 
- protected:
   /**
    * Finds the neighbour-cells of the given cell and returns their cell-array indexes
    * @param cellIndex 1D cell index of the current cell
@@ -0,0 +1,56 @@
+#include "container/linkedCells/PairStatistics.h"
+
+#include <spdlog/fmt/fmt.h>
+
+#include <algorithm>
+
+CellCost &CellCost::operator+=(const CellCost &other) {
+  pair_tests += other.pair_tests;
+  interactions += other.interactions;
+  ghost_pair_tests += other.ghost_pair_tests;
+  ghost_interactions += other.ghost_interactions;
+  seconds += other.seconds;
+  return *this;
+}
+
+PairStatistics &PairStatistics::operator+=(const PairStatistics &other) {
+  traversals += other.traversals;
+  pair_tests += other.pair_tests;
+  interactions += other.interactions;
+  ghost_pair_tests += other.ghost_pair_tests;
+  ghost_interactions += other.ghost_interactions;
+  cells += other.cells;
+  empty_cells += other.empty_cells;
+  particles += other.particles;
+  max_occupancy = std::max(max_occupancy, other.max_occupancy);
+  return *this;
+}
+
+PairStatistics &PairStatistics::operator+=(const CellCost &cost) {
+  pair_tests += cost.pair_tests;
+  interactions += cost.interactions;
+  ghost_pair_tests += cost.ghost_pair_tests;
+  ghost_interactions += cost.ghost_interactions;
+  return *this;
+}
+
+std::string PairStatistics::format() const {
+  const auto ratio = [](const double part, const double whole) { return whole > 0 ? part / whole : 0.0; };
+  const double per_traversal = std::max<std::uint64_t>(traversals, 1);
+
+  std::string result = fmt::format("{:<22}{:>16}{:>18}\n", "", "total", "per traversal");
+  const auto row = [&](const char *name, const std::uint64_t value) {
+    result += fmt::format("{:<22}{:>16}{:>18.1f}\n", name, value, static_cast<double>(value) / per_traversal);
+  };
+  row("distance tests", pair_tests);
+  row("interactions", interactions);
+  row("ghost distance tests", ghost_pair_tests);
+  row("ghost interactions", ghost_interactions);
+  result += fmt::format("{:<22}{:>16}\n", "traversals", traversals);
+  result += fmt::format("{:<22}{:>15.1f}%\n", "tests in cutoff", ratio(interactions, pair_tests) * 100);
+  result += fmt::format("{:<22}{:>16.2f}\n", "tests per interaction", ratio(pair_tests, interactions));
+  result += fmt::format("{:<22}{:>16.2f}\n", "average occupancy", ratio(particles, cells));
+  result += fmt::format("{:<22}{:>16}\n", "max occupancy", max_occupancy);
+  result += fmt::format("{:<22}{:>15.1f}%\n", "empty cells", ratio(empty_cells, cells) * 100);
+  return result;
+}
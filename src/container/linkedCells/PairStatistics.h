@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+/**
+ * @struct CellCost
+ * @brief Work of the pair traversal attributed to one cell, summed up since the last reset
+ *
+ * The pairs of a cell with its neighbours are attributed to the cell the traversal loop handed to the thread.
+ */
+struct CellCost {
+  /** @brief Distance tests of particle pairs */
+  std::uint64_t pair_tests = 0;
+  /** @brief Pairs within the cutoff radius the function was applied to */
+  std::uint64_t interactions = 0;
+  /** @brief Distance tests with ghost particles, included in pair_tests */
+  std::uint64_t ghost_pair_tests = 0;
+  /** @brief Interactions with ghost particles, included in interactions */
+  std::uint64_t ghost_interactions = 0;
+  /** @brief Wall time of the traversal of the cell */
+  double seconds = 0;
+
+  /**
+   * @brief Adds the work of other
+   */
+  CellCost &operator+=(const CellCost &other);
+};
+
+/**
+ * @struct PairStatistics
+ * @brief Counters of the pair traversal of the linked cells, summed up over all traversals
+ *
+ * Every thread counts into its own instance, which is aligned to a cache line so the threads never share one. The
+ * instances are only added up when the statistics are read.
+ */
+struct alignas(64) PairStatistics {
+  /** @brief Number of calls of applyToPairs */
+  std::uint64_t traversals = 0;
+  /** @brief Distance tests of particle pairs */
+  std::uint64_t pair_tests = 0;
+  /** @brief Pairs within the cutoff radius */
+  std::uint64_t interactions = 0;
+  /** @brief Distance tests with ghost particles, included in pair_tests */
+  std::uint64_t ghost_pair_tests = 0;
+  /** @brief Interactions with ghost particles, included in interactions */
+  std::uint64_t ghost_interactions = 0;
+  /** @brief Visited cells that are not ghost cells */
+  std::uint64_t cells = 0;
+  /** @brief Visited cells without mobile particles */
+  std::uint64_t empty_cells = 0;
+  /** @brief Mobile particles in the visited cells */
+  std::uint64_t particles = 0;
+  /** @brief Largest number of mobile particles in one cell */
+  std::uint64_t max_occupancy = 0;
+
+  /**
+   * @brief Adds the counters of another thread
+   */
+  PairStatistics &operator+=(const PairStatistics &other);
+
+  /**
+   * @brief Adds the work done for one cell
+   */
+  PairStatistics &operator+=(const CellCost &cost);
+
+  /**
+   * @return Summary with the share of tests that found an interaction and the average occupancy of the cells
+   */
+  [[nodiscard]] std::string format() const;
+};
@@ -0,0 +1,97 @@
+#include "inputReader/CheckpointReader.h"
+
+#include <spdlog/spdlog.h>
+#include <yaml-cpp/yaml.h>
+
+#include <cstring>
+#include <string>
+#include <utility>
+
+#include "inputReader/MappedFile.h"
+#include "inputReader/YAMLReader.h"
+#include "outputWriter/CheckpointFormat.h"
+
+std::uint64_t CheckpointReader::readFile(std::vector<Particle> &particles, const std::filesystem::path &filepath,
+                                         Settings &settings) {
+  const MappedFile file(filepath);
+  const char *data = file.view().data();
+  const size_t size = file.view().size();
+  if (size < sizeof(checkpoint::Header)) {
+    SPDLOG_ERROR("{} is not a checkpoint", filepath.string());
+    exit(-1);
+  }
+
+  checkpoint::Header header{};
+  std::memcpy(&header, data, sizeof(header));
+  const size_t expected_size = sizeof(header) + header.settings_size +
+                               header.particle_count * sizeof(checkpoint::ParticleRecord) +
+                               header.bond_count * sizeof(checkpoint::BondRecord) +
+                               header.cell_entry_count * sizeof(checkpoint::CellRecord);
+  if (header.magic != checkpoint::MAGIC || header.version != checkpoint::VERSION ||
+      header.byte_order != checkpoint::BYTE_ORDER_MARK || expected_size != size) {
+    SPDLOG_ERROR("{} is not a complete checkpoint of version {} with native byte order", filepath.string(),
+                 checkpoint::VERSION);
+    exit(-1);
+  }
+
+  const char *yaml = data + sizeof(header);
+  const char *particle_data = yaml + header.settings_size;
+  const char *bond_data = particle_data + header.particle_count * sizeof(checkpoint::ParticleRecord);
+  const char *cell_data = bond_data + header.bond_count * sizeof(checkpoint::BondRecord);
+
+  const size_t first_particle = particles.size();
+  particles.resize(first_particle + header.particle_count);
+#pragma omp parallel for schedule(static)
+  for (size_t i = 0; i < header.particle_count; i++) {
+    checkpoint::ParticleRecord record;
+    std::memcpy(&record, particle_data + i * sizeof(record), sizeof(record));
+    Particle p(record.x, record.v, record.m, record.epsilon, record.sigma, record.f, record.old_f, record.type);
+    p.setState(record.state);
+    particles[first_particle + i] = p;
+  }
+
+  for (size_t b = 0; b < header.bond_count; b++) {
+    checkpoint::BondRecord record;
+    std::memcpy(&record, bond_data + b * sizeof(record), sizeof(record));
+    settings.membrane.bonds.add(first_particle + record.i, first_particle + record.j,
+                                static_cast<BondType>(record.type), record.rest_length);
+  }
+
+  Settings::Restart restart{header.iteration, header.delta_t, {}};
+  // the cell order only describes the linked cells if there are no other particles
+  if (first_particle == 0) {
+    restart.cell_order.resize(header.cell_entry_count);
+#pragma omp parallel for schedule(static)
+    for (size_t i = 0; i < header.cell_entry_count; i++) {
+      checkpoint::CellRecord record;
+      std::memcpy(&record, cell_data + i * sizeof(record), sizeof(record));
+      restart.cell_order[i] = {record.cell, record.particle};
+    }
+  }
+  settings.restart = std::move(restart);
+
+  const YAML::Node config = YAML::Load(std::string(yaml, header.settings_size));
+
+  if (config["output"]) settings.output = config["output"].as<Settings::Output>();
+  if (config["simulation"]) settings.simulation = config["simulation"].as<Settings::Simulation>();
+  if (config["useAlternateParallelisation"])
+    settings.useAlternateParallelisation = config["useAlternateParallelisation"].as<bool>();
+  if (auto membrane = config["membrane"]) {
+    if (membrane["r0"]) settings.membrane.r0 = membrane["r0"].as<double>();
+    if (membrane["k"]) settings.membrane.k = membrane["k"].as<double>();
+    if (membrane["sigma"]) settings.membrane.sigma = membrane["sigma"].as<double>();
+  }
+  // force groups are stored with their resolved indices
+  for (const auto &node : config["force_groups"]) {
+    ForceGroup group = node.as<ForceGroup>();
+    if (group.selector.indices) {
+      for (auto &i : group.selector.indices.value()) i += first_particle;
+    }
+    group.resolve(particles, {});
+    settings.force_groups.push_back(group);
+  }
+
+  SPDLOG_INFO("Restored {} particles and {} bonds at t={} (iteration {})", header.particle_count, header.bond_count,
+              header.time, header.iteration);
+  return header.iteration;
+}
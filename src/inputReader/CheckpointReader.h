@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+#include "Particle.h"
+#include "Settings.h"
+
+/**
+ * @class CheckpointReader
+ * @brief Restores a simulation from a binary checkpoint
+ *
+ * The checkpoint is memory-mapped and the particles are restored in parallel directly from the mapped records.
+ *
+ * @see outputWriter::writeCheckpoint
+ */
+class CheckpointReader {
+ public:
+  /**
+   * @brief Appends the particles of a checkpoint to `particles` and restores the settings
+   *
+   * Membrane bonds and force groups of the checkpoint are shifted to the position of the restored particles. The
+   * iteration, timestep and order of the particles in the linked cells are stored in Settings::restart.
+   * Exits with `-1` if the file can not be opened or is not a checkpoint.
+   *
+   * @param particles Where to store the restored particles
+   * @param filepath Path to the checkpoint
+   * @param settings Where to store settings
+   * @return Iteration the checkpoint was taken after
+   */
+  static std::uint64_t readFile(std::vector<Particle> &particles, const std::filesystem::path &filepath,
+                                Settings &settings);
+};
@@ -2,38 +2,62 @@
 
 #include <array>
 #include <cstdlib>
-#include <iostream>
-#include <sstream>
 #include <vector>
 
 #include "utils/ParticleGenerator.h"
 
-void CuboidReader::parse(std::vector<Particle> &particles, std::istream &file) {
+namespace {
+/**
+ * @brief Instructions for one cuboid
+ */
+struct CuboidLine {
   Vector3 x;
   std::array<unsigned int, 3> n;
-  Vector3 v;
   double distance;
   double mass;
-  double epsilon;
-  double sigma;
-
-  std::string current_line;
-
-  while (std::getline(file, current_line)) {
-    if (current_line.empty() || current_line[0] == '#') continue;
-
-    std::istringstream data(current_line);
-
-    for (auto &xₖ : x) data >> xₖ;
-    for (auto &nₖ : n) data >> nₖ;
-
-    data >> distance;
-    data >> mass;
-    data >> epsilon;
-    data >> sigma;
+  std::optional<double> epsilon;
+  std::optional<double> sigma;
+  Vector3 v;
+};
+}  // namespace
+
+void CuboidReader::parse(std::vector<Particle> &particles, std::string_view data) {
+  const char *end = data.data() + data.size();
+  std::vector<CuboidLine> cuboids;
+
+  for (const char *line = data.data(); line < end; line = nextLine(line, end)) {
+    if (isBlankOrComment(line, end)) continue;
+
+    CuboidLine c{};
+    const char *pos = line;
+    bool complete = true;
+    for (auto &xₖ : c.x) complete = complete && nextValue(pos, end, xₖ);
+    for (auto &nₖ : c.n) complete = complete && nextValue(pos, end, nₖ);
+    complete = complete && nextValue(pos, end, c.distance) && nextValue(pos, end, c.mass);
+
+    // epsilon and sigma are optional and stand before the velocity
+    std::array<double, 5> rest{};
+    size_t values = 0;
+    while (values < rest.size() && nextValue(pos, end, rest[values])) values++;
+    if (values == 5) {
+      c.epsilon = rest[0];
+      c.sigma = rest[1];
+    }
+    if (!complete || (values != 3 && values != 5)) {
+      SPDLOG_ERROR("Error reading file: incomplete cuboid in line \"{}\"",
+                   std::string_view(line, nextLine(line, end) - line));
+      exit(-1);
+    }
+    for (size_t k = 0; k < 3; k++) c.v[k] = rest[values - 3 + k];
+    cuboids.push_back(c);
+  }
 
-    for (auto &vₖ : v) data >> vₖ;
+  // reserve the memory for all cuboids at once
+  size_t count = particles.size();
+  for (const auto &c : cuboids) count += static_cast<size_t>(c.n[0]) * c.n[1] * c.n[2];
+  particles.reserve(count);
 
-    ParticleGenerator::cuboid(particles, x, n, distance, mass, epsilon, sigma, v);
+  for (const auto &c : cuboids) {
+    ParticleGenerator::cuboid(particles, c.x, c.n, c.distance, c.mass, c.epsilon, c.sigma, c.v);
   }
 }
@@ -1,6 +1,6 @@
 #pragma once
 
-#include <fstream>
+#include <string_view>
 #include <vector>
 
 #include "inputReader/FileReader.h"
@@ -16,16 +16,19 @@
  * # xyz-coord     n.o.particles   distance    mass    velocity
  * 0.0 0.0 0.0     0.0 0.0 0.0     0.0         0.0     0.0 0.0 0.0
  * ```
+ * Optionally, epsilon and sigma can be given between the mass and the velocity.
  *
  * @see FileReader
  */
 class CuboidReader : public FileReader<CuboidReader> {
  public:
+  using FileReader<CuboidReader>::parse;
+
   /**
-   * @brief Parses a stream of the `file` in cuboid format into `particles`
+   * @brief Parses the contents of a file in cuboid format into `particles`
    *
    * @param particles Where to store the read particles
-   * @param file Filestream to read from
+   * @param data Contents of the file
    */
-  static void parse(std::vector<Particle> &particles, std::istream &file);
+  static void parse(std::vector<Particle> &particles, std::string_view data);
 };
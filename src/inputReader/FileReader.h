@@ -2,12 +2,17 @@
 
 #include <spdlog/spdlog.h>
 
+#include <charconv>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <iterator>
+#include <string>
+#include <string_view>
 #include <vector>
 
 #include "Particle.h"
+#include "inputReader/MappedFile.h"
 
 /**
  * @class FileReader
@@ -17,8 +22,10 @@
  * from this one needs to implement a static method `parse` that handles reading the file.
  * This should (?) allow for static polymorphism, evaluated at compile time
  *
+ * Files are memory-mapped and parsed in place, the helpers of this class parse numbers with std::from_chars.
+ *
  * @tparam T Derived class for CRTP pattern.
- * @note T must implement `static void parse(std::vector<Particle>&, std::ifstream&)`.
+ * @note T must implement `static void parse(std::vector<Particle>&, std::string_view)`.
  *
  * @see https://en.wikipedia.org/wiki/Curiously_recurring_template_pattern
  */
@@ -28,7 +35,7 @@ class FileReader {
   /**
    * @brief Fills a vector with particles based on instructions in an input file
    *
-   * Checks the file for existence before delegating the actual parsing to the derived Type.
+   * Maps the file into memory before delegating the actual parsing to the derived Type.
    * Exits with `-1` if the file can not be opened.
    *
    * @param particles Vector to fill with particles
@@ -36,12 +43,51 @@ class FileReader {
    *
    */
   static void readFile(std::vector<Particle> &particles, const std::filesystem::path filepath) {
-    std::ifstream file(filepath);
-    if (!file.is_open()) {
-      SPDLOG_ERROR("Error opening {}", filepath.string());
-      exit(-1);
-    }
+    const MappedFile file(filepath);
+    T::parse(particles, file.view());
+  }
+
+  /**
+   * @brief Parses the contents of a stream, e.g. for input that is not stored in a file
+   *
+   * @param particles Vector to fill with particles
+   * @param file Stream to read from
+   */
+  static void parse(std::vector<Particle> &particles, std::istream &file) {
+    const std::string data{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+    T::parse(particles, std::string_view(data));
+  }
+
+ protected:
+  /**
+   * @return Start of the line after the one containing pos, or end
+   */
+  static const char *nextLine(const char *pos, const char *end) {
+    while (pos < end && *pos != '\n') pos++;
+    return pos < end ? pos + 1 : end;
+  }
 
-    T::parse(particles, file);
+  /**
+   * @return true if the line starting at pos is empty or a comment
+   */
+  static bool isBlankOrComment(const char *pos, const char *end) {
+    while (pos < end && (*pos == ' ' || *pos == '\t' || *pos == '\r')) pos++;
+    return pos == end || *pos == '\n' || *pos == '#';
+  }
+
+  /**
+   * @brief Parses the next number of the current line and advances pos behind it
+   * @tparam V Type of the number
+   * @return false if the line has no further number
+   */
+  template <typename V>
+  static bool nextValue(const char *&pos, const char *end, V &value) {
+    while (pos < end && (*pos == ' ' || *pos == '\t' || *pos == '\r')) pos++;
+    // from_chars does not accept an explicit plus sign
+    if (pos < end && *pos == '+') pos++;
+    const auto [ptr, error] = std::from_chars(pos, end, value);
+    if (error != std::errc()) return false;
+    pos = ptr;
+    return true;
   }
 };
@@ -0,0 +1,36 @@
+#include "inputReader/MappedFile.h"
+
+#include <fcntl.h>
+#include <spdlog/spdlog.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+MappedFile::MappedFile(const std::filesystem::path &filepath, Access access) {
+  const int fd = open(filepath.c_str(), O_RDONLY);
+  struct stat status {};
+  if (fd < 0 || fstat(fd, &status) != 0) {
+    SPDLOG_ERROR("Error opening {}", filepath.string());
+    exit(-1);
+  }
+  size = static_cast<size_t>(status.st_size);
+  // mmap does not accept empty mappings
+  if (size == 0) {
+    close(fd);
+    return;
+  }
+
+  void *mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  // the mapping stays valid after closing the file descriptor
+  close(fd);
+  if (mapping == MAP_FAILED) {
+    SPDLOG_ERROR("Error mapping {}", filepath.string());
+    exit(-1);
+  }
+  data = static_cast<const char *>(mapping);
+  madvise(mapping, size, access == Access::SEQUENTIAL ? MADV_SEQUENTIAL : MADV_RANDOM);
+}
+
+MappedFile::~MappedFile() {
+  if (data) munmap(const_cast<char *>(data), size);
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <filesystem>
+#include <string_view>
+
+/**
+ * @class MappedFile
+ * @brief Read-only memory mapping of a complete file
+ *
+ * The pages are only read from disk when they are accessed, so parsers can work on the file contents without copying
+ * them into a stream buffer first.
+ */
+class MappedFile {
+ public:
+  /**
+   * @brief Expected access pattern, passed to the kernel to tune the read-ahead
+   */
+  enum class Access {
+    /** @brief The file is read front to back, e.g. by a parser */
+    SEQUENTIAL,
+    /** @brief Only parts of the file are read, e.g. single frames of a trajectory */
+    RANDOM
+  };
+
+  /**
+   * @brief Maps the file into memory
+   *
+   * Exits with `-1` if the file can not be opened.
+   * @param filepath Path of the file
+   * @param access Expected access pattern
+   */
+  explicit MappedFile(const std::filesystem::path &filepath, Access access = Access::SEQUENTIAL);
+
+  /**
+   * @brief Unmaps the file
+   */
+  ~MappedFile();
+
+  // The mapping is owned by this object
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+
+  /**
+   * @return Contents of the file
+   */
+  [[nodiscard]] std::string_view view() const { return {data, size}; }
+
+ private:
+  /** @brief Start of the mapped file, nullptr for empty files */
+  const char *data = nullptr;
+  /** @brief Size of the file */
+  size_t size = 0;
+};
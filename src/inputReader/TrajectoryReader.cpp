@@ -0,0 +1,102 @@
+#include "inputReader/TrajectoryReader.h"
+
+#include <spdlog/spdlog.h>
+
+#include <cstring>
+
+namespace {
+/**
+ * @brief Reads a value from a possibly unaligned position
+ */
+template <typename T>
+T get(const char *in) {
+  T value;
+  std::memcpy(&value, in, sizeof(T));
+  return value;
+}
+}  // namespace
+
+TrajectoryReader::TrajectoryReader(const std::filesystem::path &filename)
+    : file(filename, MappedFile::Access::RANDOM) {
+  const char *data = file.view().data();
+  const size_t size = file.view().size();
+  if (size < sizeof(trajectory::FileHeader)) {
+    SPDLOG_ERROR("{} is not a trajectory file", filename.string());
+    exit(-1);
+  }
+
+  header = get<trajectory::FileHeader>(data);
+  if (header.magic != trajectory::MAGIC || header.version != trajectory::VERSION ||
+      header.byte_order != trajectory::BYTE_ORDER_MARK) {
+    SPDLOG_ERROR("{} is not a trajectory file of version {} with native byte order", filename.string(),
+                 trajectory::VERSION);
+    exit(-1);
+  }
+
+  if (header.index_offset != 0 &&
+      header.index_offset + header.frame_count * sizeof(trajectory::IndexEntry) <= size) {
+    index.resize(header.frame_count);
+    std::memcpy(index.data(), data + header.index_offset, index.size() * sizeof(trajectory::IndexEntry));
+    return;
+  }
+
+  // the writer did not finish, recover all complete frames by following the frame headers
+  SPDLOG_WARN("{} has no frame index, scanning frames", filename.string());
+  size_t offset = sizeof(trajectory::FileHeader);
+  while (offset + sizeof(trajectory::FrameHeader) <= size) {
+    const auto frame = get<trajectory::FrameHeader>(data + offset);
+    const size_t end = offset + sizeof(frame) + trajectory::frameDataSize(header.flags, frame.particle_count);
+    if (end > size) break;
+    index.push_back({offset, frame.iteration, frame.time});
+    offset = end;
+  }
+}
+
+trajectory::FrameHeader TrajectoryReader::frameHeader(size_t frame) const {
+  return get<trajectory::FrameHeader>(file.view().data() + index.at(frame).offset);
+}
+
+template <typename T>
+void TrajectoryReader::decodeFrame(size_t frame, TrajectoryFrame &result) const {
+  const trajectory::FrameHeader frame_header = frameHeader(frame);
+  const size_t n = frame_header.particle_count;
+  const char *positions = file.view().data() + index[frame].offset + sizeof(trajectory::FrameHeader);
+  const char *velocities = positions + 3 * n * sizeof(T);
+  const char *types = velocities + 3 * n * sizeof(T);
+
+  result.iteration = frame_header.iteration;
+  result.time = frame_header.time;
+  result.positions.resize(n, {0, 0, 0});
+  result.velocities.resize(n);
+  result.types.resize(n);
+
+  for (size_t i = 0; i < n; i++) {
+    for (int d = 0; d < 3; d++) {
+      const auto x = static_cast<double>(get<T>(positions + (3 * i + d) * sizeof(T)));
+      result.positions[i][d] = frame_header.keyframe ? x : result.positions[i][d] + x;
+      result.velocities[i][d] = static_cast<double>(get<T>(velocities + (3 * i + d) * sizeof(T)));
+    }
+    result.types[i] = get<std::int32_t>(types + i * sizeof(std::int32_t));
+  }
+}
+
+TrajectoryFrame TrajectoryReader::readFrame(size_t frame) const {
+  if (frame >= index.size()) {
+    SPDLOG_ERROR("Frame {} out of range, trajectory has {} frames", frame, index.size());
+    exit(-1);
+  }
+
+  // delta encoded frames need the positions of all frames since the last keyframe
+  size_t first = frame;
+  while (first > 0 && !frameHeader(first).keyframe) first--;
+
+  TrajectoryFrame result;
+  for (size_t f = first; f <= frame; f++) {
+    if (header.flags & trajectory::SINGLE_PRECISION) {
+      decodeFrame<float>(f, result);
+    } else {
+      decodeFrame<double>(f, result);
+    }
+  }
+  return result;
+}
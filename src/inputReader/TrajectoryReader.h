@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+#include "Particle.h"
+#include "inputReader/MappedFile.h"
+#include "outputWriter/TrajectoryFormat.h"
+
+/**
+ * @struct TrajectoryFrame
+ * @brief Decoded frame of a trajectory
+ */
+struct TrajectoryFrame {
+  /** @brief Iteration of the frame */
+  std::uint64_t iteration = 0;
+  /** @brief Simulation time of the frame */
+  double time = 0;
+  /** @brief Position of every particle */
+  std::vector<Vector3> positions;
+  /** @brief Velocity of every particle */
+  std::vector<Vector3> velocities;
+  /** @brief Type of every particle */
+  std::vector<int> types;
+};
+
+/**
+ * @class TrajectoryReader
+ * @brief Random access to the frames of a binary trajectory file
+ *
+ * The file is memory-mapped, so opening a trajectory only reads the frame index and a frame is only decoded when it is
+ * requested. Frames of delta encoded trajectories are decoded starting from the closest keyframe. If the file was not
+ * closed properly (e.g. the simulation crashed), the index is rebuilt by walking over the frame headers.
+ *
+ * @see outputWriter::TrajectoryWriter
+ */
+class TrajectoryReader {
+ public:
+  /**
+   * @brief Maps the file into memory and reads the frame index
+   *
+   * Exits with `-1` if the file can not be opened or is not a trajectory.
+   * @param filename Path to the trajectory file
+   */
+  explicit TrajectoryReader(const std::filesystem::path &filename);
+
+  /**
+   * @return Number of frames in the trajectory
+   */
+  [[nodiscard]] size_t frameCount() const { return index.size(); }
+
+  /**
+   * @param frame number of the frame
+   * @return Offset, iteration and time of the frame
+   */
+  [[nodiscard]] const trajectory::IndexEntry &entry(size_t frame) const { return index.at(frame); }
+
+  /**
+   * @return Header of the file
+   */
+  [[nodiscard]] const trajectory::FileHeader &getHeader() const { return header; }
+
+  /**
+   * @brief Decodes a frame
+   * @param frame number of the frame
+   * @return positions, velocities and types of all particles in the frame
+   */
+  [[nodiscard]] TrajectoryFrame readFrame(size_t frame) const;
+
+ private:
+  /** @brief Mapping of the trajectory file */
+  MappedFile file;
+  /** @brief Copy of the file header */
+  trajectory::FileHeader header{};
+  /** @brief Offset and metadata of all frames */
+  std::vector<trajectory::IndexEntry> index;
+
+  /**
+   * @param frame number of the frame
+   * @return Header of the frame
+   */
+  [[nodiscard]] trajectory::FrameHeader frameHeader(size_t frame) const;
+
+  /**
+   * @brief Decodes a single frame into result, adding its positions to the previous ones if it is not a keyframe
+   * @tparam T type of the stored values
+   */
+  template <typename T>
+  void decodeFrame(size_t frame, TrajectoryFrame &result) const;
+};
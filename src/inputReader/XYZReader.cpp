@@ -1,55 +1,79 @@
 #include "inputReader/XYZReader.h"
 
+#include <omp.h>
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
 #include <cstdlib>
-#include <iostream>
-#include <sstream>
+#include <limits>
 #include <vector>
 
-void XYZReader::parse(std::vector<Particle> &particles, std::istream &file) {
-  std::array<double, 3> x;
-  std::array<double, 3> v;
-  double m;
-  std::optional<double> epsilon;
-  std::optional<double> sigma;
-  int num_particles = 0;
+void XYZReader::parse(std::vector<Particle> &particles, std::string_view data) {
+  const char *line = data.data();
+  const char *end = line + data.size();
 
-  std::string tmp_string;
+  while (line < end && isBlankOrComment(line, end)) line = nextLine(line, end);
 
-  getline(file, tmp_string);
-  SPDLOG_INFO("Read first line: {}", tmp_string);  // Könnte Sinvoll sein, deshalb auf info
+  size_t num_particles = 0;
+  const char *pos = line;
+  if (!nextValue(pos, end, num_particles)) {
+    SPDLOG_ERROR("Error reading file: expected the number of particles");
+    exit(-1);
+  }
+  SPDLOG_INFO("Reading {} particles", num_particles);
+  const char *body = nextLine(pos, end);
 
-  while (tmp_string.empty() or tmp_string[0] == '#') {
-    getline(file, tmp_string);
-    SPDLOG_DEBUG("Read line: {}", tmp_string);  // Muss nicht den output zumüllen
+  // split the particle lines into one chunk per thread, every chunk starts at the beginning of a line
+  const auto chunks = static_cast<size_t>(omp_get_max_threads());
+  std::vector<const char *> chunk_begin(chunks + 1, end);
+  chunk_begin[0] = body;
+  for (size_t c = 1; c < chunks; c++) {
+    const char *split = body + (end - body) * c / chunks;
+    chunk_begin[c] = split > body ? nextLine(split - 1, end) : body;
   }
 
-  std::istringstream numstream(tmp_string);
-  numstream >> num_particles;
-  SPDLOG_DEBUG("Reading {}.", num_particles);
-  getline(file, tmp_string);
-  SPDLOG_INFO("Read line: {}", tmp_string);  // gibt guten Überblick
+  // the first particle of every chunk is the number of lines before it
+  std::vector<size_t> chunk_offset(chunks + 1, 0);
+#pragma omp parallel for schedule(static, 1)
+  for (size_t c = 0; c < chunks; c++) {
+    const char *first = chunk_begin[c];
+    const char *last = chunk_begin[c + 1];
+    size_t lines = std::count(first, last, '\n');
+    if (last == end && first < last && last[-1] != '\n') lines++;
+    chunk_offset[c + 1] = lines;
+  }
+  for (size_t c = 0; c < chunks; c++) chunk_offset[c + 1] += chunk_offset[c];
 
-  particles.reserve(num_particles);
+  if (chunk_offset[chunks] < num_particles) {
+    SPDLOG_ERROR("Error reading file: eof reached unexpectedly reading from line {}", chunk_offset[chunks]);
+    exit(-1);
+  }
 
-  for (int i = 0; i < num_particles; i++) {
-    std::istringstream datastream(tmp_string);
+  const size_t first_particle = particles.size();
+  particles.resize(first_particle + num_particles);
 
-    for (auto &xj : x) {
-      datastream >> xj;
+  size_t error_line = std::numeric_limits<size_t>::max();
+#pragma omp parallel for schedule(static, 1) reduction(min : error_line)
+  for (size_t c = 0; c < chunks; c++) {
+    size_t i = chunk_offset[c];
+    for (const char *l = chunk_begin[c]; l < chunk_begin[c + 1] && i < num_particles; l = nextLine(l, end), i++) {
+      Vector3 x;
+      Vector3 v;
+      double m;
+      const char *p = l;
+      const bool complete = nextValue(p, end, x[0]) && nextValue(p, end, x[1]) && nextValue(p, end, x[2]) &&
+                            nextValue(p, end, v[0]) && nextValue(p, end, v[1]) && nextValue(p, end, v[2]) &&
+                            nextValue(p, end, m);
+      if (!complete) {
+        error_line = std::min(error_line, i);
+        break;
+      }
+      particles[first_particle + i] = Particle(x, v, m, std::nullopt, std::nullopt);
     }
-    for (auto &vj : v) {
-      datastream >> vj;
-    }
-    if (datastream.eof()) {
-      SPDLOG_ERROR("Error reading file: eof reached unexpectedly reading from line {}", i);
-      exit(-1);
-    }
-    datastream >> m;
-    particles.emplace_back(x, v, m, epsilon, sigma);
+  }
 
-    getline(file, tmp_string);
-    SPDLOG_DEBUG("Read line: {}", tmp_string);
+  if (error_line != std::numeric_limits<size_t>::max()) {
+    SPDLOG_ERROR("Error reading file: incomplete particle in line {}", error_line);
+    exit(-1);
   }
 }
@@ -1,6 +1,6 @@
 #pragma once
 
-#include <fstream>
+#include <string_view>
 #include <vector>
 
 #include "inputReader/FileReader.h"
@@ -15,16 +15,20 @@
  * # xyz-coord      velocity        mass
  * 0.0 0.0 0.0     0.0 0.0 0.0    0.0
  * ```
+ * Large files are parsed in parallel: the file is split into one chunk of lines per thread and every thread writes its
+ * particles directly to their final position.
  *
  * @see FileReader
  */
 class XYZReader : public FileReader<XYZReader> {
  public:
+  using FileReader<XYZReader>::parse;
+
   /**
-   * @brief Parses a stream of the `file` in xyz format into `particles`
+   * @brief Parses the contents of a file in xyz format into `particles`
    *
    * @param particles Where to store the read particles
-   * @param file Filestream to read from
+   * @param data Contents of the file
    */
-  static void parse(std::vector<Particle> &particles, std::istream &file);
+  static void parse(std::vector<Particle> &particles, std::string_view data);
 };
@@ -1,22 +1,432 @@
 #include "YAMLReader.h"
 
 #include <spdlog/spdlog.h>
+#include <yaml-cpp/eventhandler.h>
+#include <yaml-cpp/parser.h>
 #include <yaml-cpp/yaml.h>
 
 #include <array>
+#include <charconv>
 #include <cstdlib>
+#include <functional>
 #include <iostream>
+#include <map>
 #include <sstream>
 #include <vector>
 
-// #include "../../cmake-build-debug/_deps/googletest-src/googlemock/include/gmock/gmock-matchers.h"
 #include "Settings.h"
 #include "container/linkedCells/Cell.h"
 #include "utils/ArrayUtils.h"
 #include "utils/ParticleGenerator.h"
 
+namespace {
+
+/**
+ * @brief Generates the particles of a cuboid, membrane or disc entry
+ */
+void parseGenerator(std::vector<Particle> &particles, const std::string &type, const YAML::Node &generator,
+                    Settings &settings) {
+  const size_t first_particle = particles.size();
+
+  if (type == "cuboid") {
+    const YAML::Node &cuboid = generator;
+
+    Vector3 x = cuboid["position"].as<Vector3>();
+    std::array<unsigned int, 3> n = cuboid["size"].as<std::array<unsigned int, 3>>();
+    double distance = cuboid["distance"].as<double>();
+    double mass = cuboid["mass"].as<double>();
+    Vector3 v = cuboid["velocity"].as<Vector3>();
+    std::optional<double> epsilon;
+    std::optional<double> sigma;
+    if (cuboid["epsilon"]) epsilon = cuboid["epsilon"].as<double>();
+    if (cuboid["sigma"]) sigma = cuboid["sigma"].as<double>();
+
+    SPDLOG_DEBUG("Generating cuboid: position={} size={} distance={} mass={} velocity={} sigma={} epsilon={}",
+                 ArrayUtils::to_string(x), ArrayUtils::to_string(n), distance, mass, ArrayUtils::to_string(v),
+                 sigma.value_or(1), epsilon.value_or(5));
+
+    ParticleGenerator::cuboid(particles, x, n, distance, mass, epsilon, sigma, v);
+  } else if (type == "membrane") {
+    const YAML::Node &membrane = generator;
+
+    Vector3 x = membrane["position"].as<Vector3>();
+    std::array<unsigned int, 3> n = membrane["size"].as<std::array<unsigned int, 3>>();
+    double distance = membrane["distance"].as<double>();
+    double mass = membrane["mass"].as<double>();
+    Vector3 v = membrane["velocity"].as<Vector3>();
+    std::optional<double> epsilon;
+
+    if (membrane["epsilon"]) epsilon = membrane["epsilon"].as<double>();
+    if (membrane["sigma"]) settings.membrane.sigma = membrane["sigma"].as<double>();
+    settings.membrane.k = membrane["k"].as<double>();
+    settings.membrane.r0 = membrane["r0"].as<double>();
+    SPDLOG_DEBUG("Generating membrane: position={} size={} distance={} mass={} velocity={} sigma={} epsilon={}",
+                 ArrayUtils::to_string(x), ArrayUtils::to_string(n), distance, mass, ArrayUtils::to_string(v),
+                 settings.membrane.sigma.value_or(1), epsilon.value_or(5));
+
+    ParticleGenerator::membrane(particles, x, n, distance, mass, epsilon, settings.membrane.sigma, v,
+                                settings.membrane.r0.value(), settings.membrane.bonds);
+
+    // the upwards force acts as a force group on the given (x, y) grid positions of this membrane
+    auto upwards = membrane["upwards_particles_indexes"];
+    if (upwards && membrane["f_zUp"]) {
+      ForceGroup group;
+      group.force = {0, 0, membrane["f_zUp"].as<double>()};
+      group.end_time = membrane["f_zUp_end_time"] ? membrane["f_zUp_end_time"].as<double>() : 150;
+
+      std::vector<size_t> indices;
+      for (auto [ux, uy] : upwards.as<std::vector<std::array<unsigned int, 2>>>()) {
+        if (ux >= n[0] || uy >= n[1]) {
+          SPDLOG_WARN("Upwards particle [{},{}] is outside of the membrane", ux, uy);
+          continue;
+        }
+        indices.push_back(first_particle + uy * n[0] + ux);
+      }
+      group.selector.indices = indices;
+      settings.force_groups.push_back(group);
+    }
+  } else if (type == "disc") {
+    const YAML::Node &disc = generator;
+    Vector3 position = disc["position"].as<Vector3>();
+    int radius = disc["radius"].as<int>();
+    double distance = disc["distance"].as<double>();
+    double mass = disc["mass"].as<double>();
+    Vector3 velocity = disc["velocity"].as<Vector3>();
+    std::optional<double> epsilon;
+    std::optional<double> sigma;
+    if (disc["epsilon"]) epsilon = disc["epsilon"].as<double>();
+    if (disc["sigma"]) sigma = disc["sigma"].as<double>();
+
+    SPDLOG_DEBUG("Generating disc: position={} radius={} distance={} mass={} velocity={}",
+                 ArrayUtils::to_string(position), radius, distance, mass, ArrayUtils::to_string(velocity));
+    ParticleGenerator::disc(particles, position, radius, distance, mass, epsilon, sigma, velocity);
+  }
+}
+
+/**
+ * @brief Fields of a single particle entry
+ */
+struct SingleParticle {
+  Vector3 x{};
+  Vector3 v{};
+  double mass = 0;
+  std::optional<double> epsilon;
+  std::optional<double> sigma;
+  std::optional<Vector3> f;
+  std::optional<Vector3> old_f;
+  int type = 0;
+  bool is_static = false;
+  std::optional<std::string> tag;
+};
+
+/**
+ * @class ScenarioHandler
+ * @brief Builds the scenario directly from the events of the YAML parser
+ *
+ * Only the small sections (output, simulation, force groups) and single generator entries are turned into YAML nodes.
+ * Single particles, which make up most of exported scenarios, are parsed from the events straight into the particle
+ * vector, so no node tree is built for them.
+ */
+class ScenarioHandler : public YAML::EventHandler {
+ public:
+  ScenarioHandler(std::vector<Particle> &particles, Settings &settings) : particles(particles), settings(settings) {}
+
+  /** @brief Top level sections except the particles */
+  YAML::Node sections{YAML::NodeType::Map};
+  /** @brief Particle ranges of all tagged entries */
+  GeneratorTags tags;
+
+  void OnDocumentStart(const YAML::Mark &) override {}
+  void OnDocumentEnd() override {}
+
+  void OnNull(const YAML::Mark &mark, YAML::anchor_t anchor) override { onScalar(mark, anchor, "~", true); }
+
+  void OnAlias(const YAML::Mark &mark, YAML::anchor_t anchor) override {
+    if (mode != Mode::NODE) throw YAML::ParserException(mark, "Aliases are only supported outside of particles");
+    addNode(anchors.at(anchor));
+  }
+
+  void OnScalar(const YAML::Mark &mark, const std::string &, YAML::anchor_t anchor, const std::string &value) override {
+    onScalar(mark, anchor, value, false);
+  }
+
+  void OnSequenceStart(const YAML::Mark &mark, const std::string &, YAML::anchor_t anchor,
+                       YAML::EmitterStyle::value) override {
+    switch (mode) {
+      case Mode::ROOT:
+        if (key == "particles") {
+          mode = Mode::PARTICLES;
+          return;
+        }
+        beginNode([this, name = key](const YAML::Node &node) { sections[name] = node; });
+        break;
+      case Mode::ENTRY:
+        beginNode([this, name = key](const YAML::Node &node) { finishGenerator(name, node); });
+        break;
+      case Mode::SINGLE:
+        if (component >= 0) throw YAML::ParserException(mark, "Unexpected nested sequence in single particle");
+        component = 0;
+        return;
+      case Mode::NODE:
+        break;
+      default:
+        throw YAML::ParserException(mark, "Unexpected sequence");
+    }
+    pushNode(YAML::Node(YAML::NodeType::Sequence), false, anchor);
+  }
+
+  void OnSequenceEnd() override {
+    switch (mode) {
+      case Mode::PARTICLES:
+        mode = Mode::ROOT;
+        key.clear();
+        break;
+      case Mode::SINGLE:
+        component = -1;
+        key.clear();
+        break;
+      default:
+        popNode();
+    }
+  }
+
+  void OnMapStart(const YAML::Mark &mark, const std::string &, YAML::anchor_t anchor,
+                  YAML::EmitterStyle::value) override {
+    switch (mode) {
+      case Mode::DOCUMENT:
+        mode = Mode::ROOT;
+        return;
+      case Mode::ROOT:
+        beginNode([this, name = key](const YAML::Node &node) { sections[name] = node; });
+        break;
+      case Mode::PARTICLES:
+        mode = Mode::ENTRY;
+        key.clear();
+        return;
+      case Mode::ENTRY:
+        if (key == "single") {
+          mode = Mode::SINGLE;
+          single = SingleParticle{};
+          key.clear();
+          return;
+        }
+        beginNode([this, name = key](const YAML::Node &node) { finishGenerator(name, node); });
+        break;
+      case Mode::NODE:
+        break;
+      default:
+        throw YAML::ParserException(mark, "Unexpected map");
+    }
+    pushNode(YAML::Node(YAML::NodeType::Map), true, anchor);
+  }
+
+  void OnMapEnd() override {
+    switch (mode) {
+      case Mode::ROOT:
+        mode = Mode::DOCUMENT;
+        break;
+      case Mode::ENTRY:
+        mode = Mode::PARTICLES;
+        break;
+      case Mode::SINGLE:
+        finishSingle();
+        mode = Mode::ENTRY;
+        key.clear();
+        break;
+      default:
+        popNode();
+    }
+  }
+
+ private:
+  /** @brief Part of the document the next event belongs to */
+  enum class Mode { DOCUMENT, ROOT, PARTICLES, ENTRY, SINGLE, NODE };
+
+  /**
+   * @brief Map or sequence that is currently built
+   */
+  struct Frame {
+    YAML::Node node;
+    bool is_map;
+    std::optional<YAML::Node> key;
+  };
+
+  std::vector<Particle> &particles;
+  Settings &settings;
+
+  Mode mode = Mode::DOCUMENT;
+  /** @brief Last read key of the root map, a particle entry or a single particle */
+  std::string key;
+
+  /** @brief Stack of the nodes that are built in Mode::NODE */
+  std::vector<Frame> stack;
+  /** @brief Mode to return to after the node is built */
+  Mode parent_mode = Mode::ROOT;
+  /** @brief Receives the node once it is complete */
+  std::function<void(const YAML::Node &)> on_node;
+  /** @brief Anchored nodes for aliases */
+  std::map<YAML::anchor_t, YAML::Node> anchors;
+
+  /** @brief Single particle that is currently parsed */
+  SingleParticle single;
+  /** @brief Index of the next vector component in a single particle, -1 outside of a sequence */
+  int component = -1;
+
+  void onScalar(const YAML::Mark &mark, YAML::anchor_t anchor, const std::string &value, bool is_null) {
+    switch (mode) {
+      case Mode::ROOT:
+      case Mode::ENTRY:
+        // scalars at the top level are always keys, except for the simple settings
+        if (key.empty()) {
+          key = value;
+        } else {
+          if (mode == Mode::ROOT) sections[key] = YAML::Node(value);
+          key.clear();
+        }
+        break;
+      case Mode::SINGLE:
+        if (key.empty()) {
+          key = value;
+        } else {
+          setSingleField(mark, value);
+        }
+        break;
+      case Mode::NODE: {
+        YAML::Node node = is_null ? YAML::Node(YAML::NodeType::Null) : YAML::Node(value);
+        if (anchor) anchors[anchor] = node;
+        addNode(node);
+      } break;
+      default:
+        throw YAML::ParserException(mark, "Unexpected scalar");
+    }
+  }
+
+  void beginNode(std::function<void(const YAML::Node &)> callback) {
+    parent_mode = mode;
+    mode = Mode::NODE;
+    on_node = std::move(callback);
+  }
+
+  void pushNode(const YAML::Node &node, const bool is_map, const YAML::anchor_t anchor) {
+    if (anchor) anchors[anchor] = node;
+    stack.push_back({node, is_map, std::nullopt});
+  }
+
+  void popNode() {
+    const YAML::Node node = stack.back().node;
+    stack.pop_back();
+    addNode(node);
+  }
+
+  /** @brief Adds a complete node to its parent, or passes it on if it has no parent */
+  void addNode(const YAML::Node &node) {
+    if (stack.empty()) {
+      mode = parent_mode;
+      key.clear();
+      on_node(node);
+      return;
+    }
+    Frame &top = stack.back();
+    if (!top.is_map) {
+      top.node.push_back(node);
+    } else if (!top.key) {
+      top.key = node;
+    } else {
+      top.node[top.key.value()] = node;
+      top.key.reset();
+    }
+  }
+
+  /**
+   * @brief Converts a scalar with std::from_chars, special values like .inf or 0x10 are left to yaml-cpp
+   */
+  template <typename T>
+  static T convert(const std::string &value) {
+    T result;
+    const auto [ptr, error] = std::from_chars(value.data(), value.data() + value.size(), result);
+    if (error != std::errc() || ptr != value.data() + value.size()) return YAML::Node(value).as<T>();
+    return result;
+  }
+
+  void setSingleField(const YAML::Mark &mark, const std::string &value) {
+    if (component >= 0) {
+      if (component > 2) throw YAML::ParserException(mark, "Vector of single particle has more than 3 components");
+      const double xi = convert<double>(value);
+      if (key == "position") {
+        single.x[component] = xi;
+      } else if (key == "velocity") {
+        single.v[component] = xi;
+      } else if (key == "force") {
+        if (!single.f) single.f = Vector3{};
+        (*single.f)[component] = xi;
+      } else if (key == "old_force") {
+        if (!single.old_f) single.old_f = Vector3{};
+        (*single.old_f)[component] = xi;
+      }
+      component++;
+      return;
+    }
+
+    if (key == "mass") {
+      single.mass = convert<double>(value);
+    } else if (key == "epsilon") {
+      single.epsilon = convert<double>(value);
+    } else if (key == "sigma") {
+      single.sigma = convert<double>(value);
+    } else if (key == "type") {
+      single.type = convert<int>(value);
+    } else if (key == "static") {
+      single.is_static = value == "true" || (value != "false" && YAML::Node(value).as<bool>());
+    } else if (key == "tag") {
+      single.tag = value;
+    }
+    key.clear();
+  }
+
+  void finishSingle() {
+    SPDLOG_TRACE("Generating single particle: position={} mass={} velocity={}", ArrayUtils::to_string(single.x),
+                 single.mass, ArrayUtils::to_string(single.v));
+    const size_t first_particle = particles.size();
+    particles.emplace_back(single.x, single.v, single.mass, single.epsilon, single.sigma, single.f.value_or(Vector3{}),
+                           single.old_f.value_or(Vector3{}), single.type);
+    finishEntry(first_particle, single.tag, single.is_static);
+  }
+
+  void finishGenerator(const std::string &type, const YAML::Node &generator) {
+    const size_t first_particle = particles.size();
+    parseGenerator(particles, type, generator, settings);
+
+    std::optional<std::string> tag;
+    if (generator["tag"]) tag = generator["tag"].as<std::string>();
+    finishEntry(first_particle, tag, generator["static"] && generator["static"].as<bool>());
+  }
+
+  /**
+   * @brief Applies the options of an entry to its particles
+   *
+   * Particles of an entry with "static: true" are never moved by the simulation, particles of an entry with
+   * "tag: <name>" can be selected by force groups.
+   */
+  void finishEntry(const size_t first_particle, const std::optional<std::string> &tag, const bool is_static) {
+    if (tag) tags[tag.value()].push_back({first_particle, particles.size()});
+    if (!is_static) return;
+    for (size_t i = first_particle; i < particles.size(); i++) {
+      particles[i].setState(1);
+      particles[i].setV({0, 0, 0});
+    }
+  }
+};
+
+}  // namespace
+
 void YAMLReader::parse(std::vector<Particle> &particles, std::istream &file, Settings &settings) {
-  YAML::Node config = YAML::Load(file);
+  // force groups are resolved after all particles of this file have been generated
+  const size_t first_force_group = settings.force_groups.size();
+
+  ScenarioHandler handler(particles, settings);
+  YAML::Parser parser(file);
+  parser.HandleNextDocument(handler);
+  const YAML::Node &config = handler.sections;
 
   auto output = config["output"];
   if (output) settings.output = config["output"].as<Settings::Output>();
@@ -26,96 +436,10 @@ void YAMLReader::parse(std::vector<Particle> &particles, std::istream &file, Set
   auto alternative = config["useAlternateParallelisation"];
   if (alternative) settings.useAlternateParallelisation = config["useAlternateParallelisation"].as<bool>();
 
-  YAML::Node parts = config["particles"];
-  for (auto p : parts) {
-    if (p["cuboid"]) {
-      YAML::Node cuboid = p["cuboid"];
-
-      Vector3 x = cuboid["position"].as<Vector3>();
-      std::array<unsigned int, 3> n = cuboid["size"].as<std::array<unsigned int, 3>>();
-      double distance = cuboid["distance"].as<double>();
-      double mass = cuboid["mass"].as<double>();
-      Vector3 v = cuboid["velocity"].as<Vector3>();
-      std::optional<double> epsilon;
-      std::optional<double> sigma;
-      if (cuboid["epsilon"]) epsilon = cuboid["epsilon"].as<double>();
-      if (cuboid["sigma"]) sigma = cuboid["sigma"].as<double>();
-
-      SPDLOG_DEBUG("Generating cuboid: position={} size={} distance={} mass={} velocity={} sigma={} epsilon={}",
-                   ArrayUtils::to_string(x), ArrayUtils::to_string(n), distance, mass, ArrayUtils::to_string(v),
-                   sigma.value_or(1), epsilon.value_or(5));
-
-      ParticleGenerator::cuboid(particles, x, n, distance, mass, epsilon, sigma, v);
-    } else if (p["membrane"]) {
-      YAML::Node membrane = p["membrane"];
-
-      Vector3 x = membrane["position"].as<Vector3>();
-      std::array<unsigned int, 3> n = membrane["size"].as<std::array<unsigned int, 3>>();
-      double distance = membrane["distance"].as<double>();
-      double mass = membrane["mass"].as<double>();
-      Vector3 v = membrane["velocity"].as<Vector3>();
-      std::optional<double> epsilon;
-
-      if (membrane["epsilon"]) epsilon = membrane["epsilon"].as<double>();
-      if (membrane["sigma"]) settings.membrane.sigma = membrane["sigma"].as<double>();
-      std::optional<std::vector<std::array<int, 2>>> upwardsParticlesIndexes =
-          membrane["upwards_particles_indexes"].as<std::vector<std::array<int, 2>>>();
-      settings.membrane.k = membrane["k"].as<double>();
-      settings.membrane.r0 = membrane["r0"].as<double>();
-      settings.membrane.f_zUp = membrane["f_zUp"].as<double>();
-      SPDLOG_DEBUG("Generating membrane: position={} size={} distance={} mass={} velocity={} sigma={} epsilon={}",
-                   ArrayUtils::to_string(x), ArrayUtils::to_string(n), distance, mass, ArrayUtils::to_string(v),
-                   settings.membrane.sigma.value_or(1), epsilon.value_or(5));
-
-      ParticleGenerator::membrane(particles, x, n, distance, mass, epsilon, settings.membrane.sigma, v,
-                                  settings.membrane.upwardsParticles,
-                                  upwardsParticlesIndexes.value_or(std::vector<std::array<int, 2>>{}));
-    } else if (p["single"]) {
-      YAML::Node single = p["single"];
-      Vector3 x = single["position"].as<Vector3>();
-      Vector3 v = single["velocity"].as<Vector3>();
-      double mass = single["mass"].as<double>();
-      std::optional<double> epsilon;
-      std::optional<double> sigma;
-      if (single["epsilon"]) epsilon = single["epsilon"].as<double>();
-      if (single["sigma"]) sigma = single["sigma"].as<double>();
-
-      if (single["force"]) {
-        Vector3 f = single["force"].as<Vector3>();
-        if (single["old_force"]) {
-          Vector3 old_f = single["old_force"].as<Vector3>();
-          SPDLOG_DEBUG(
-              "Generating single particle: position={}, velocity={}, mass={}, sigma={}, epsilon={}, force={}, "
-              "old_force={}",
-              ArrayUtils::to_string(x), ArrayUtils::to_string(v), mass, sigma.value_or(1), epsilon.value_or(5),
-              ArrayUtils::to_string(f), ArrayUtils::to_string(old_f));
-          particles.emplace_back(x, v, mass, epsilon, sigma, f, old_f);
-        } else {
-          SPDLOG_DEBUG("Generating single particle: position={}, velocity={}, mass={}, sigma={}, epsilon={}, force={}",
-                       ArrayUtils::to_string(x), ArrayUtils::to_string(v), mass, sigma.value_or(1), epsilon.value_or(5),
-                       ArrayUtils::to_string(f));
-          particles.emplace_back(x, v, mass, epsilon, sigma, f);
-        }
-      } else {
-        SPDLOG_DEBUG("Generating single particle: position={} mass={} velocity={}, sigma={}, epsilon={}",
-                     ArrayUtils::to_string(x), mass, ArrayUtils::to_string(v), sigma.value_or(1), epsilon.value_or(5));
-        particles.emplace_back(x, v, mass, epsilon, sigma);
-      }
-    } else if (p["disc"]) {
-      YAML::Node disc = p["disc"];
-      Vector3 position = disc["position"].as<Vector3>();
-      int radius = disc["radius"].as<int>();
-      double distance = disc["distance"].as<double>();
-      double mass = disc["mass"].as<double>();
-      Vector3 velocity = disc["velocity"].as<Vector3>();
-      std::optional<double> epsilon;
-      std::optional<double> sigma;
-      if (disc["epsilon"]) epsilon = disc["epsilon"].as<double>();
-      if (disc["sigma"]) sigma = disc["sigma"].as<double>();
-
-      SPDLOG_DEBUG("Generating disc: position={} radius={} distance={} mass={} velocity={}",
-                   ArrayUtils::to_string(position), radius, distance, mass, ArrayUtils::to_string(velocity));
-      ParticleGenerator::disc(particles, position, radius, distance, mass, epsilon, sigma, velocity);
-    }
+  for (auto group : config["force_groups"]) {
+    settings.force_groups.push_back(group.as<ForceGroup>());
+  }
+  for (size_t i = first_force_group; i < settings.force_groups.size(); i++) {
+    settings.force_groups[i].resolve(particles, handler.tags);
   }
 }
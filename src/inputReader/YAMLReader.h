@@ -3,6 +3,7 @@
 #include <yaml-cpp/yaml.h>
 
 #include <algorithm>
+#include <cmath>
 #include <filesystem>
 #include <fstream>
 #include <vector>
@@ -51,6 +52,7 @@ struct convert<Particle> {
     node["sigma"] = rhs.getSigma();
     node["epsilon"] = rhs.getEpsilon();
     node["type"] = rhs.getType();
+    if (rhs.isStatic()) node["static"] = true;
 
     return node;
   }
@@ -97,6 +99,132 @@ struct convert<Particle> {
   }
 };
 
+template <>
+struct convert<AdaptiveTimestep> {
+  static Node encode(const AdaptiveTimestep &rhs) {
+    Node node;
+
+    node["delta_t_min"] = rhs.delta_t_min;
+    node["delta_t_max"] = rhs.delta_t_max;
+    node["max_displacement"] = rhs.max_displacement;
+
+    return node;
+  }
+
+  static bool decode(const Node &node, AdaptiveTimestep &rhs) {
+    if (!node.IsMap()) {
+      return false;
+    }
+
+    auto delta_t_min = node["delta_t_min"];
+    if (!delta_t_min) return false;
+
+    auto delta_t_max = node["delta_t_max"];
+    if (!delta_t_max) return false;
+
+    auto max_displacement = node["max_displacement"];
+    if (!max_displacement) return false;
+
+    rhs.delta_t_min = delta_t_min.as<double>();
+    rhs.delta_t_max = delta_t_max.as<double>();
+    rhs.max_displacement = max_displacement.as<double>();
+
+    return rhs.delta_t_min > 0 && rhs.delta_t_min <= rhs.delta_t_max && rhs.max_displacement > 0;
+  }
+};
+
+template <>
+struct convert<TrajectoryOptions> {
+  static Node encode(const TrajectoryOptions &rhs) {
+    Node node;
+
+    node["single_precision"] = rhs.single_precision;
+    node["delta_encoding"] = rhs.delta_encoding;
+    node["keyframe_interval"] = rhs.keyframe_interval;
+
+    return node;
+  }
+
+  static bool decode(const Node &node, TrajectoryOptions &rhs) {
+    // `trajectory: true` enables the trajectory with the default options
+    if (node.IsScalar()) {
+      return node.as<bool>();
+    }
+    if (!node.IsMap()) {
+      return false;
+    }
+
+    auto single_precision = node["single_precision"];
+    if (single_precision) rhs.single_precision = single_precision.as<bool>();
+
+    auto delta_encoding = node["delta_encoding"];
+    if (delta_encoding) rhs.delta_encoding = delta_encoding.as<bool>();
+
+    auto keyframe_interval = node["keyframe_interval"];
+    if (keyframe_interval) rhs.keyframe_interval = keyframe_interval.as<unsigned int>();
+
+    return rhs.keyframe_interval > 0;
+  }
+};
+
+template <>
+struct convert<ForceGroup> {
+  static Node encode(const ForceGroup &rhs) {
+    Node node;
+
+    // indices are already resolved, so the selection is exported as explicit index list
+    node["select"]["indices"] = rhs.indices;
+    node["force"] = rhs.force;
+    if (rhs.force_end) node["force_end"] = rhs.force_end.value();
+    node["start_time"] = rhs.start_time;
+    if (std::isfinite(rhs.end_time)) node["end_time"] = rhs.end_time;
+
+    return node;
+  }
+
+  static bool decode(const Node &node, ForceGroup &rhs) {
+    if (!node.IsMap()) {
+      return false;
+    }
+
+    auto force = node["force"];
+    if (!force) return false;
+    rhs.force = force.as<Vector3>();
+
+    auto start_time = node["start_time"];
+    if (start_time) rhs.start_time = start_time.as<double>();
+
+    auto end_time = node["end_time"];
+    if (end_time) rhs.end_time = end_time.as<double>();
+
+    auto force_end = node["force_end"];
+    if (force_end) {
+      rhs.force_end = force_end.as<Vector3>();
+      if (!std::isfinite(rhs.end_time)) {
+        SPDLOG_ERROR("A force group with force_end needs an end_time to ramp the force");
+        exit(EXIT_FAILURE);
+      }
+    }
+
+    auto select = node["select"];
+    if (!select || !select.IsMap()) return false;
+
+    auto index_range = select["index_range"];
+    if (index_range) rhs.selector.index_range = index_range.as<std::array<size_t, 2>>();
+
+    auto indices = select["indices"];
+    if (indices) rhs.selector.indices = indices.as<std::vector<size_t>>();
+
+    auto region = select["region"];
+    if (region) rhs.selector.region = {region["min"].as<Vector3>(), region["max"].as<Vector3>()};
+
+    auto tag = select["tag"];
+    if (tag) rhs.selector.tag = tag.as<std::string>();
+
+    return true;
+  }
+};
+
 template <>
 struct convert<Settings::Output> {
   static Node encode(const Settings::Output &rhs) {
@@ -106,8 +234,15 @@ struct convert<Settings::Output> {
     node["prefix"] = rhs.prefix;
 
     if (rhs.export_filename) node["export_filename"] = rhs.export_filename.value().string();
+    if (rhs.checkpoint_filename) node["checkpoint_filename"] = rhs.checkpoint_filename.value().string();
+    if (rhs.checkpoint_interval) node["checkpoint_interval"] = rhs.checkpoint_interval.value();
 
     node["frequency"] = rhs.frequency;
+    if (rhs.trajectory) node["trajectory"] = rhs.trajectory.value();
+    node["buffers"] = rhs.buffers;
+    node["vtk_mode"] = vtk_data_mode_to_string(rhs.vtk_mode);
+    node["vtk_compression"] = rhs.vtk_compression;
+    if (rhs.cell_costs) node["cell_costs"] = cell_cost_format_to_string(rhs.cell_costs.value());
 
     auto log_level = spdlog::level::to_string_view(rhs.log_level);
     node["log_level"] = std::string(log_level.data(), log_level.size());
@@ -131,9 +266,30 @@ struct convert<Settings::Output> {
     auto export_filename = node["export_filename"];
     if (export_filename) rhs.export_filename = std::filesystem::path(export_filename.as<std::string>());
 
+    auto checkpoint_filename = node["checkpoint_filename"];
+    if (checkpoint_filename) rhs.checkpoint_filename = std::filesystem::path(checkpoint_filename.as<std::string>());
+
+    auto checkpoint_interval = node["checkpoint_interval"];
+    if (checkpoint_interval) rhs.checkpoint_interval = checkpoint_interval.as<double>();
+
     auto frequency = node["frequency"];
     if (frequency) rhs.frequency = frequency.as<unsigned int>();
 
+    auto trajectory = node["trajectory"];
+    if (trajectory) rhs.trajectory = trajectory.as<TrajectoryOptions>();
+
+    auto buffers = node["buffers"];
+    if (buffers) rhs.buffers = std::max(buffers.as<unsigned int>(), 1u);
+
+    auto vtk_mode = node["vtk_mode"];
+    if (vtk_mode) rhs.vtk_mode = string_to_vtk_data_mode(vtk_mode.as<std::string>());
+
+    auto vtk_compression = node["vtk_compression"];
+    if (vtk_compression) rhs.vtk_compression = vtk_compression.as<bool>();
+
+    auto cell_costs = node["cell_costs"];
+    if (cell_costs) rhs.cell_costs = string_to_cell_cost_format(cell_costs.as<std::string>());
+
     auto log_level = node["log_level"];
     if (log_level) rhs.log_level = spdlog::level::from_str(log_level.as<std::string>());
 
@@ -148,8 +304,13 @@ struct convert<Settings::Simulation> {
 
     if (rhs.worksheet) node["worksheet"] = rhs.worksheet.value();
 
+    if (rhs.start_time != 0) node["start_time"] = rhs.start_time;
     if (rhs.end_time) node["end_time"] = rhs.end_time.value();
     if (rhs.delta_t) node["delta_t"] = rhs.delta_t.value();
+    if (rhs.adaptive_timestep) node["adaptive_timestep"] = rhs.adaptive_timestep.value();
+    if (rhs.integrator) node["integrator"] = integrator_to_string(rhs.integrator.value());
+    if (rhs.block_levels) node["block_levels"] = rhs.block_levels.value();
+    if (rhs.block_eta) node["block_eta"] = rhs.block_eta.value();
 
     if (rhs.domain) node["domain"] = rhs.domain.value();
     if (rhs.cutoff_radius) node["cutoff_radius"] = rhs.cutoff_radius.value();
@@ -194,12 +355,39 @@ struct convert<Settings::Simulation> {
     auto worksheet = node["worksheet"];
     if (worksheet) rhs.worksheet = worksheet.as<unsigned int>();
 
+    auto start_time = node["start_time"];
+    if (start_time) rhs.start_time = start_time.as<double>();
+
     auto end_time = node["end_time"];
     if (end_time) rhs.end_time = end_time.as<double>();
 
     auto delta_t = node["delta_t"];
     if (delta_t) rhs.delta_t = delta_t.as<double>();
 
+    auto adaptive_timestep = node["adaptive_timestep"];
+    if (adaptive_timestep) rhs.adaptive_timestep = adaptive_timestep.as<AdaptiveTimestep>();
+
+    auto integrator = node["integrator"];
+    if (integrator) rhs.integrator = string_to_integrator(integrator.as<std::string>());
+
+    auto block_levels = node["block_levels"];
+    if (block_levels) {
+      rhs.block_levels = block_levels.as<unsigned int>();
+      if (rhs.block_levels.value() > 20) {
+        SPDLOG_ERROR("block_levels must not be larger than 20");
+        exit(EXIT_FAILURE);
+      }
+    }
+
+    auto block_eta = node["block_eta"];
+    if (block_eta) {
+      rhs.block_eta = block_eta.as<double>();
+      if (rhs.block_eta.value() <= 0) {
+        SPDLOG_ERROR("block_eta must be positive");
+        exit(EXIT_FAILURE);
+      }
+    }
+
     auto brown_motion_avg_velocity = node["brown_motion_avg_velocity"];
     if (brown_motion_avg_velocity) rhs.brown_motion_avg_velocity = brown_motion_avg_velocity.as<double>();
 
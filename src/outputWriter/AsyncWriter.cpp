@@ -0,0 +1,90 @@
+#include "outputWriter/AsyncWriter.h"
+
+#include <omp.h>
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+
+namespace outputWriter {
+
+AsyncWriter::AsyncWriter(WriteFunction write, size_t buffers)
+    : write(std::move(write)), frames(std::max<size_t>(buffers, 1)) {
+  for (auto &frame : frames) free_frames.push_back(&frame);
+  worker = std::thread(&AsyncWriter::run, this);
+}
+
+AsyncWriter::~AsyncWriter() {
+  {
+    std::lock_guard lock(mutex);
+    stop = true;
+  }
+  frame_pending.notify_one();
+  worker.join();
+
+  SPDLOG_DEBUG("Output stalled the simulation for {} ms",
+               std::chrono::duration_cast<std::chrono::milliseconds>(stall_time).count());
+}
+
+void AsyncWriter::submit(const std::vector<Particle> &particles, const std::string &filename, int iteration,
+                         double time) {
+  Frame *frame;
+  {
+    std::unique_lock lock(mutex);
+    if (free_frames.empty()) {
+      const auto start = std::chrono::steady_clock::now();
+      frame_written.wait(lock, [this] { return !free_frames.empty(); });
+      stall_time += std::chrono::steady_clock::now() - start;
+    }
+    frame = free_frames.front();
+    free_frames.pop_front();
+  }
+
+  // the buffer is owned by this thread until it is queued, so the copy does not need the lock. Assigning keeps the
+  // capacity of the buffer, so no memory is allocated once the buffers have reached the size of the particles vector
+  frame->particles.assign(particles);
+  frame->filename = filename;
+  frame->iteration = iteration;
+  frame->time = time;
+
+  {
+    std::lock_guard lock(mutex);
+    pending_frames.push_back(frame);
+  }
+  frame_pending.notify_one();
+}
+
+size_t AsyncWriter::memoryUsage() const {
+  size_t bytes = 0;
+  for (const auto &frame : frames) bytes += frame.particles.memoryUsage();
+  return bytes;
+}
+
+void AsyncWriter::flush() {
+  std::unique_lock lock(mutex);
+  frame_written.wait(lock, [this] { return pending_frames.empty() && !writing; });
+}
+
+void AsyncWriter::run() {
+  // writers that open parallel regions would start a second full team competing with the threads of the simulation
+  omp_set_num_threads(1);
+
+  std::unique_lock lock(mutex);
+  while (true) {
+    frame_pending.wait(lock, [this] { return stop || !pending_frames.empty(); });
+    if (pending_frames.empty()) return;
+
+    Frame *frame = pending_frames.front();
+    pending_frames.pop_front();
+    writing = true;
+
+    lock.unlock();
+    write(*frame);
+    lock.lock();
+
+    writing = false;
+    free_frames.push_back(frame);
+    frame_written.notify_all();
+  }
+}
+
+}  // namespace outputWriter
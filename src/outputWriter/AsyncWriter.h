@@ -0,0 +1,124 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Particle.h"
+#include "outputWriter/ParticleSnapshot.h"
+
+namespace outputWriter {
+
+/**
+ * @class AsyncWriter
+ * Writes output files on a background thread
+ *
+ * The simulation copies the written fields of the particles into one of a fixed number of reusable buffers (see
+ * ParticleSnapshot) and continues immediately, while the background thread formats and writes the buffers in the order
+ * they were submitted. If all buffers are waiting to be written, submit() blocks until the oldest one is done
+ * (backpressure), so memory usage stays bounded even if the file system is slower than the simulation. Parallel regions
+ * of the writers run with a single thread on the background thread, so writing never takes cores from the simulation.
+ */
+class AsyncWriter {
+ public:
+  /**
+   * @struct Frame
+   * @brief Snapshot of the particles at one plotted iteration
+   */
+  struct Frame {
+    /** @brief Copy of the particle fields written to the files */
+    ParticleSnapshot particles;
+    /** @brief Output filename without iteration and extension */
+    std::string filename;
+    /** @brief Iteration of the snapshot */
+    int iteration = 0;
+    /** @brief Simulation time of the snapshot */
+    double time = 0;
+  };
+
+  /**
+   * @brief Function writing a frame, called on the background thread
+   */
+  using WriteFunction = std::function<void(Frame &)>;
+
+  /**
+   * @param write Function writing a frame, e.g. a call to XYZWriter::plotParticles
+   * @param buffers Number of reusable snapshot buffers, i.e. the maximum number of frames in flight
+   */
+  explicit AsyncWriter(WriteFunction write, size_t buffers = 2);
+
+  /**
+   * @brief Writes all submitted frames and stops the background thread
+   */
+  ~AsyncWriter();
+
+  // The background thread references this object
+  AsyncWriter(const AsyncWriter &) = delete;
+  AsyncWriter &operator=(const AsyncWriter &) = delete;
+
+  /**
+   * @brief Copies the written fields of the particles into a free buffer and queues it for writing
+   *
+   * Blocks if all buffers are still queued or being written.
+   * @param particles Particles to write
+   * @param filename Output filename
+   * @param iteration Current iteration number
+   * @param time Current simulation time
+   */
+  void submit(const std::vector<Particle> &particles, const std::string &filename, int iteration, double time);
+
+  /**
+   * @brief Blocks until all submitted frames are written
+   */
+  void flush();
+
+  /**
+   * @return Total time submit() was blocked because all buffers were in use
+   */
+  [[nodiscard]] std::chrono::nanoseconds getStallTime() const { return stall_time; }
+
+  /**
+   * @brief Memory of the snapshot buffers. Only call it from the thread that submits the frames, which is the only one
+   * that resizes them
+   * @return Bytes of the snapshots in all buffers
+   */
+  [[nodiscard]] size_t memoryUsage() const;
+
+ private:
+  /** @brief Function writing a frame */
+  WriteFunction write;
+  /** @brief Storage of all buffers, they are only referenced by the queues below */
+  std::vector<Frame> frames;
+  /** @brief Buffers that can be filled by submit() */
+  std::deque<Frame *> free_frames;
+  /** @brief Buffers waiting to be written, in submission order */
+  std::deque<Frame *> pending_frames;
+  /** @brief True while the background thread is writing a frame */
+  bool writing = false;
+  /** @brief Tells the background thread to exit once all pending frames are written */
+  bool stop = false;
+  /** @brief Total time submit() was blocked */
+  std::chrono::nanoseconds stall_time{0};
+
+  /** @brief Protects the queues and flags */
+  std::mutex mutex;
+  /** @brief Signals new pending frames or stop to the background thread */
+  std::condition_variable frame_pending;
+  /** @brief Signals a finished frame to submit() and flush() */
+  std::condition_variable frame_written;
+
+  /** @brief Background thread, started last so all members above are initialized */
+  std::thread worker;
+
+  /**
+   * @brief Main loop of the background thread
+   */
+  void run();
+};
+
+}  // namespace outputWriter
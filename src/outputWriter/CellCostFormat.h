@@ -0,0 +1,45 @@
+#pragma once
+
+#include <spdlog/spdlog.h>
+
+#include <string>
+#include <unordered_map>
+
+/**
+ * @brief File format of the cell costs
+ */
+enum class CellCostFormat {
+  /** @brief VTK image data, one value per cell, can be opened next to the particles in ParaView */
+  VTI,
+  /** @brief One line per cell with its 3D index */
+  CSV
+};
+
+/**
+ * Transform a String, that represents a CellCostFormat into a CellCostFormat Enum
+ * @param str String that represents a format
+ * @return ENUM Object CellCostFormat
+ */
+inline CellCostFormat string_to_cell_cost_format(const std::string &str) {
+  const std::unordered_map<std::string, CellCostFormat> lookup = {
+      {"vti", CellCostFormat::VTI},
+      {"csv", CellCostFormat::CSV},
+  };
+
+  auto x = lookup.find(str);
+  if (x == lookup.end()) {
+    SPDLOG_WARN("Invalid cell cost format \"{}\"", str);
+    return CellCostFormat::VTI;
+  }
+
+  return x->second;
+}
+
+/**
+ * Transform a CellCostFormat Enum into the string used in input files
+ * @param format
+ * @return name of the format
+ */
+inline std::string cell_cost_format_to_string(const CellCostFormat format) {
+  return format == CellCostFormat::CSV ? "csv" : "vti";
+}
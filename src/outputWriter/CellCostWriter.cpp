@@ -0,0 +1,93 @@
+#include "outputWriter/CellCostWriter.h"
+
+#include <spdlog/fmt/fmt.h>
+#include <spdlog/spdlog.h>
+
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#include "container/linkedCells/LinkedCells.h"
+
+namespace outputWriter {
+
+namespace {
+/**
+ * @brief Writes one value of every cell as data array of an image data file
+ */
+template <typename Value>
+void writeArray(std::ofstream &out, const LinkedCells &cells, const char *type, const char *name, Value value) {
+  out << fmt::format(R"(      <DataArray type="{}" Name="{}" format="ascii">)", type, name) << "\n";
+  for (size_t i = 0; i < cells.cells.size(); i++) {
+    out << (i % 8 == 0 ? "        " : " ") << value(i);
+    if (i % 8 == 7 || i + 1 == cells.cells.size()) out << "\n";
+  }
+  out << "      </DataArray>\n";
+}
+
+void writeVTI(std::ofstream &out, const LinkedCells &cells, const unsigned int iterations) {
+  // the ghost layer lies outside the domain, which starts at the origin
+  const std::string extent = fmt::format("0 {} 0 {} 0 {}", cells.numCellsX, cells.numCellsY, cells.numCellsZ);
+  out << "<?xml version=\"1.0\"?>\n"
+      << R"(<VTKFile type="ImageData" version="0.1" byte_order="LittleEndian">)" << "\n"
+      << fmt::format(R"(  <ImageData WholeExtent="{}" Origin="{} {} {}" Spacing="{} {} {}">)", extent,
+                     -cells.cellSizeX, -cells.cellSizeY, -cells.cellSizeZ, cells.cellSizeX, cells.cellSizeY,
+                     cells.cellSizeZ)
+      << "\n"
+      << "  <FieldData>\n"
+      << fmt::format(R"(    <DataArray type="UInt32" Name="iterations" NumberOfTuples="1" format="ascii">{})",
+                     iterations)
+      << "</DataArray>\n"
+      << "  </FieldData>\n"
+      << fmt::format(R"(  <Piece Extent="{}">)", extent) << "\n"
+      << R"(    <CellData Scalars="seconds">)" << "\n";
+  // VTK orders the cells with x fastest like the linked cells
+  writeArray(out, cells, "UInt64", "pair_tests", [&](size_t i) { return cells.cell_costs[i].pair_tests; });
+  writeArray(out, cells, "UInt64", "interactions", [&](size_t i) { return cells.cell_costs[i].interactions; });
+  writeArray(out, cells, "Float64", "seconds", [&](size_t i) { return cells.cell_costs[i].seconds; });
+  writeArray(out, cells, "UInt32", "particles", [&](size_t i) { return cells.cells[i].particles.size(); });
+  writeArray(out, cells, "UInt8", "cell_type", [&](size_t i) { return static_cast<int>(cells.cells[i].cell_type); });
+  out << "    </CellData>\n"
+      << "  </Piece>\n"
+      << "  </ImageData>\n"
+      << "</VTKFile>\n";
+}
+
+void writeCSV(std::ofstream &out, const LinkedCells &cells, const unsigned int iterations) {
+  out << "# iterations: " << iterations << "\n"
+      << "x,y,z,cell_type,particles,pair_tests,interactions,seconds\n";
+  const size_t layer = static_cast<size_t>(cells.numCellsX) * cells.numCellsY;
+  for (size_t i = 0; i < cells.cells.size(); i++) {
+    const CellCost &cost = cells.cell_costs[i];
+    out << fmt::format("{},{},{},{},{},{},{},{}\n", i % cells.numCellsX, i % layer / cells.numCellsX, i / layer,
+                       static_cast<int>(cells.cells[i].cell_type), cells.cells[i].particles.size(), cost.pair_tests,
+                       cost.interactions, cost.seconds);
+  }
+}
+}  // namespace
+
+bool writeCellCosts(const LinkedCells &cells, const std::string &filename, const int iteration,
+                    const unsigned int iterations, const CellCostFormat format) {
+  if (cells.cell_costs.size() != cells.cells.size()) {
+    SPDLOG_ERROR("The costs of the cells are not measured");
+    return false;
+  }
+
+  std::stringstream strstr;
+  strstr << filename << "_cells_" << std::setfill('0') << std::setw(4) << iteration << "."
+         << cell_cost_format_to_string(format);
+  std::ofstream out(strstr.str());
+  if (!out.is_open()) {
+    SPDLOG_ERROR("Error opening {}", strstr.str());
+    return false;
+  }
+
+  if (format == CellCostFormat::CSV) {
+    writeCSV(out, cells, iterations);
+  } else {
+    writeVTI(out, cells, iterations);
+  }
+  return out.good();
+}
+
+}  // namespace outputWriter
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <string>
+
+#include "outputWriter/CellCostFormat.h"
+
+class LinkedCells;
+
+namespace outputWriter {
+
+/**
+ * @brief Writes the costs of every cell measured by LinkedCells::measureCellCosts() as a grid
+ *
+ * The grid includes the ghost layer, so it starts one cell below the origin of the domain. Besides the pair tests, the
+ * interactions and the time summed up over the window, every cell has its type and current number of particles.
+ *
+ * @param cells Container with measured costs
+ * @param filename Base name of the file, completed with `_cells_<iteration>` and the extension of the format
+ * @param iteration Current iteration number
+ * @param iterations Number of iterations the costs were summed up over
+ * @param format File format
+ * @return true if the file was written
+ */
+bool writeCellCosts(const LinkedCells &cells, const std::string &filename, int iteration, unsigned int iterations,
+                    CellCostFormat format);
+
+}  // namespace outputWriter
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include "Particle.h"
+
+/**
+ * @brief On-disk layout of binary checkpoints
+ *
+ * A checkpoint contains everything needed to continue a simulation:
+ * ```
+ * Header
+ * settings    settings_size bytes of YAML (output, simulation, membrane and force group settings)
+ * particles   particle_count ParticleRecord
+ * bonds       bond_count BondRecord
+ * cells       cell_entry_count CellRecord (only for linked cells simulations)
+ * ```
+ * The settings are small and stored as YAML to stay compatible with the input files, while the particles and bonds
+ * are stored as fixed size records that can be written and read without parsing. All numbers are stored in the byte
+ * order of the writing machine. The order of the particles inside the linked cells is stored as well, because it
+ * determines the order in which forces are summed up. Restoring it makes a single threaded continued run bit-identical
+ * to an uninterrupted one. With several threads the forces are summed up atomically in a varying order, so runs only
+ * agree up to rounding.
+ */
+namespace checkpoint {
+
+/** @brief First bytes of every checkpoint */
+constexpr std::array<char, 8> MAGIC = {'M', 'O', 'L', 'S', 'I', 'M', 'C', 'P'};
+/** @brief Version of the format, increased on incompatible changes */
+constexpr std::uint32_t VERSION = 2;
+/** @brief Written as is, reads differently on a machine with another byte order */
+constexpr std::uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+/**
+ * @struct Header
+ * @brief Header at the start of the checkpoint
+ */
+struct Header {
+  /** @brief Always MAGIC */
+  std::array<char, 8> magic;
+  /** @brief Always VERSION */
+  std::uint32_t version;
+  /** @brief Always BYTE_ORDER_MARK */
+  std::uint32_t byte_order;
+  /** @brief Iteration the checkpoint was taken after */
+  std::uint64_t iteration;
+  /** @brief Simulation time of the checkpoint */
+  double time;
+  /** @brief Timestep of the next iteration, differs from the configured one with an adaptive timestep */
+  double delta_t;
+  /** @brief Size of the settings YAML in bytes */
+  std::uint64_t settings_size;
+  /** @brief Number of particles */
+  std::uint64_t particle_count;
+  /** @brief Number of membrane bonds */
+  std::uint64_t bond_count;
+  /** @brief Number of particles in the linked cells */
+  std::uint64_t cell_entry_count;
+};
+static_assert(sizeof(Header) == 72, "Header must not contain padding");
+
+/**
+ * @struct ParticleRecord
+ * @brief Complete state of a particle
+ */
+struct ParticleRecord {
+  /** @brief Position */
+  Vector3 x;
+  /** @brief Velocity */
+  Vector3 v;
+  /** @brief Force */
+  Vector3 f;
+  /** @brief Force of the previous iteration, needed by the Stoermer-Verlet velocity update */
+  Vector3 old_f;
+  /** @brief Mass */
+  double m;
+  /** @brief ϵ-Value */
+  double epsilon;
+  /** @brief σ-Value */
+  double sigma;
+  /** @brief Type */
+  std::int32_t type;
+  /** @brief State (dead, alive or static) */
+  std::int32_t state;
+};
+static_assert(sizeof(ParticleRecord) == 128, "ParticleRecord must not contain padding");
+
+/**
+ * @struct BondRecord
+ * @brief Membrane bond between two particles
+ */
+struct BondRecord {
+  /** @brief Index of the first particle */
+  std::uint32_t i;
+  /** @brief Index of the second particle */
+  std::uint32_t j;
+  /** @brief BondType of the bond */
+  std::uint32_t type;
+  /** @brief Unused, makes the size of the record independent of padding */
+  std::uint32_t reserved;
+  /** @brief Length of the bond where the force vanishes */
+  double rest_length;
+};
+static_assert(sizeof(BondRecord) == 24, "BondRecord must not contain padding");
+
+/**
+ * @struct CellRecord
+ * @brief Position of a particle inside the linked cells. The records of a cell are stored in the order of the cell
+ */
+struct CellRecord {
+  /** @brief Index of the cell */
+  std::uint32_t cell;
+  /** @brief Index of the particle */
+  std::uint32_t particle;
+};
+static_assert(sizeof(CellRecord) == 8, "CellRecord must not contain padding");
+
+}  // namespace checkpoint
@@ -0,0 +1,122 @@
+#include "outputWriter/CheckpointWriter.h"
+
+#include <spdlog/spdlog.h>
+#include <yaml-cpp/yaml.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+#include "inputReader/YAMLReader.h"
+#include "outputWriter/CheckpointFormat.h"
+
+namespace outputWriter {
+
+namespace {
+/**
+ * @brief Serializes all settings needed to continue the simulation
+ */
+std::string encodeSettings(const Settings &settings, double time) {
+  Settings::Simulation simulation = settings.simulation;
+  simulation.start_time = time;
+  // the velocities already contain the brownian motion, only the thermostat target is still needed
+  simulation.brown_motion_avg_velocity.reset();
+  if (simulation.t_initial) {
+    simulation.t_final = simulation.t_final.value_or(simulation.t_initial.value());
+    simulation.t_initial.reset();
+  }
+
+  YAML::Node node;
+  node["output"] = settings.output;
+  node["simulation"] = simulation;
+  node["useAlternateParallelisation"] = settings.useAlternateParallelisation;
+  for (auto &group : settings.force_groups) node["force_groups"].push_back(group);
+  if (settings.membrane.r0) node["membrane"]["r0"] = settings.membrane.r0.value();
+  if (settings.membrane.k) node["membrane"]["k"] = settings.membrane.k.value();
+  if (settings.membrane.sigma) node["membrane"]["sigma"] = settings.membrane.sigma.value();
+
+  YAML::Emitter out;
+  out << node;
+  return out.c_str();
+}
+
+/** @brief Size of the buffer the records are converted into before they are written */
+constexpr size_t CHUNK_SIZE = 64 * 1024;
+
+/**
+ * @brief Converts records in chunks of CHUNK_SIZE bytes and writes them to the file
+ *
+ * Only one chunk of records exists at a time, so writing a checkpoint does not need a second copy of all particles.
+ * @tparam Record Type of the records
+ * @param file File to write to
+ * @param buffer Buffer of CHUNK_SIZE bytes, reused for all chunks
+ * @param count Number of records
+ * @param convert Function that creates the record with the given index
+ */
+template <typename Record, typename F>
+void writeRecords(std::ofstream &file, std::vector<char> &buffer, size_t count, F convert) {
+  constexpr size_t records_per_chunk = CHUNK_SIZE / sizeof(Record);
+  for (size_t first = 0; first < count && file.good(); first += records_per_chunk) {
+    const size_t n = std::min(records_per_chunk, count - first);
+#pragma omp parallel for schedule(static)
+    for (size_t i = 0; i < n; i++) {
+      const Record record = convert(first + i);
+      std::memcpy(buffer.data() + i * sizeof(Record), &record, sizeof(Record));
+    }
+    file.write(buffer.data(), static_cast<std::streamsize>(n * sizeof(Record)));
+  }
+}
+}  // namespace
+
+bool writeCheckpoint(const std::vector<Particle> &particles, const Settings &settings,
+                     const std::filesystem::path &filepath, std::uint64_t iteration, double time, double delta_t,
+                     const std::vector<std::pair<std::uint32_t, std::uint32_t>> &cell_order) {
+  const std::string yaml = encodeSettings(settings, time);
+  const auto &bonds = settings.membrane.bonds.bonds;
+
+  const checkpoint::Header header = {
+      checkpoint::MAGIC, checkpoint::VERSION, checkpoint::BYTE_ORDER_MARK, iteration,         time,
+      delta_t,           yaml.size(),         particles.size(),            bonds.size(), cell_order.size()};
+
+  auto tmp = filepath;
+  tmp += ".tmp";
+  {
+    std::ofstream file(tmp, std::ios::binary | std::ios::trunc);
+    if (!file.good()) {
+      SPDLOG_ERROR("Failed to open {}", tmp.string());
+      return false;
+    }
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    file.write(yaml.data(), static_cast<std::streamsize>(yaml.size()));
+
+    std::vector<char> buffer(CHUNK_SIZE);
+    writeRecords<checkpoint::ParticleRecord>(file, buffer, particles.size(), [&](size_t i) {
+      const Particle &p = particles[i];
+      return checkpoint::ParticleRecord{p.getX(),       p.getV(),     p.getF(),    p.getOldF(), p.getM(),
+                                        p.getEpsilon(), p.getSigma(), p.getType(), p.getState()};
+    });
+    writeRecords<checkpoint::BondRecord>(file, buffer, bonds.size(), [&](size_t b) {
+      const Bond &bond = bonds[b];
+      return checkpoint::BondRecord{bond.i, bond.j, static_cast<std::uint32_t>(bond.type), 0, bond.rest_length};
+    });
+    writeRecords<checkpoint::CellRecord>(file, buffer, cell_order.size(), [&](size_t i) {
+      return checkpoint::CellRecord{cell_order[i].first, cell_order[i].second};
+    });
+    if (!file.good()) {
+      SPDLOG_ERROR("Failed to write checkpoint {}", tmp.string());
+      return false;
+    }
+  }
+
+  std::error_code error;
+  std::filesystem::rename(tmp, filepath, error);
+  if (error) {
+    SPDLOG_ERROR("Failed to move checkpoint to {}: {}", filepath.string(), error.message());
+    return false;
+  }
+
+  SPDLOG_INFO("Wrote checkpoint {} at t={}", filepath.string(), time);
+  return true;
+}
+
+}  // namespace outputWriter
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <utility>
+#include <vector>
+
+#include "Particle.h"
+#include "Settings.h"
+
+namespace outputWriter {
+
+/**
+ * @brief Writes a binary checkpoint of the simulation
+ *
+ * The checkpoint is first written to `<filepath>.tmp` and then renamed, so an interrupted write never replaces the
+ * previous checkpoint. Random initializations (brownian motion, initial temperature) are removed from the stored
+ * settings, so restoring the checkpoint continues the simulation instead of heating it up again.
+ *
+ * @param particles Particles of the simulation
+ * @param settings Settings of the simulation, including membrane bonds and force groups
+ * @param filepath Path of the checkpoint
+ * @param iteration Iteration the checkpoint is taken after
+ * @param time Current simulation time, restored as start time
+ * @param delta_t Timestep of the next iteration
+ * @param cell_order Order of the particles in the linked cells, see LinkedCells::getCellOrder()
+ * @return true if the checkpoint was written
+ *
+ * @see checkpoint for the file format
+ * @see CheckpointReader
+ */
+bool writeCheckpoint(const std::vector<Particle> &particles, const Settings &settings,
+                     const std::filesystem::path &filepath, std::uint64_t iteration, double time, double delta_t,
+                     const std::vector<std::pair<std::uint32_t, std::uint32_t>> &cell_order = {});
+
+}  // namespace outputWriter
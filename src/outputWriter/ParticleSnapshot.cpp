@@ -0,0 +1,31 @@
+#include "outputWriter/ParticleSnapshot.h"
+
+namespace outputWriter {
+
+void ParticleSnapshot::assign(const std::vector<Particle> &particles) {
+  const size_t n = particles.size();
+  x.resize(n);
+  v.resize(n);
+  f.resize(n);
+  m.resize(n);
+  type.resize(n);
+  state.resize(n);
+
+#pragma omp parallel for schedule(static)
+  for (size_t i = 0; i < n; i++) {
+    const Particle &p = particles[i];
+    x[i] = p.getX();
+    v[i] = p.getV();
+    f[i] = p.getF();
+    m[i] = p.getM();
+    type[i] = p.getType();
+    state[i] = p.getState();
+  }
+}
+
+size_t ParticleSnapshot::memoryUsage() const {
+  return (x.capacity() + v.capacity() + f.capacity()) * sizeof(Vector3) + m.capacity() * sizeof(double) +
+         (type.capacity() + state.capacity()) * sizeof(int);
+}
+
+}  // namespace outputWriter
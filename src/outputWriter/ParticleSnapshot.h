@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "Particle.h"
+
+namespace outputWriter {
+
+/**
+ * @struct ParticleSnapshot
+ * @brief Copy of the particle fields read by the output writers, stored as a struct of arrays
+ *
+ * Only the fields that are written to files are copied. Old forces and the Lennard-Jones parameters stay behind, and
+ * the copy does not run the copy constructor of Particle. Assigning new particles keeps the capacity of all arrays, so
+ * a reused snapshot does not allocate once it reached the size of the particle vector.
+ */
+struct ParticleSnapshot {
+  /** @brief Bytes one particle occupies in a snapshot */
+  static constexpr size_t BYTES_PER_PARTICLE = 3 * sizeof(Vector3) + sizeof(double) + 2 * sizeof(int);
+
+  /** @brief Position of every particle */
+  std::vector<Vector3> x;
+  /** @brief Velocity of every particle */
+  std::vector<Vector3> v;
+  /** @brief Force of every particle */
+  std::vector<Vector3> f;
+  /** @brief Mass of every particle */
+  std::vector<double> m;
+  /** @brief Type of every particle */
+  std::vector<int> type;
+  /** @brief State of every particle, see Particle::getState() */
+  std::vector<int> state;
+
+  ParticleSnapshot() = default;
+
+  /**
+   * @param particles Particles to copy
+   */
+  explicit ParticleSnapshot(const std::vector<Particle> &particles) { assign(particles); }
+
+  /**
+   * @brief Replaces the contents with the fields of the particles
+   * @param particles Particles to copy
+   */
+  void assign(const std::vector<Particle> &particles);
+
+  /**
+   * @return Number of particles in the snapshot
+   */
+  [[nodiscard]] size_t size() const { return x.size(); }
+
+  /**
+   * @return Bytes allocated by all arrays
+   */
+  [[nodiscard]] size_t memoryUsage() const;
+};
+
+}  // namespace outputWriter
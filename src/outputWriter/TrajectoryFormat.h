@@ -0,0 +1,102 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+/**
+ * @brief On-disk layout of the binary trajectory format (.trj)
+ *
+ * A trajectory file stores all plotted iterations of a run:
+ * ```
+ * FileHeader
+ * for every frame:
+ *   FrameHeader
+ *   positions   3 * particle_count values
+ *   velocities  3 * particle_count values
+ *   types       particle_count int32
+ * IndexEntry[frame_count]   (at FileHeader::index_offset)
+ * ```
+ * Values are float32 if SINGLE_PRECISION is set and float64 otherwise. With DELTA_ENCODING, the positions of frames
+ * that are not keyframes are stored as difference to the (decoded) positions of the previous frame, which keeps the
+ * deltas small and exactly reproducible. All numbers are stored in the byte order of the writing machine, which is
+ * checked with FileHeader::byte_order.
+ */
+namespace trajectory {
+
+/** @brief First bytes of every trajectory file */
+constexpr std::array<char, 8> MAGIC = {'M', 'O', 'L', 'S', 'I', 'M', 'T', 'R'};
+/** @brief Version of the format, increased on incompatible changes */
+constexpr std::uint32_t VERSION = 1;
+/** @brief Written as is, reads differently on a machine with another byte order */
+constexpr std::uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+/** @brief Values are stored as float32 instead of float64 */
+constexpr std::uint32_t SINGLE_PRECISION = 1 << 0;
+/** @brief Positions of non-keyframes are stored relative to the previous frame */
+constexpr std::uint32_t DELTA_ENCODING = 1 << 1;
+
+/**
+ * @struct FileHeader
+ * @brief Header at the start of the file
+ */
+struct FileHeader {
+  /** @brief Always MAGIC */
+  std::array<char, 8> magic;
+  /** @brief Always VERSION */
+  std::uint32_t version;
+  /** @brief Always BYTE_ORDER_MARK */
+  std::uint32_t byte_order;
+  /** @brief Combination of SINGLE_PRECISION and DELTA_ENCODING */
+  std::uint32_t flags;
+  /** @brief With DELTA_ENCODING, every keyframe_interval-th frame is stored with absolute positions */
+  std::uint32_t keyframe_interval;
+  /** @brief Number of frames, only valid if index_offset is set */
+  std::uint64_t frame_count;
+  /** @brief Offset of the frame index, 0 if the file was not closed properly */
+  std::uint64_t index_offset;
+};
+static_assert(sizeof(FileHeader) == 40, "FileHeader must not contain padding");
+
+/**
+ * @struct FrameHeader
+ * @brief Header in front of the data of every frame
+ */
+struct FrameHeader {
+  /** @brief Iteration of the frame */
+  std::uint64_t iteration;
+  /** @brief Simulation time of the frame */
+  double time;
+  /** @brief Number of particles in this frame */
+  std::uint64_t particle_count;
+  /** @brief 1 if the positions are absolute, 0 if they are relative to the previous frame */
+  std::uint32_t keyframe;
+  /** @brief Unused, makes the size of the header independent of padding */
+  std::uint32_t reserved;
+};
+static_assert(sizeof(FrameHeader) == 32, "FrameHeader must not contain padding");
+
+/**
+ * @struct IndexEntry
+ * @brief Entry of the frame index at the end of the file
+ */
+struct IndexEntry {
+  /** @brief Offset of the FrameHeader from the start of the file */
+  std::uint64_t offset;
+  /** @brief Iteration of the frame */
+  std::uint64_t iteration;
+  /** @brief Simulation time of the frame */
+  double time;
+};
+static_assert(sizeof(IndexEntry) == 24, "IndexEntry must not contain padding");
+
+/**
+ * @param flags flags of the file
+ * @param particle_count number of particles in the frame
+ * @return Size of the data of a frame without its header in bytes
+ */
+constexpr std::uint64_t frameDataSize(std::uint32_t flags, std::uint64_t particle_count) {
+  const std::uint64_t value_size = (flags & SINGLE_PRECISION) ? sizeof(float) : sizeof(double);
+  return particle_count * (6 * value_size + sizeof(std::int32_t));
+}
+
+}  // namespace trajectory
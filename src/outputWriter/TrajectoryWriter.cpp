@@ -0,0 +1,107 @@
+#include "outputWriter/TrajectoryWriter.h"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+
+namespace outputWriter {
+
+namespace {
+/**
+ * @brief Copies the bytes of a value to the given position of the buffer
+ * @return position after the value
+ */
+template <typename T>
+char *put(char *out, const T &value) {
+  std::memcpy(out, &value, sizeof(T));
+  return out + sizeof(T);
+}
+}  // namespace
+
+TrajectoryWriter::TrajectoryWriter(const std::filesystem::path &filename, const TrajectoryOptions &options)
+    : file(filename, std::ios::binary | std::ios::trunc),
+      flags((options.single_precision ? trajectory::SINGLE_PRECISION : 0) |
+            (options.delta_encoding ? trajectory::DELTA_ENCODING : 0)),
+      keyframe_interval(std::max(options.keyframe_interval, 1u)) {
+  if (!file.is_open()) {
+    SPDLOG_ERROR("Error opening {}", filename.string());
+    exit(EXIT_FAILURE);
+  }
+
+  // frame_count and index_offset are written by close()
+  const trajectory::FileHeader header = {
+      trajectory::MAGIC, trajectory::VERSION, trajectory::BYTE_ORDER_MARK, flags, keyframe_interval, 0, 0};
+  file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+}
+
+TrajectoryWriter::~TrajectoryWriter() { close(); }
+
+template <typename T>
+void TrajectoryWriter::encodeFrame(const ParticleSnapshot &particles, bool keyframe) {
+  const size_t n = particles.size();
+  char *positions = buffer.data() + sizeof(trajectory::FrameHeader);
+  char *velocities = positions + 3 * n * sizeof(T);
+  char *types = velocities + 3 * n * sizeof(T);
+
+#pragma omp parallel for schedule(static)
+  for (size_t i = 0; i < n; i++) {
+    char *x_out = positions + 3 * i * sizeof(T);
+    char *v_out = velocities + 3 * i * sizeof(T);
+    for (int d = 0; d < 3; d++) {
+      double &previous = previous_positions[3 * i + d];
+      // the reference is updated with the rounded value, so rounding errors do not accumulate over the deltas
+      const T x = keyframe ? static_cast<T>(particles.x[i][d]) : static_cast<T>(particles.x[i][d] - previous);
+      previous = keyframe ? static_cast<double>(x) : previous + static_cast<double>(x);
+      x_out = put(x_out, x);
+      v_out = put(v_out, static_cast<T>(particles.v[i][d]));
+    }
+    put(types + i * sizeof(std::int32_t), static_cast<std::int32_t>(particles.type[i]));
+  }
+}
+
+void TrajectoryWriter::writeFrame(const ParticleSnapshot &particles, int iteration, double time) {
+  if (!file.is_open()) {
+    SPDLOG_WARN("Trajectory is already closed, dropping iteration {}", iteration);
+    return;
+  }
+
+  const size_t n = particles.size();
+  // without delta encoding every frame is a keyframe. A changed particle count also starts a new reference
+  const bool keyframe = !(flags & trajectory::DELTA_ENCODING) || index.size() % keyframe_interval == 0 ||
+                        previous_positions.size() != 3 * n;
+
+  const trajectory::FrameHeader header = {static_cast<std::uint64_t>(iteration), time, n, keyframe, 0};
+  buffer.resize(sizeof(header) + trajectory::frameDataSize(flags, n));
+  put(buffer.data(), header);
+  previous_positions.resize(3 * n);
+
+  if (flags & trajectory::SINGLE_PRECISION) {
+    encodeFrame<float>(particles, keyframe);
+  } else {
+    encodeFrame<double>(particles, keyframe);
+  }
+
+  index.push_back({static_cast<std::uint64_t>(file.tellp()), header.iteration, time});
+  file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+}
+
+void TrajectoryWriter::close() {
+  if (!file.is_open()) return;
+
+  const auto index_offset = static_cast<std::uint64_t>(file.tellp());
+  file.write(reinterpret_cast<const char *>(index.data()),
+             static_cast<std::streamsize>(index.size() * sizeof(trajectory::IndexEntry)));
+
+  // patch frame_count and index_offset in the header
+  const std::uint64_t frame_count = index.size();
+  file.seekp(offsetof(trajectory::FileHeader, frame_count));
+  file.write(reinterpret_cast<const char *>(&frame_count), sizeof(frame_count));
+  file.write(reinterpret_cast<const char *>(&index_offset), sizeof(index_offset));
+  file.close();
+
+  SPDLOG_DEBUG("Wrote trajectory with {} frames", frame_count);
+}
+
+}  // namespace outputWriter
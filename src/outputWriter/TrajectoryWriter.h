@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+#include "outputWriter/ParticleSnapshot.h"
+#include "outputWriter/TrajectoryFormat.h"
+
+/**
+ * @brief Options of the binary trajectory output
+ */
+struct TrajectoryOptions {
+  /** @brief Store positions and velocities as float32 instead of float64 */
+  bool single_precision = true;
+  /** @brief Store positions relative to the previous frame */
+  bool delta_encoding = false;
+  /** @brief With delta encoding, every keyframe_interval-th frame is stored with absolute positions */
+  unsigned int keyframe_interval = 16;
+};
+
+namespace outputWriter {
+
+/**
+ * @class TrajectoryWriter
+ * This class writes all frames of a run into a single binary trajectory file
+ *
+ * @see trajectory for the file format
+ * @see TrajectoryReader
+ */
+class TrajectoryWriter {
+ public:
+  /**
+   * @brief Creates the file and writes the file header
+   * @param filename Path to the trajectory file
+   * @param options Encoding of the frames
+   */
+  TrajectoryWriter(const std::filesystem::path &filename, const TrajectoryOptions &options);
+
+  /**
+   * @brief Closes the file, if close() was not called before
+   */
+  ~TrajectoryWriter();
+
+  // Delete copy constructor and assignment operator
+  TrajectoryWriter(const TrajectoryWriter &) = delete;
+  TrajectoryWriter &operator=(const TrajectoryWriter &) = delete;
+
+  /**
+   * Appends a frame to the trajectory
+   * @param particles Particles to add to the output
+   * @param iteration Current iteration number
+   * @param time Current simulation time
+   */
+  void writeFrame(const ParticleSnapshot &particles, int iteration, double time);
+
+  /**
+   * @brief Writes the frame index and finalizes the header
+   */
+  void close();
+
+ private:
+  /** @brief Output file */
+  std::ofstream file;
+  /** @brief Combination of trajectory::SINGLE_PRECISION and trajectory::DELTA_ENCODING */
+  std::uint32_t flags;
+  /** @brief With delta encoding, every keyframe_interval-th frame is stored with absolute positions */
+  std::uint32_t keyframe_interval;
+  /** @brief Offset and metadata of all written frames */
+  std::vector<trajectory::IndexEntry> index;
+  /** @brief Positions of the previous frame as the reader will decode them, the reference for delta encoding */
+  std::vector<double> previous_positions;
+  /** @brief Reused buffer for the encoded frame, so each frame is written with a single call */
+  std::vector<char> buffer;
+
+  /**
+   * @brief Encodes the values of a frame into buffer
+   * @tparam T type of the stored values
+   */
+  template <typename T>
+  void encodeFrame(const ParticleSnapshot &particles, bool keyframe);
+};
+
+}  // namespace outputWriter
@@ -15,40 +15,59 @@
 #include <vtkPointData.h>
 #include <vtkXMLUnstructuredGridWriter.h>
 
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
 #include <iomanip>
 #include <sstream>
 
 namespace outputWriter {
 
-void VTKWriter::plotParticles(std::vector<Particle> &particles, const std::string &filename, int iteration) {
-  // Initialize points
-  auto points = vtkSmartPointer<vtkPoints>::New();
+void VTKWriter::plotParticles(const ParticleSnapshot &particles, const std::string &filename, int iteration,
+                              double time) {
+  const auto n = static_cast<vtkIdType>(particles.size());
+
+  // Create and configure data arrays. All arrays are allocated once with their final size, so they can be filled in
+  // parallel through their raw pointers
+  vtkNew<vtkFloatArray> positionArray;
+  positionArray->SetNumberOfComponents(3);
+  float *positions = positionArray->WritePointer(0, 3 * n);
 
-  // Create and configure data arrays
   vtkNew<vtkFloatArray> massArray;
   massArray->SetName("mass");
   massArray->SetNumberOfComponents(1);
+  float *masses = massArray->WritePointer(0, n);
 
   vtkNew<vtkFloatArray> velocityArray;
   velocityArray->SetName("velocity");
   velocityArray->SetNumberOfComponents(3);
+  float *velocities = velocityArray->WritePointer(0, 3 * n);
 
   vtkNew<vtkFloatArray> forceArray;
   forceArray->SetName("force");
   forceArray->SetNumberOfComponents(3);
+  float *forces = forceArray->WritePointer(0, 3 * n);
 
   vtkNew<vtkIntArray> typeArray;
   typeArray->SetName("type");
   typeArray->SetNumberOfComponents(1);
+  int *types = typeArray->WritePointer(0, n);
 
-  for (auto &p : particles) {
-    points->InsertNextPoint(p.getX().data());
-    massArray->InsertNextValue(static_cast<float>(p.getM()));
-    velocityArray->InsertNextTuple(p.getV().data());
-    forceArray->InsertNextTuple(p.getF().data());
-    typeArray->InsertNextValue(p.getType());
+#pragma omp parallel for schedule(static)
+  for (vtkIdType i = 0; i < n; i++) {
+    for (int d = 0; d < 3; d++) {
+      positions[3 * i + d] = static_cast<float>(particles.x[i][d]);
+      velocities[3 * i + d] = static_cast<float>(particles.v[i][d]);
+      forces[3 * i + d] = static_cast<float>(particles.f[i][d]);
+    }
+    masses[i] = static_cast<float>(particles.m[i]);
+    types[i] = particles.type[i];
   }
 
+  // Initialize points
+  auto points = vtkSmartPointer<vtkPoints>::New();
+  points->SetData(positionArray);
+
   // Set up the grid
   auto grid = vtkSmartPointer<vtkUnstructuredGrid>::New();
   grid->SetPoints(points);
@@ -67,10 +86,66 @@ void VTKWriter::plotParticles(std::vector<Particle> &particles, const std::strin
   vtkNew<vtkXMLUnstructuredGridWriter> writer;
   writer->SetFileName(strstr.str().c_str());
   writer->SetInputData(grid);
-  writer->SetDataModeToAscii();
+  switch (mode) {
+    case VTKDataMode::ASCII:
+      writer->SetDataModeToAscii();
+      break;
+    case VTKDataMode::BINARY:
+      writer->SetDataModeToBinary();
+      break;
+    case VTKDataMode::APPENDED:
+      writer->SetDataModeToAppended();
+      // write the appended data as raw bytes instead of base64
+      writer->EncodeAppendedDataOff();
+      break;
+  }
+  if (compression && mode != VTKDataMode::ASCII) {
+    writer->SetCompressorTypeToZLib();
+  } else {
+    writer->SetCompressorTypeToNone();
+  }
 
   // Write the file
   writer->Write();
+
+  timesteps.emplace_back(time, std::filesystem::path(strstr.str()).filename().string());
+  collection = filename;
+}
+
+VTKWriter::~VTKWriter() {
+  if (!timesteps.empty()) writeCollection();
+}
+
+void VTKWriter::writeCollection() const {
+  const std::string path = collection + ".pvd";
+
+  // keep the files of the interrupted run this run continues, later ones are replaced by the files of this run
+  std::vector<std::pair<double, std::string>> previous;
+  {
+    std::ifstream existing(path);
+    std::string line;
+    while (std::getline(existing, line)) {
+      const auto time = line.find("timestep=\"");
+      const auto vtu = line.find("file=\"");
+      if (time == std::string::npos || vtu == std::string::npos) continue;
+      const double t = std::strtod(line.c_str() + time + 10, nullptr);
+      const auto begin = vtu + 6;
+      if (t < timesteps.front().first) previous.emplace_back(t, line.substr(begin, line.find('"', begin) - begin));
+    }
+  }
+
+  std::ofstream file(path);
+  file << "<?xml version=\"1.0\"?>\n";
+  file << "<VTKFile type=\"Collection\" version=\"0.1\" byte_order=\"LittleEndian\">\n";
+  file << "  <Collection>\n";
+  file << std::setprecision(17);
+  previous.insert(previous.end(), timesteps.begin(), timesteps.end());
+  for (const auto &[time, vtu] : previous) {
+    file << "    <DataSet timestep=\"" << time << "\" group=\"\" part=\"0\" file=\"" << vtu << "\"/>\n";
+  }
+  file << "  </Collection>\n";
+  file << "</VTKFile>\n";
+  if (!file.good()) SPDLOG_ERROR("Failed to write {}", path);
 }
 }  // namespace outputWriter
 #endif
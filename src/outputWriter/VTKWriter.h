@@ -6,15 +6,69 @@
  */
 
 #pragma once
-#ifdef ENABLE_VTK_OUTPUT
 
-#include <vtkSmartPointer.h>
-#include <vtkUnstructuredGrid.h>
+#include <spdlog/spdlog.h>
 
 #include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
-#include "Particle.h"
+/**
+ * @brief Encoding of the data arrays in a .vtu file
+ */
+enum class VTKDataMode {
+  /** @brief Human readable text inside the XML, large and slow */
+  ASCII,
+  /** @brief Base64 encoded binary data inside the XML elements */
+  BINARY,
+  /** @brief Raw binary data appended after the XML, smallest and fastest */
+  APPENDED
+};
+
+/**
+ * Transform a String, that represents a VTKDataMode into a VTKDataMode Enum
+ * @param str String that represents a data mode
+ * @return ENUM Object VTKDataMode
+ */
+inline VTKDataMode string_to_vtk_data_mode(std::string str) {
+  const std::unordered_map<std::string, VTKDataMode> lookup = {
+      {"ascii", VTKDataMode::ASCII},
+      {"binary", VTKDataMode::BINARY},
+      {"appended", VTKDataMode::APPENDED},
+  };
+
+  auto x = lookup.find(str);
+  if (x == lookup.end()) {
+    SPDLOG_WARN("Invalid vtk data mode \"{}\"", str);
+    return VTKDataMode::APPENDED;
+  }
+
+  return x->second;
+}
+
+/**
+ * Transform a VTKDataMode Enum into the string used in input files
+ * @param mode
+ * @return name of the data mode
+ */
+inline std::string vtk_data_mode_to_string(VTKDataMode mode) {
+  switch (mode) {
+    case VTKDataMode::ASCII:
+      return "ascii";
+    case VTKDataMode::BINARY:
+      return "binary";
+    default:
+      return "appended";
+  }
+}
+
+#ifdef ENABLE_VTK_OUTPUT
+
+#include <vtkSmartPointer.h>
+#include <vtkUnstructuredGrid.h>
+
+#include "outputWriter/ParticleSnapshot.h"
 
 namespace outputWriter {
 
@@ -22,23 +76,54 @@ namespace outputWriter {
  * @class VTKWriter
  * This class implements the functionality to generate vtk output from
  * particles using the official VTK library.
+ *
+ * Besides the .vtu file of every plotted iteration, the writer creates a ParaView collection (.pvd) that lists all
+ * written files with their simulation time, so a run can be opened in ParaView as a single time series.
  */
 class VTKWriter {
  public:
-  VTKWriter() = default;
-  ~VTKWriter() = default;
+  /**
+   * @param mode Encoding of the data arrays
+   * @param compression Compress the data arrays with zlib. Ignored in ascii mode
+   */
+  explicit VTKWriter(VTKDataMode mode = VTKDataMode::APPENDED, bool compression = true)
+      : mode(mode), compression(compression) {}
+
+  /**
+   * Writes the collection of all files written by this writer
+   */
+  ~VTKWriter();
 
   // Delete copy constructor and assignment operator
   VTKWriter(const VTKWriter &) = delete;
   VTKWriter &operator=(const VTKWriter &) = delete;
 
   /**
-   * Write VTK output of particles.
+   * Write VTK output of particles and add it to the collection <filename>.pvd
    * @param particles Particles to add to the output
    * @param filename Output filename
    * @param iteration Current iteration number
+   * @param time Current simulation time, stored as timestep in the collection
+   */
+  void plotParticles(const ParticleSnapshot &particles, const std::string &filename, int iteration, double time);
+
+ private:
+  /** @brief Encoding of the data arrays */
+  VTKDataMode mode;
+  /** @brief Compress the data arrays */
+  bool compression;
+  /** @brief Simulation time and file name (relative to the collection) of every written file */
+  std::vector<std::pair<double, std::string>> timesteps;
+  /** @brief Output filename of the collection without extension */
+  std::string collection;
+
+  /**
+   * Write the collection file with all timesteps of this writer
+   *
+   * Files of an existing collection with an earlier time than the first file of this writer are kept, so a simulation
+   * continued from a checkpoint extends the collection of the interrupted run instead of replacing it.
    */
-  void plotParticles(std::vector<Particle> &particles, const std::string &filename, int iteration);
+  void writeCollection() const;
 };
 
 }  // namespace outputWriter
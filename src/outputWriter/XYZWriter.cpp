@@ -7,39 +7,106 @@
 
 #include "outputWriter/XYZWriter.h"
 
+#include <fcntl.h>
+#include <omp.h>
+#include <spdlog/spdlog.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <climits>
 #include <iomanip>
 #include <sstream>
 
 namespace outputWriter {
 
+namespace {
+/** @brief Upper bound for the length of a line: "Ar " and three numbers with up to 13 characters plus separators */
+constexpr size_t MAX_LINE_LENGTH = 64;
+
+/**
+ * @brief Formats the line of a particle
+ * @return End of the written line
+ */
+char *formatParticle(char *out, const Vector3 &x) {
+  *out++ = 'A';
+  *out++ = 'r';
+  for (const double xi : x) {
+    *out++ = ' ';
+    // same precision as the default precision of streams
+    out = std::to_chars(out, out + 16, xi, std::chars_format::general, 6).ptr;
+  }
+  *out++ = '\n';
+  return out;
+}
+
+/**
+ * @brief Writes all buffers, usually with a single system call
+ * @return false if writing failed
+ */
+bool writeAll(const int fd, std::vector<iovec> &parts) {
+  size_t first = 0;
+  while (first < parts.size()) {
+    const auto count = static_cast<int>(std::min<size_t>(parts.size() - first, IOV_MAX));
+    ssize_t written = writev(fd, parts.data() + first, count);
+    if (written < 0) {
+      if (errno == EINTR) continue;
+      return false;
+    }
+    // skip the completely written parts and continue a partially written one
+    while (first < parts.size() && static_cast<size_t>(written) >= parts[first].iov_len) {
+      written -= static_cast<ssize_t>(parts[first].iov_len);
+      first++;
+    }
+    if (first < parts.size()) {
+      parts[first].iov_base = static_cast<char *>(parts[first].iov_base) + written;
+      parts[first].iov_len -= written;
+    }
+  }
+  return true;
+}
+}  // namespace
+
 XYZWriter::XYZWriter() = default;
 
 XYZWriter::~XYZWriter() = default;
 
-void XYZWriter::plotParticles(std::vector<Particle> &particles, const std::string &filename, int iteration) {
-  std::ofstream file;
+void XYZWriter::plotParticles(const ParticleSnapshot &particles, const std::string &filename, int iteration) {
   std::stringstream strstr;
   strstr << filename << "_" << std::setfill('0') << std::setw(4) << iteration << ".xyz";
 
-  file.open(strstr.str().c_str());
-  file << particles.size() << std::endl;
-  file << "Generated by MolSim. See http://openbabel.org/wiki/XYZ_(format) for "
-          "file format doku."
-       << std::endl;
+  const std::string header =
+      std::to_string(particles.size()) +
+      "\nGenerated by MolSim. See http://openbabel.org/wiki/XYZ_(format) for file format doku.\n";
 
-  for (auto &p : particles) {
-    std::array<double, 3> x = p.getX();
-    file << "Ar ";
-    file.setf(std::ios_base::showpoint);
+  // every thread formats a contiguous block of particles, so the buffers are already in file order
+  const size_t n = particles.size();
+#pragma omp parallel
+  {
+    const auto threads = static_cast<size_t>(omp_get_num_threads());
+    const auto thread = static_cast<size_t>(omp_get_thread_num());
+#pragma omp single
+    buffers.resize(threads);
 
-    for (auto &xi : x) {
-      file << xi << " ";
-    }
-
-    file << std::endl;
+    std::vector<char> &buffer = buffers[thread];
+    const size_t begin = n * thread / threads;
+    const size_t end = n * (thread + 1) / threads;
+    buffer.resize((end - begin) * MAX_LINE_LENGTH);
+    char *out = buffer.data();
+    for (size_t i = begin; i < end; i++) out = formatParticle(out, particles.x[i]);
+    buffer.resize(out - buffer.data());
   }
 
-  file.close();
+  std::vector<iovec> parts = {{const_cast<char *>(header.data()), header.size()}};
+  for (auto &buffer : buffers) parts.push_back({buffer.data(), buffer.size()});
+
+  const int fd = open(strstr.str().c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0 || !writeAll(fd, parts)) {
+    SPDLOG_ERROR("Failed to write {}", strstr.str());
+  }
+  if (fd >= 0) close(fd);
 }
 
 }  // namespace outputWriter
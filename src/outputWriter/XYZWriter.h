@@ -7,17 +7,19 @@
 
 #pragma once
 
-#include <fstream>
+#include <string>
 #include <vector>
 
-#include "Particle.h"
+#include "outputWriter/ParticleSnapshot.h"
 
 namespace outputWriter {
 
 /**
  * @class XYZWriter
  *
- * This class implements functionality to generate xyz output from a particle vector
+ * This class implements functionality to generate xyz output from a snapshot of the particles.
+ * The lines are formatted in parallel with std::to_chars and every file is written with a single system call. Called
+ * from an AsyncWriter, the team of the calling thread is limited to one thread and the lines are formatted serially.
  */
 class XYZWriter {
  public:
@@ -31,7 +33,11 @@ class XYZWriter {
    * @param filename Output filename
    * @param iteration Current iteration number
    */
-  void plotParticles(std::vector<Particle> &particles, const std::string &filename, int iteration);
+  void plotParticles(const ParticleSnapshot &particles, const std::string &filename, int iteration);
+
+ private:
+  /** @brief Formatted lines of every thread, kept between frames to avoid allocations */
+  std::vector<std::vector<char>> buffers;
 };
 
 }  // namespace outputWriter
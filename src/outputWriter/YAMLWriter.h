@@ -17,18 +17,32 @@ void exportYAML(std::vector<Particle> &particles, Settings &settings, std::files
   node["output"] = settings.output;
   node["simulation"] = settings.simulation;
   node["useAlternateParallelisation"] = settings.useAlternateParallelisation;
-
-  YAML::Node sequence(YAML::NodeType::Sequence);
-  for (auto &p : particles) {
-    YAML::Node map = YAML::Node(YAML::NodeType::Map);
-    map["single"] = p;
-    sequence.push_back(map);
-  }
-
-  node["particles"] = sequence;
+  for (auto &group : settings.force_groups) node["force_groups"].push_back(group);
 
   YAML::Emitter out;
-  out << node;
+  out << YAML::BeginMap;
+  for (const auto &entry : node) out << YAML::Key << entry.first << YAML::Value << entry.second;
+
+  // the particles are emitted directly instead of building a node for each of them
+  const auto vector = [&out](const char *key, const Vector3 &value) {
+    out << YAML::Key << key << YAML::Value << YAML::Flow << YAML::BeginSeq << value[0] << value[1] << value[2]
+        << YAML::EndSeq;
+  };
+  out << YAML::Key << "particles" << YAML::Value << YAML::BeginSeq;
+  for (const auto &p : particles) {
+    out << YAML::BeginMap << YAML::Key << "single" << YAML::Value << YAML::BeginMap;
+    vector("position", p.getX());
+    vector("velocity", p.getV());
+    vector("force", p.getF());
+    vector("old_force", p.getOldF());
+    out << YAML::Key << "mass" << YAML::Value << p.getM();
+    out << YAML::Key << "sigma" << YAML::Value << p.getSigma();
+    out << YAML::Key << "epsilon" << YAML::Value << p.getEpsilon();
+    out << YAML::Key << "type" << YAML::Value << p.getType();
+    if (p.isStatic()) out << YAML::Key << "static" << YAML::Value << true;
+    out << YAML::EndMap << YAML::EndMap;
+  }
+  out << YAML::EndSeq << YAML::EndMap;
 
   std::ofstream file(filepath);
   if (!file.good()) {
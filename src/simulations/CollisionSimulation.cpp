@@ -11,17 +11,23 @@
 void CollisionSimulation::updateF() {
   container.applyToParticles([](Particle &p) { p.setF({0, 0, 0}); });
   container.applyToPairs([this](Particle &p1, Particle &p2) {
-    double sigma = Physics::LorentzBerthelot::sigma(p1.getSigma(), p2.getSigma());
-    double epsilon = Physics::LorentzBerthelot::epsilon(p1.getEpsilon(), p2.getEpsilon());
-    const Vector3 f = Physics::LennardJones::force(p1, p2, sigma, epsilon);
+    const Vector3 f = pairForce(p1, p2);
     p1.addF(f);
     p2.subF(f);
   });
 }
 
+Vector3 CollisionSimulation::pairForce(Particle &p1, Particle &p2) {
+  double sigma = Physics::LorentzBerthelot::sigma(p1.getSigma(), p2.getSigma());
+  double epsilon = Physics::LorentzBerthelot::epsilon(p1.getEpsilon(), p2.getEpsilon());
+  return Physics::LennardJones::force(p1, p2, sigma, epsilon);
+}
+
 void CollisionSimulation::initializeBrownianMotion(const double brown_motion_avg_velocity) {
-  container.applyToParticles([brown_motion_avg_velocity](Particle &p) {
-    const Vector3 v = maxwellBoltzmannDistributedVelocity(brown_motion_avg_velocity, 2);
+  const std::uint32_t stream = random_stream++;
+  container.applyToParticles([this, brown_motion_avg_velocity, stream](Particle &p) {
+    const size_t id = &p - particles.data();
+    const Vector3 v = maxwellBoltzmannDistributedVelocity(brown_motion_avg_velocity, 2, id, stream);
     p.setV(p.getV() + v);
   });
 }
@@ -42,6 +42,14 @@ class CollisionSimulation : public PlanetSimulation {
    */
   void updateF() override;
 
+  /**
+   * @brief Lennard-Jones force that p2 exerts on p1, with Lorentz-Berthelot mixing
+   * @param p1
+   * @param p2
+   * @return Vector3 force on p1
+   */
+  Vector3 pairForce(Particle &p1, Particle &p2) override;
+
   /**
    * @brief Add brownian motion
    *
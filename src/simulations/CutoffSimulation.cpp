@@ -15,13 +15,17 @@ void CutoffSimulation::iteration() {
   updateX();
   SPDLOG_DEBUG("Updating Forces");
   updateF();
+  applyForceGroups();
   SPDLOG_DEBUG("Updating Velocities");
   updateV();
 }
 
 void CutoffSimulation::updateF() {
-  // set the force of all particles to zero
-  linkedCells.applyToParticles([this](Particle &p) { p.setF({0, g_grav * p.getM(), 0}); });
+  {
+    // set the force of all particles to zero
+    PhaseTimers::ScopedTimer timer(PhaseTimers::RESET_F);
+    linkedCells.applyToParticles([this](Particle &p) { p.setF({0, g_grav * p.getM(), 0}); });
+  }
 
   linkedCells.applyToPairs([this](Particle &p1, Particle &p2) {
     double sigma = Physics::LorentzBerthelot::sigma(p1.getSigma(), p2.getSigma());
@@ -36,19 +40,29 @@ void CutoffSimulation::updateF() {
   });
 }
 
+void CutoffSimulation::applyForceGroups() {
+  if (force_groups.empty()) return;
+  PhaseTimers::ScopedTimer timer(PhaseTimers::FORCE_GROUPS);
+  // current_time is the start of this iteration, the new forces belong to its end
+  for (const auto &group : force_groups) group.apply(particles, current_time + delta_t);
+}
+
 void CutoffSimulation::updateX() {
-  linkedCells.applyToParticles([this](Particle &p) {
+  PhaseTimers::ScopedTimer timer(PhaseTimers::UPDATE_X);
+  linkedCells.applyToMobileParticles([this](Particle &p) {
     if (p.getState() < 0) return;
     SPDLOG_TRACE("Updating X:");
     SPDLOG_TRACE("-> Old Position: ({},{},{})", p.getX()[0], p.getX()[1], p.getX()[2]);
     p.setX(Physics::StoermerVerlet::position(p, delta_t));
     SPDLOG_TRACE("-> New: ({},{},{})", p.getX()[0], p.getX()[1], p.getX()[2]);
   });
+  timer.stop();
   linkedCells.moveParticles();
 }
 
 void CutoffSimulation::updateV() {
-  linkedCells.applyToParticles([this](Particle &p) {
+  PhaseTimers::ScopedTimer timer(PhaseTimers::UPDATE_V);
+  linkedCells.applyToMobileParticles([this](Particle &p) {
     if (p.getState() < 0) return;
     SPDLOG_TRACE("Updating V:");
     SPDLOG_TRACE("-> Old Velocity: ({},{},{})", p.getV()[0], p.getV()[1], p.getV()[2]);
@@ -57,8 +71,24 @@ void CutoffSimulation::updateV() {
   });
 }
 
+std::pair<double, double> CutoffSimulation::calculateMaxVelocityAndAcceleration() {
+  double v2_max = 0;
+  double a2_max = 0;
+#pragma omp parallel for reduction(max : v2_max, a2_max)
+  for (auto &p : particles) {
+    if (p.getState() != 0) continue;
+    const Vector3 &v = p.getV();
+    const Vector3 a = (1 / p.getM()) * p.getF();
+    v2_max = std::max(v2_max, v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+    a2_max = std::max(a2_max, a[0] * a[0] + a[1] * a[1] + a[2] * a[2]);
+  }
+  return {std::sqrt(v2_max), std::sqrt(a2_max)};
+}
+
 void CutoffSimulation::initializeBrownianMotion(double brown_motion_avg_velocity) {
-  linkedCells.applyToParticles([this, brown_motion_avg_velocity](Particle &p) {
-    p.setV(p.getV() + maxwellBoltzmannDistributedVelocity(brown_motion_avg_velocity, (is2D ? 2 : 3)));
+  const std::uint32_t stream = random_stream++;
+  linkedCells.applyToMobileParticles([this, brown_motion_avg_velocity, stream](Particle &p) {
+    const size_t id = &p - particles.data();
+    p.setV(p.getV() + maxwellBoltzmannDistributedVelocity(brown_motion_avg_velocity, (is2D ? 2 : 3), id, stream));
   });
 }
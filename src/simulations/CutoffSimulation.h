@@ -8,6 +8,7 @@
 
 #include "container/linkedCells/LinkedCells.h"
 #include "container/linkedCells/LinkedCellsV2.h"
+#include "simulations/ForceGroup.h"
 #include "simulations/Simulation.h"
 #include "simulations/Thermostat.h"
 
@@ -39,6 +40,10 @@ class CutoffSimulation : public Simulation {
    * reference to the particles vector
    */
   std::vector<Particle> &particles;
+  /**
+   * External forces acting on groups of particles
+   */
+  std::vector<ForceGroup> force_groups;
 
  public:
   // TODO: bisschen scuffed mit der repulsing distance, weiß nicht ob das funktioniert aber versuche es mal so und
@@ -87,11 +92,27 @@ class CutoffSimulation : public Simulation {
    */
   void updateV() override;
 
+  /**
+   * @copydoc Simulation::calculateMaxVelocityAndAcceleration()
+   */
+  std::pair<double, double> calculateMaxVelocityAndAcceleration() override;
+
   /**
    * @brief getter for the tests
    */
   LinkedCells &getLinkedCells() { return linkedCells; }
 
+  /**
+   * @brief Sets the external force groups, which are applied after every force calculation
+   * @param groups force groups with resolved particle indices
+   */
+  void setForceGroups(const std::vector<ForceGroup> &groups) { force_groups = groups; }
+
+  /**
+   * @brief Adds the forces of all active force groups to their particles
+   */
+  void applyForceGroups();
+
   /**
    * Initializes the brownian motion
    */
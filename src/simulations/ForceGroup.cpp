@@ -0,0 +1,67 @@
+#include "simulations/ForceGroup.h"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+
+#include "utils/ArrayUtils.h"
+
+void ForceGroup::resolve(const std::vector<Particle> &particles, const GeneratorTags &tags) {
+  indices.clear();
+
+  std::vector<std::array<size_t, 2>> ranges = {{0, particles.size()}};
+  if (selector.tag) {
+    auto tag = tags.find(selector.tag.value());
+    if (tag == tags.end()) {
+      SPDLOG_WARN("Force group references unknown tag \"{}\"", selector.tag.value());
+      return;
+    }
+    ranges = tag->second;
+  }
+
+  auto matches = [this, &particles](const size_t i) {
+    if (selector.index_range && (i < selector.index_range.value()[0] || i >= selector.index_range.value()[1]))
+      return false;
+    if (selector.indices && !std::binary_search(selector.indices->begin(), selector.indices->end(), i)) return false;
+    if (selector.region) {
+      const auto &[min, max] = selector.region.value();
+      const Vector3 &x = particles[i].getX();
+      for (int d = 0; d < 3; d++) {
+        if (x[d] < min[d] || x[d] > max[d]) return false;
+      }
+    }
+    return true;
+  };
+
+  if (selector.indices) std::sort(selector.indices->begin(), selector.indices->end());
+  for (const auto &[first, last] : ranges) {
+    for (size_t i = first; i < std::min(last, particles.size()); i++) {
+      if (matches(i)) indices.push_back(i);
+    }
+  }
+  // tagged ranges may overlap if a tag is used multiple times
+  std::sort(indices.begin(), indices.end());
+  indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+
+  if (indices.empty()) SPDLOG_WARN("Force group does not contain any particles");
+  SPDLOG_DEBUG("Force group with {} particles", indices.size());
+}
+
+Vector3 ForceGroup::forceAt(const double time) const {
+  if (!force_end) return force;
+  const double s = std::clamp((time - start_time) / (end_time - start_time), 0.0, 1.0);
+  return (1 - s) * force + s * force_end.value();
+}
+
+void ForceGroup::apply(std::vector<Particle> &particles, const double time) const {
+  if (!isActive(time)) return;
+  const Vector3 f = forceAt(time);
+
+  // indices are unique, so no two threads write to the same particle
+#pragma omp parallel for schedule(static)
+  for (size_t k = 0; k < indices.size(); k++) {
+    Particle &p = particles[indices[k]];
+    if (p.getState() != 0) continue;
+    p.addF(f);
+  }
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <array>
+#include <limits>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Particle.h"
+
+/**
+ * @brief Particle ranges [first, last) generated by each tagged generator entry
+ */
+using GeneratorTags = std::unordered_map<std::string, std::vector<std::array<size_t, 2>>>;
+
+/**
+ * @struct ForceGroupSelector
+ * @brief Describes which particles belong to a force group
+ *
+ * All given criteria have to match, e.g. a region and a tag select all particles of the tagged generator entries inside
+ * the region.
+ */
+struct ForceGroupSelector {
+  /** @brief Particles with an index in [first, last) */
+  std::optional<std::array<size_t, 2>> index_range;
+  /** @brief Particles with one of the given indices */
+  std::optional<std::vector<size_t>> indices;
+  /** @brief Particles inside the box [min, max] at the time the input is read */
+  std::optional<std::array<Vector3, 2>> region;
+  /** @brief Particles generated by an input entry with the given tag */
+  std::optional<std::string> tag;
+};
+
+/**
+ * @struct ForceGroup
+ * @brief External force acting on a group of particles during a time window
+ *
+ * The particles are selected once when the input is read and stored as an index list, so applying the force costs
+ * O(group size) per iteration.
+ */
+struct ForceGroup {
+  /** @brief Selection criteria of the group */
+  ForceGroupSelector selector;
+  /** @brief Indices of the selected particles, filled by resolve() */
+  std::vector<size_t> indices;
+
+  /** @brief Force acting on each particle at start_time */
+  Vector3 force = {0, 0, 0};
+  /** @brief If set, the force is ramped linearly from force at start_time to force_end at end_time */
+  std::optional<Vector3> force_end;
+  /** @brief Time when the force starts acting */
+  double start_time = 0;
+  /** @brief Time when the force stops acting */
+  double end_time = std::numeric_limits<double>::infinity();
+
+  /**
+   * @brief Fills indices with all particles matching the selector
+   * @param particles all particles of the simulation
+   * @param tags particle ranges of the tagged generator entries
+   */
+  void resolve(const std::vector<Particle> &particles, const GeneratorTags &tags);
+
+  /**
+   * @param time current simulation time
+   * @return true if the force acts at the given time
+   */
+  [[nodiscard]] bool isActive(double time) const { return time >= start_time && time < end_time; }
+
+  /**
+   * @param time current simulation time
+   * @return Force acting on each particle of the group at the given time
+   */
+  [[nodiscard]] Vector3 forceAt(double time) const;
+
+  /**
+   * @brief Adds the force to all particles of the group, if the group is active
+   * @param particles all particles of the simulation
+   * @param time current simulation time
+   */
+  void apply(std::vector<Particle> &particles, double time) const;
+};
@@ -5,38 +5,22 @@
 #include "MembraneSimulation.h"
 
 void MembraneSimulation::updateF() {
-  // Kann ich direkt updateF vom Parent aufrufen?
-  // linkedCells.applyToParticles([this](Particle &p) { p.setF({0, g_grav * p.getM(), 0}); });
-  linkedCells.applyToParticles([this](Particle &p1) {
-    // Zuerst alle Particle Kräfte wieder 0en
-    // Soll die Gravity in 3D immer in Z-Richtung verlaufen?
-    double current_time = start_time + delta_t * current_iteration;
-    if (current_time < 150
-        // Schau nach, ob auf das Particle F_zUP wirken soll
-        // Vergleiche auf Pointer Gleichheit
-        && (std::find(this->upwardsParticles.begin(), this->upwardsParticles.end(), &p1) !=
-            this->upwardsParticles.end())) {
-      p1.setF({0, 0, g_grav * p1.getM() + F_zUp});
-    } else {
-      p1.setF({0, 0, g_grav * p1.getM()});
-    }
+  // Zuerst alle Particle Kräfte wieder 0en
+  // Soll die Gravity in 3D immer in Z-Richtung verlaufen?
+  {
+    PhaseTimers::ScopedTimer timer(PhaseTimers::RESET_F);
+    linkedCells.applyToParticles([this](Particle &p) { p.setF({0, 0, g_grav * p.getM()}); });
+  }
 
-    // Kraft zwischen Nachbarn
-#pragma unroll
-    for (int i = 0; i < 8; i++) {
-      // Ohne N3 Optimierung, um einen Iterationsdurchlauf zu sparen
-      Particle *p2 = p1.getNeighbor(i);
-      if (p2 == nullptr) continue;
-      Vector3 f = {0.0, 0.0, 0.0};
-      // Diagonal Neighbors
-      if (i == 0 || i == 2 || i == 5 || i == 7)
-        f = Physics::harmonicPotential::forceDiagonal(p1, *p2, this->stiffnessConstant, r0);
-      // Direct Neighbors
-      else
-        f = Physics::harmonicPotential::forceStraight(p1, *p2, this->stiffnessConstant, r0);
+  // Kraft zwischen Nachbarn, jede Bindung nur einmal (N3)
+  {
+    PhaseTimers::ScopedTimer timer(PhaseTimers::BONDS);
+    bonds.applyToBonds(particles, [this](Particle &p1, Particle &p2, const Bond &bond) {
+      const Vector3 f = Physics::harmonicPotential::force(p1, p2, this->stiffnessConstant, bond.rest_length);
       p1.addF(f);
-    }
-  });
+      p2.subF(f);
+    });
+  }
 
   // Reguläre Lennard-Jones Force -> Kleinerer Cutoff Radius wird dem Konstruktor übergeben
   linkedCells.applyToPairs([this](Particle &p1, Particle &p2) {
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cmath>
+
 #include "Particle.h"
 #include "utils/ArrayUtils.h"
 
@@ -9,6 +11,21 @@
  */
 namespace Physics {
 
+/**
+ * @brief Calculate the kinetic energy of a particle
+ *
+ * \f[
+ *   E_{kin} = \frac{m_i \langle v_i, v_i \rangle}{2}
+ * \f]
+ *
+ * @param p
+ * @return double
+ */
+inline double kineticEnergy(const Particle &p) {
+  const Vector3 &v = p.getV();
+  return 0.5 * p.getM() * (v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+}
+
 namespace StoermerVerlet {
 /**
  * @brief Calculate the new position
@@ -45,6 +62,68 @@ inline Vector3 velocity(Particle &p, double delta_t) {
 }
 }  // namespace StoermerVerlet
 
+/**
+ * @brief Building blocks for symplectic splitting integrators
+ *
+ * Higher order integrators are compositions of drift (position update with constant velocity) and kick (velocity
+ * update with constant force) steps with fractional timesteps.
+ */
+namespace Symplectic {
+/**
+ * @brief Move a particle with constant velocity
+ *
+ * \f[
+ *   x_i \leftarrow x_i + h \cdot v_i
+ * \f]
+ *
+ * @param p
+ * @param h (fractional) timestep
+ * @return Vector3
+ */
+inline Vector3 drift(Particle &p, double h) { return p.getX() + h * p.getV(); }
+
+/**
+ * @brief Accelerate a particle with its current force
+ *
+ * \f[
+ *   v_i \leftarrow v_i + h \frac{F_i}{m_i}
+ * \f]
+ *
+ * @param p
+ * @param h (fractional) timestep
+ * @return Vector3
+ */
+inline Vector3 kick(Particle &p, double h) { return p.getV() + (h / p.getM()) * p.getF(); }
+
+/**
+ * @brief Weights of the 4th order triple jump composition of Stoermer-Verlet steps (Yoshida 1990, Forest & Ruth 1990)
+ *
+ * One step of size \f$ \Delta t \f$ consists of three Stoermer-Verlet steps of size
+ * \f$ w_1 \Delta t, w_0 \Delta t, w_1 \Delta t \f$
+ */
+namespace Yoshida4 {
+/** @brief weight of the outer steps \f$ w_1 = \frac{1}{2 - \sqrt[3]{2}} \f$ */
+inline const double w1 = 1 / (2 - std::cbrt(2.0));
+/** @brief weight of the (negative) middle step \f$ w_0 = -\frac{\sqrt[3]{2}}{2 - \sqrt[3]{2}} \f$ */
+inline const double w0 = -std::cbrt(2.0) / (2 - std::cbrt(2.0));
+}  // namespace Yoshida4
+
+/**
+ * @brief Coefficients of the position extended Forest-Ruth like integrator (Omelyan, Mryglod & Folk 2002)
+ *
+ * 4th order with four force evaluations per step, but an error constant about two orders of magnitude smaller than the
+ * triple jump.
+ */
+namespace PEFRL {
+/** @brief ξ */
+constexpr double xi = 0.1786178958448091;
+/** @brief λ */
+constexpr double lambda = -0.2123418310626054;
+/** @brief χ */
+constexpr double chi = -0.06626458266981849;
+}  // namespace PEFRL
+}  // namespace Symplectic
+
 namespace Planet {
 /**
  * @brief Calculate the force between two planets
@@ -157,16 +236,23 @@ inline double epsilon(double epsilon_i, double epsilon_j) { return std::sqrt(eps
 namespace harmonicPotential {
 inline double sqrt2 = std::sqrt(2);
 
-inline Vector3 forceStraight(Particle &p1, Particle &p2, double k, double r0) {
-  Vector3 dist = p2.getX() - p1.getX();  // norm of x2 - x1 = norm of x1 - x2
-  double norm = ArrayUtils::L2Norm(dist);
-  Vector3 f = k * (norm - r0) * 1 / norm * dist;
-  return f;
-}
-inline Vector3 forceDiagonal(Particle &p1, Particle &p2, double k, double r0) {
+/**
+ * @brief Calculates the force of a harmonic bond between two particles
+ *
+ * \f[
+ *   F_{ij} = k \left( ||x_j - x_i|| - r_0 \right) \frac{x_j - x_i}{||x_j - x_i||}
+ * \f]
+ *
+ * @param p1 first particle of the bond
+ * @param p2 second particle of the bond
+ * @param k stiffness constant
+ * @param rest_length length \f$ r_0 \f$ of the bond where the force vanishes
+ * @return Vector3 force on p1
+ */
+inline Vector3 force(Particle &p1, Particle &p2, double k, double rest_length) {
   Vector3 dist = p2.getX() - p1.getX();  // norm of x2 - x1 = norm of x1 - x2
   double norm = ArrayUtils::L2Norm(dist);
-  Vector3 f = k * (norm - sqrt2 * r0) * 1 / norm * dist;
+  Vector3 f = k * (norm - rest_length) * 1 / norm * dist;
   return f;
 }
 }  // namespace harmonicPotential
@@ -4,20 +4,116 @@
 
 #include "simulations/PlanetSimulation.h"
 
+#include <algorithm>
+#include <cmath>
+
 #include "Physics.h"
 #include "container/directSum/ParticleContainer.h"
 #include "simulations/Simulation.h"
 #include "utils/ArrayUtils.h"
 
 void PlanetSimulation::iteration() {
-  // calculate new x
-  updateX();
-  // calculate new f
+  switch (integrator) {
+    case Integrator::YOSHIDA4:
+      stoermerVerletStep(Physics::Symplectic::Yoshida4::w1 * delta_t);
+      stoermerVerletStep(Physics::Symplectic::Yoshida4::w0 * delta_t);
+      stoermerVerletStep(Physics::Symplectic::Yoshida4::w1 * delta_t);
+      break;
+    case Integrator::PEFRL:
+      pefrlStep();
+      break;
+    case Integrator::BLOCK:
+      blockStep();
+      break;
+    default:
+      // calculate new x
+      updateX();
+      // calculate new f
+      updateF();
+      // calculate new v
+      updateV();
+      break;
+  }
+}
+
+void PlanetSimulation::stoermerVerletStep(const double h) {
+  container.applyToParticles([h](Particle &p) { p.setX(Physics::StoermerVerlet::position(p, h)); });
   updateF();
-  // calculate new v
-  updateV();
+  container.applyToParticles([h](Particle &p) { p.setV(Physics::StoermerVerlet::velocity(p, h)); });
 }
 
+void PlanetSimulation::pefrlStep() {
+  using namespace Physics::Symplectic;
+  const double h = delta_t;
+  auto driftAll = [this](const double c) { container.applyToParticles([c](Particle &p) { p.setX(drift(p, c)); }); };
+  auto kickAll = [this](const double c) {
+    updateF();
+    container.applyToParticles([c](Particle &p) { p.setV(kick(p, c)); });
+  };
+
+  driftAll(PEFRL::xi * h);
+  kickAll((1 - 2 * PEFRL::lambda) * h / 2);
+  driftAll(PEFRL::chi * h);
+  kickAll(PEFRL::lambda * h);
+  driftAll((1 - 2 * (PEFRL::chi + PEFRL::xi)) * h);
+  kickAll(PEFRL::lambda * h);
+  driftAll(PEFRL::chi * h);
+  kickAll((1 - 2 * PEFRL::lambda) * h / 2);
+  driftAll(PEFRL::xi * h);
+}
+
+void PlanetSimulation::blockStep() {
+  const size_t substeps = size_t{1} << block_levels;
+  const double h = delta_t / static_cast<double>(substeps);
+
+  // assign levels from the current accelerations: the smallest level whose timestep fulfills dt <= sqrt(2 eta / |a|)
+  levels.resize(particles.size());
+#pragma omp parallel for
+  for (size_t i = 0; i < particles.size(); i++) {
+    const double a = ArrayUtils::L2Norm(particles[i].getF()) / particles[i].getM();
+    unsigned int level = 0;
+    if (a > 0) {
+      const double dt = std::sqrt(2 * block_eta / a);
+      level = static_cast<unsigned int>(std::clamp(std::ceil(std::log2(delta_t / dt)), 0.0, double(block_levels)));
+    }
+    levels[i] = level;
+  }
+  auto stride = [this, substeps](const size_t i) { return substeps >> levels[i]; };
+
+  // opening half kick of every particle with its own timestep
+#pragma omp parallel for
+  for (size_t i = 0; i < particles.size(); i++) {
+    particles[i].setV(Physics::Symplectic::kick(particles[i], h * stride(i) / 2));
+  }
+
+  std::vector<size_t> active;
+  active.reserve(particles.size());
+  for (size_t s = 1; s <= substeps; s++) {
+    container.applyToParticles([h](Particle &p) { p.setX(Physics::Symplectic::drift(p, h)); });
+
+    active.clear();
+    for (size_t i = 0; i < particles.size(); i++) {
+      if (s % stride(i) == 0) active.push_back(i);
+    }
+    if (active.empty()) continue;
+
+    // new forces of the active particles against all other particles
+    for (const size_t i : active) particles[i].setF({0, 0, 0});
+    container.applyToPartners(active, [this](Particle &p, Particle &q) { p.addF(pairForce(p, q)); });
+
+    // closing half kick, immediately followed by the opening half kick of the next step if the block is not over
+    const bool last = s == substeps;
+#pragma omp parallel for
+    for (size_t k = 0; k < active.size(); k++) {
+      const size_t i = active[k];
+      const double kick = last ? h * stride(i) / 2 : h * stride(i);
+      particles[i].setV(Physics::Symplectic::kick(particles[i], kick));
+    }
+  }
+}
+
+Vector3 PlanetSimulation::pairForce(Particle &p1, Particle &p2) { return Physics::Planet::force(p1, p2); }
+
 void PlanetSimulation::updateF() {
   container.applyToParticles([](Particle &p) { p.setF({0, 0, 0}); });
   container.applyToPairs([](Particle &p1, Particle &p2) {
@@ -34,3 +130,16 @@ void PlanetSimulation::updateX() {
 void PlanetSimulation::updateV() {
   container.applyToParticles([this](Particle &p) { p.setV(Physics::StoermerVerlet::velocity(p, delta_t)); });
 }
+
+std::pair<double, double> PlanetSimulation::calculateMaxVelocityAndAcceleration() {
+  double v2_max = 0;
+  double a2_max = 0;
+#pragma omp parallel for reduction(max : v2_max, a2_max)
+  for (auto &p : particles) {
+    const Vector3 &v = p.getV();
+    const Vector3 a = (1 / p.getM()) * p.getF();
+    v2_max = std::max(v2_max, v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+    a2_max = std::max(a2_max, a[0] * a[0] + a[1] * a[1] + a[2] * a[2]);
+  }
+  return {std::sqrt(v2_max), std::sqrt(a2_max)};
+}
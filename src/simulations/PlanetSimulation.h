@@ -4,9 +4,69 @@
 
 #pragma once
 
+#include <spdlog/spdlog.h>
+
+#include <string>
+#include <unordered_map>
+
 #include "container/directSum/DirectSum.h"
 #include "simulations/Simulation.h"
 
+/**
+ * @brief Time integration scheme of the direct sum simulations
+ */
+enum class Integrator : std::uint8_t {
+  /** @brief 2nd order Stoermer-Verlet (velocity Verlet), one force evaluation per step */
+  STOERMER_VERLET,
+  /** @brief 4th order Yoshida / Forest-Ruth triple jump, three force evaluations per step */
+  YOSHIDA4,
+  /** @brief 4th order position extended Forest-Ruth like integrator, four force evaluations per step */
+  PEFRL,
+  /** @brief Hierarchical block timesteps: particles only get forces updated as often as their acceleration needs */
+  BLOCK
+};
+
+/**
+ * Transform a String, that represents an Integrator into an Integrator Enum
+ * @param str String that represents an integrator
+ * @return ENUM Object Integrator
+ */
+inline Integrator string_to_integrator(std::string str) {
+  const std::unordered_map<std::string, Integrator> lookup = {
+      {"stoermer_verlet", Integrator::STOERMER_VERLET},
+      {"yoshida4", Integrator::YOSHIDA4},
+      {"forest_ruth", Integrator::YOSHIDA4},
+      {"pefrl", Integrator::PEFRL},
+      {"block", Integrator::BLOCK},
+  };
+
+  auto x = lookup.find(str);
+  if (x == lookup.end()) {
+    SPDLOG_WARN("Invalid integrator \"{}\"", str);
+    return Integrator::STOERMER_VERLET;
+  }
+
+  return x->second;
+}
+
+/**
+ * Transform an Integrator Enum into the string used in input files
+ * @param integrator
+ * @return name of the integrator
+ */
+inline std::string integrator_to_string(Integrator integrator) {
+  switch (integrator) {
+    case Integrator::YOSHIDA4:
+      return "yoshida4";
+    case Integrator::PEFRL:
+      return "pefrl";
+    case Integrator::BLOCK:
+      return "block";
+    default:
+      return "stoermer_verlet";
+  }
+}
+
 /**
  * @class PlanetSimulation
  * @brief Simulation for Assignment 1
@@ -21,6 +81,57 @@ class PlanetSimulation : public Simulation {
  protected:
   /** @brief Container for the particles */
   DirectSum container;
+  /** @brief Reference to the particles vector */
+  std::vector<Particle> &particles;
+
+  /** @brief Time integration scheme used by iteration() */
+  Integrator integrator = Integrator::STOERMER_VERLET;
+  /** @brief Number of block timestep levels. The finest level uses delta_t / 2^block_levels */
+  unsigned int block_levels = 4;
+  /**
+   * @brief Accuracy parameter of the block timestep criterion
+   *
+   * A particle with acceleration a gets the largest block timestep below \f$ \sqrt{2 \eta / |a|} \f$, i.e. eta is
+   * the distance a particle may deviate from a straight line within one of its steps.
+   */
+  double block_eta = 0.01;
+  /** @brief Block level of each particle, reassigned at the beginning of every block step */
+  std::vector<unsigned int> levels;
+
+  /**
+   * @brief One Stoermer-Verlet step with timestep h
+   *
+   * Composition building block of the higher order integrators.
+   * @param h (fractional) timestep, may be negative
+   */
+  void stoermerVerletStep(double h);
+
+  /**
+   * @brief One step of the position extended Forest-Ruth like integrator
+   *
+   * The scheme starts and ends with a drift, so the forces are evaluated four times per step. The forces stored in
+   * the particles after a step belong to the last inner stage and not to the final positions.
+   */
+  void pefrlStep();
+
+  /**
+   * @brief One hierarchical block timestep of size delta_t (kick-drift-kick)
+   *
+   * Every particle is assigned to a level l, where it is integrated with timestep delta_t / 2^l. All particles are
+   * drifted in every substep, but forces are only recomputed (against all particles) for particles whose step ends in
+   * the current substep. At the end of the block all particles are synchronized again.
+   */
+  void blockStep();
+
+  /**
+   * @brief Force that p2 exerts on p1
+   *
+   * Used by the block timestep integrator, which only updates the forces of some particles.
+   * @param p1
+   * @param p2
+   * @return Vector3 force on p1
+   */
+  virtual Vector3 pairForce(Particle &p1, Particle &p2);
 
  public:
   /**
@@ -32,12 +143,24 @@ class PlanetSimulation : public Simulation {
    */
   PlanetSimulation(std::vector<Particle> &particles, const double start_time, const double end_time,
                    const double delta_t)
-      : Simulation(start_time, end_time, delta_t), container(particles) {}
+      : Simulation(start_time, end_time, delta_t), container(particles), particles(particles) {}
   /**
-   * Calculates one timestep of the simulation and applies the changes to the particles.
+   * Calculates one timestep of the simulation with the selected integrator and applies the changes to the particles.
    */
   void iteration() override;
 
+  /**
+   * @brief Select the time integration scheme
+   * @param integrator
+   * @param block_levels number of levels used by Integrator::BLOCK
+   * @param block_eta accuracy parameter used by Integrator::BLOCK
+   */
+  void setIntegrator(Integrator integrator, unsigned int block_levels = 4, double block_eta = 0.01) {
+    this->integrator = integrator;
+    this->block_levels = block_levels;
+    this->block_eta = block_eta;
+  }
+
   /**
    * @brief calculate the force for all particles
    *
@@ -59,4 +182,9 @@ class PlanetSimulation : public Simulation {
    * For each particle i this function calculates the new Velocity v
    */
   virtual void updateV() override;
+
+  /**
+   * @copydoc Simulation::calculateMaxVelocityAndAcceleration()
+   */
+  std::pair<double, double> calculateMaxVelocityAndAcceleration() override;
 };
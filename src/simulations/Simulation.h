@@ -5,6 +5,30 @@
 #pragma once
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <optional>
+#include <utility>
+
+#include "utils/PhaseTimers.h"
+#include "utils/Tracing.h"
+
+/**
+ * @brief Bounds for the adaptive timestep control
+ *
+ * The timestep is chosen such that no particle travels further than `max_displacement` in one step, neither due to
+ * its velocity nor due to its acceleration. The result is clamped to [delta_t_min, delta_t_max].
+ */
+struct AdaptiveTimestep {
+  /** @brief Smallest timestep the simulation may use */
+  double delta_t_min;
+  /** @brief Largest timestep the simulation may use */
+  double delta_t_max;
+  /** @brief Maximum distance a particle is allowed to travel in one timestep */
+  double max_displacement;
+};
+
 /**
  * @brief Base class for simulations
  *
@@ -21,13 +45,34 @@ class Simulation {
    */
   const double end_time;
   /**
-   * timestep of the simulation
+   * timestep of the simulation. Only changes between iterations if an adaptive timestep is set
    */
-  const double delta_t;
+  double delta_t;
   /**
    * Current iteration the simulation is in
    */
   unsigned int current_iteration;
+  /**
+   * Number of iterations that were already finished before the start, e.g. by the run of a restored checkpoint
+   */
+  unsigned int start_iteration = 0;
+  /**
+   * Set by stop() to end the run after the current iteration
+   */
+  bool stop_requested = false;
+  /**
+   * Current time of the simulation. During an iteration this is the time at the start of the iteration
+   */
+  double current_time;
+  /**
+   * Bounds for the timestep control. If not set, the simulation uses the fixed timestep delta_t
+   */
+  std::optional<AdaptiveTimestep> adaptive_timestep;
+  /**
+   * Number of random velocity initializations so far. Used as stream of the random number generator, so repeated
+   * initializations draw independent velocities
+   */
+  std::uint32_t random_stream = 0;
 
  public:
   /**
@@ -37,7 +82,7 @@ class Simulation {
    * @param delta_t timestep of the simulation
    */
   Simulation(const double start_time, const double end_time, const double delta_t)
-      : start_time(start_time), end_time(end_time), delta_t(delta_t), current_iteration(0) {}
+      : start_time(start_time), end_time(end_time), delta_t(delta_t), current_iteration(0), current_time(start_time) {}
   // destructor to avoid memory leaks
   virtual ~Simulation() = default;
   friend class TestThermostatSimulation;
@@ -50,23 +95,96 @@ class Simulation {
    */
   template <typename Function>
   void run(Function f) {
-    double current_time = start_time;
-    current_iteration = 0;
+    current_time = start_time;
+    current_iteration = start_iteration;
+    stop_requested = false;
 
     // for this loop, we assume: current x, current f and current v are known
-    while (current_time < end_time) {
+    while (current_time < end_time && !stop_requested) {
+      Tracing::step(current_iteration - start_iteration);
+      PhaseTimers::ScopedTimer timer(PhaseTimers::STEP);
       iteration();
-
-      f(current_iteration);
-#ifndef ENABLE_TIME_MEASURE
-      SPDLOG_INFO("Iteration {} finished.", current_iteration);
-#endif
-
       current_time += delta_t;
       current_iteration++;
+      // f sees the complete state for the next iteration, so it can write a checkpoint
+      if (adaptive_timestep.has_value()) adaptTimestep();
+      timer.stop();
+
+      f(current_iteration - 1);
+      SPDLOG_INFO("Iteration {} finished.", current_iteration - 1);
     }
   };
 
+  /**
+   * @brief Continues a previous run, e.g. from a checkpoint
+   *
+   * The start time is passed to the constructor, this sets the remaining state that is needed to continue the run
+   * exactly like it would have without interruption.
+   * @param iteration Number of iterations finished before the start
+   * @param timestep Timestep for the next iteration
+   */
+  void resume(const unsigned int iteration, const double timestep) {
+    start_iteration = iteration;
+    delta_t = timestep;
+  }
+
+  /**
+   * @brief Ends the run after the current iteration. Called from the function passed to run()
+   */
+  void stop() { stop_requested = true; }
+
+  /**
+   * @brief Enables the adaptive timestep control
+   *
+   * After every iteration the timestep is recalculated from the fastest and the most accelerated particle.
+   * The timestep passed to the constructor is used for the first iteration.
+   * @param bounds Bounds for the timestep
+   */
+  void setAdaptiveTimestep(const AdaptiveTimestep &bounds) { adaptive_timestep = bounds; }
+
+  /**
+   * @brief Chooses the timestep for the next iteration
+   *
+   * \f[
+   *   \Delta t = \min\left(\frac{d_{max}}{v_{max}}, \sqrt{\frac{2 d_{max}}{a_{max}}}\right)
+   * \f]
+   * The timestep grows at most by a factor of two per iteration and is clamped to the configured bounds.
+   */
+  void adaptTimestep() {
+    const auto &bounds = adaptive_timestep.value();
+    const auto [v_max, a_max] = calculateMaxVelocityAndAcceleration();
+
+    double candidate = bounds.delta_t_max;
+    if (v_max > 0) candidate = std::min(candidate, bounds.max_displacement / v_max);
+    if (a_max > 0) candidate = std::min(candidate, std::sqrt(2 * bounds.max_displacement / a_max));
+    // limit the growth to prevent oscillating timesteps after a violent event
+    candidate = std::min(candidate, 2 * delta_t);
+
+    delta_t = std::clamp(candidate, bounds.delta_t_min, bounds.delta_t_max);
+    SPDLOG_DEBUG("Adapted timestep to {}", delta_t);
+  }
+
+  /**
+   * @return Current time of the simulation
+   */
+  [[nodiscard]] double getCurrentTime() const { return current_time; }
+
+  /**
+   * @return Number of finished iterations
+   */
+  [[nodiscard]] unsigned int getCurrentIteration() const { return current_iteration; }
+
+  /**
+   * @return Timestep used for the next iteration
+   */
+  [[nodiscard]] double getDeltaT() const { return delta_t; }
+
+  /**
+   * @brief Calculates the largest velocity and acceleration of all particles that are integrated
+   * @return Pair of the maximum norm of the velocity and the maximum norm of the acceleration
+   */
+  virtual std::pair<double, double> calculateMaxVelocityAndAcceleration() = 0;
+
   /**
    * @brief Performs one complete iteration of the simulation.
    *
@@ -0,0 +1,138 @@
+#include "simulations/SimulationFactory.h"
+
+#include <spdlog/spdlog.h>
+
+#include <cmath>
+#include <limits>
+
+#include "container/linkedCells/LinkedCellsV2.h"
+#include "simulations/CollisionSimulation.h"
+#include "simulations/CutoffSimulation.h"
+#include "simulations/MembraneSimulation.h"
+#include "simulations/PlanetSimulation.h"
+#include "simulations/ThermostatSimulation.h"
+#include "simulations/nanoScale/NanoScaleSimulation.h"
+
+namespace {
+std::unique_ptr<LinkedCells> createLinkedCells(std::vector<Particle> &particles, const Settings &settings) {
+  if (settings.useAlternateParallelisation) {
+    return std::make_unique<LinkedCellsV2>(particles, settings.simulation.domain.value(),
+                                           settings.simulation.cutoff_radius.value(), settings.simulation.is2D,
+                                           settings.simulation.borders.value());
+  }
+  return std::make_unique<LinkedCells>(particles, settings.simulation.domain.value(),
+                                       settings.simulation.cutoff_radius.value(), settings.simulation.is2D,
+                                       settings.simulation.borders.value());
+}
+}  // namespace
+
+SimulationSetup SimulationFactory::create(std::vector<Particle> &particles, Settings &settings) {
+  SimulationSetup setup;
+  auto &simulation = setup.simulation;
+  auto &linkedCells = setup.linked_cells;
+  auto &thermostat = setup.thermostat;
+
+  switch (settings.simulation.worksheet.value()) {
+    case 1:
+      simulation = std::make_unique<PlanetSimulation>(particles, settings.simulation.start_time,
+                                                      settings.simulation.end_time.value(),
+                                                      settings.simulation.delta_t.value());
+      break;
+
+    case 2:
+      simulation = std::make_unique<CollisionSimulation>(
+          particles, settings.simulation.start_time, settings.simulation.end_time.value(),
+          settings.simulation.delta_t.value(), settings.simulation.brown_motion_avg_velocity);
+      break;
+
+    case 3:
+      linkedCells = createLinkedCells(particles, settings);
+      simulation = std::make_unique<CutoffSimulation>(
+          *linkedCells, settings.simulation.start_time, settings.simulation.end_time.value(),
+          settings.simulation.delta_t.value(), settings.simulation.brown_motion_avg_velocity,
+          settings.simulation.domain.value(), settings.simulation.cutoff_radius.value(),
+          settings.simulation.borders.value(), settings.simulation.is2D, settings.simulation.gravity.value_or(0.0));
+      break;
+
+    case 4:
+      linkedCells = createLinkedCells(particles, settings);
+      thermostat = std::make_unique<Thermostat>(
+          particles, settings.simulation.is2D, settings.simulation.t_frequency.value(),
+          settings.simulation.t_final.value_or(settings.simulation.t_initial.value()),
+          settings.simulation.t_max_change.value_or(std::numeric_limits<double>::infinity()));
+      simulation = std::make_unique<ThermostatSimulation>(
+          *linkedCells, settings.simulation.start_time, settings.simulation.end_time.value(),
+          settings.simulation.delta_t.value(), settings.simulation.brown_motion_avg_velocity,
+          settings.simulation.domain.value(), settings.simulation.cutoff_radius.value(),
+          settings.simulation.borders.value(), settings.simulation.is2D, settings.simulation.gravity.value_or(0.0),
+          settings.simulation.t_initial, *thermostat);
+      break;
+
+    case 5:
+      linkedCells = createLinkedCells(particles, settings);
+      thermostat = std::make_unique<Thermostat>(
+          particles, settings.simulation.is2D,
+          settings.simulation.t_frequency.value_or(std::numeric_limits<int>::max()),
+          settings.simulation.t_final.value_or(settings.simulation.t_initial.value_or(0.0)),
+          settings.simulation.t_max_change.value_or(std::numeric_limits<double>::infinity()));
+      simulation = std::make_unique<MembraneSimulation>(
+          *linkedCells, settings.simulation.start_time, settings.simulation.end_time.value(),
+          settings.simulation.delta_t.value(), settings.simulation.brown_motion_avg_velocity,
+          settings.simulation.domain.value(), pow(2, (1.0 / 6.0)) * settings.membrane.sigma.value_or(1.0),
+          settings.simulation.borders.value(), settings.simulation.is2D, settings.simulation.gravity.value_or(0.0),
+          settings.simulation.t_initial, *thermostat, settings.membrane.r0.value(), settings.membrane.k.value(),
+          settings.membrane.bonds);
+      break;
+
+    case 6:
+      linkedCells = createLinkedCells(particles, settings);
+      thermostat = std::make_unique<Thermostat>(
+          particles, settings.simulation.is2D,
+          settings.simulation.t_frequency.value_or(std::numeric_limits<int>::max()),
+          settings.simulation.t_final.value_or(settings.simulation.t_initial.value_or(0.0)),
+          settings.simulation.t_max_change.value_or(std::numeric_limits<double>::infinity()));
+      simulation = std::make_unique<NanoScaleSimulation>(
+          *linkedCells, settings.simulation.start_time, settings.simulation.end_time.value(),
+          settings.simulation.delta_t.value(), settings.simulation.brown_motion_avg_velocity,
+          settings.simulation.domain.value(), pow(2, (1.0 / 6.0)) * settings.membrane.sigma.value_or(1.0),
+          settings.simulation.borders.value(), settings.simulation.is2D, settings.simulation.gravity.value_or(0.0),
+          settings.simulation.t_initial, *thermostat);
+      break;
+
+    default:
+      SPDLOG_ERROR("Invalid worksheet number {}", settings.simulation.worksheet.value());
+      exit(EXIT_FAILURE);
+  }
+
+  if (settings.restart.has_value()) {
+    simulation->resume(settings.restart->iteration, settings.restart->delta_t);
+    if (linkedCells && !settings.restart->cell_order.empty()) linkedCells->setCellOrder(settings.restart->cell_order);
+  }
+
+  if (settings.simulation.adaptive_timestep.has_value()) {
+    simulation->setAdaptiveTimestep(settings.simulation.adaptive_timestep.value());
+  }
+
+  if (!settings.force_groups.empty()) {
+    auto *cutoff_simulation = dynamic_cast<CutoffSimulation *>(simulation.get());
+    if (cutoff_simulation) {
+      cutoff_simulation->setForceGroups(settings.force_groups);
+    } else {
+      SPDLOG_WARN("Force groups are only available for linked cells simulations (worksheet 3 and above)");
+    }
+  }
+
+  if (settings.simulation.integrator.has_value()) {
+    auto *planet_simulation = dynamic_cast<PlanetSimulation *>(simulation.get());
+    if (planet_simulation) {
+      planet_simulation->setIntegrator(settings.simulation.integrator.value(),
+                                       settings.simulation.block_levels.value_or(4),
+                                       settings.simulation.block_eta.value_or(0.01));
+    } else if (settings.simulation.integrator.value() != Integrator::STOERMER_VERLET) {
+      SPDLOG_WARN("Integrator \"{}\" is only available for worksheets 1 and 2, using stoermer_verlet",
+                  integrator_to_string(settings.simulation.integrator.value()));
+    }
+  }
+
+  return setup;
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "Particle.h"
+#include "Settings.h"
+#include "container/linkedCells/LinkedCells.h"
+#include "simulations/Simulation.h"
+#include "simulations/Thermostat.h"
+
+/**
+ * @struct SimulationSetup
+ * @brief A simulation together with the container and thermostat it references
+ *
+ * The members are destroyed in reverse order, so the simulation never outlives the objects it references.
+ */
+struct SimulationSetup {
+  /** @brief Linked cells container, only set for worksheet 3 and above */
+  std::unique_ptr<LinkedCells> linked_cells;
+  /** @brief Thermostat, only set for worksheet 4 and above */
+  std::unique_ptr<Thermostat> thermostat;
+  /** @brief The simulation */
+  std::unique_ptr<Simulation> simulation;
+
+  /**
+   * @return Order of the particles in the linked cells, empty for direct sum simulations
+   * @see LinkedCells::getCellOrder()
+   */
+  [[nodiscard]] std::vector<std::pair<std::uint32_t, std::uint32_t>> cellOrder() const {
+    if (!linked_cells) return {};
+    return linked_cells->getCellOrder();
+  }
+};
+
+/**
+ * @class SimulationFactory
+ * @brief Creates the simulation of the selected worksheet from the settings
+ */
+class SimulationFactory {
+ public:
+  /**
+   * @brief Creates a simulation and its container for the given particles
+   *
+   * Also applies the optional settings: restored checkpoint state, adaptive timestep, force groups and integrator.
+   * Exits with `EXIT_FAILURE` if the worksheet does not exist.
+   *
+   * @param particles Particles to simulate. Must not be reallocated while the simulation exists
+   * @param settings Settings of the simulation. worksheet, end_time and delta_t must be set
+   * @return The simulation and the objects it references
+   */
+  static SimulationSetup create(std::vector<Particle> &particles, Settings &settings);
+};
@@ -3,6 +3,7 @@
 //
 #include "Thermostat.h"
 
+#include "simulations/Physics.h"
 #include "utils/ArrayUtils.h"
 #include "utils/MaxwellBoltzmannDistribution.h"
 
@@ -18,23 +19,26 @@ Thermostat::Thermostat(std::vector<Particle> &particles, bool is2D, int n, doubl
 
 double Thermostat::calculateEkin() {
   double ekin = 0;
+#pragma omp parallel for reduction(+ : ekin)
   for (auto &p : particles) {
     if (p.getState() < 0) continue;
-    const double v = ArrayUtils::L2Norm(p.getV());
-    ekin += p.getM() * v * v;
+    ekin += Physics::kineticEnergy(p);
   }
-  return 0.5 * ekin;
+  return ekin;
 }
 
-double Thermostat::calculateCurrentTemperature(int alive_particles) {
+double Thermostat::calculateTemperature(double ekin, int alive_particles) const {
   if (alive_particles == 0) return 0.0;
 
   const int dimensions = (is2D ? 2 : 3);
-  const double temperature = (2 * calculateEkin()) / (dimensions * alive_particles);
-  return temperature;
+  return (2 * ekin) / (dimensions * alive_particles);
 }
 
-double Thermostat::calculateScalingFactor(int alive_particles) {
+double Thermostat::calculateCurrentTemperature(int alive_particles) {
+  return calculateTemperature(calculateEkin(), alive_particles);
+}
+
+double Thermostat::calculateScalingFactor() {
   if (current_temperature < 1e-10) {
     // safety check if temperature is 0 and not initialized with brownian motion, to prevent division by 0
     return 1.0;
@@ -47,17 +51,23 @@ double Thermostat::calculateMaximumScalingFactor() {
   return std::sqrt((current_temperature + sign * maximum_temperature_change) / current_temperature);
 }
 
-void Thermostat::updateTemperature(int alive_particles) {
-  current_temperature = calculateCurrentTemperature(alive_particles);
-  double scaling_factor = calculateScalingFactor(alive_particles);
+double Thermostat::updateScalingFactor(double ekin, int alive_particles) {
+  current_temperature = calculateTemperature(ekin, alive_particles);
+  const double scaling_factor = calculateScalingFactor();
   // new temperature can be calculated without taking into account v' by applying the squared scaling factor to the
   // current temperature
   const double new_temperature = scaling_factor * scaling_factor * current_temperature;
   const double delta = fabs(current_temperature - new_temperature);
   if (delta > maximum_temperature_change) {
     // scaling factor is too large for the system to handle ==> need to calculate maximum scaling factor
-    scaling_factor = calculateMaximumScalingFactor();
+    return calculateMaximumScalingFactor();
   }
+  return scaling_factor;
+}
+
+void Thermostat::updateTemperature(int alive_particles) {
+  const double scaling_factor = updateScalingFactor(calculateEkin(), alive_particles);
+#pragma omp parallel for
   for (auto &p : particles) {
     if (p.getState() < 0) continue;
     p.setV(scaling_factor * p.getV());
@@ -66,8 +76,9 @@ void Thermostat::updateTemperature(int alive_particles) {
 
 int Thermostat::calculateAliveParticles() {
   int count = 0;
+#pragma omp parallel for reduction(+ : count)
   for (auto &p : particles) {
-    if (p.getState() != -1 && p.getType() >= 1) {
+    if (p.getState() == 0 && p.getType() >= 1) {
       count++;
     }
   }
@@ -76,14 +87,18 @@ int Thermostat::calculateAliveParticles() {
 }
 
 void Thermostat::initializeBrownianMotionZero(double initial_temperature) {
-  for (auto &p : particles) {
+#pragma omp parallel for
+  for (size_t i = 0; i < particles.size(); i++) {
+    Particle &p = particles[i];
     const double factor = sqrt(initial_temperature / p.getM());
-    p.setV(p.getV() + maxwellBoltzmannDistributedVelocity(factor, (is2D ? 2 : 3)));
+    p.setV(p.getV() + maxwellBoltzmannDistributedVelocity(factor, (is2D ? 2 : 3), i));
   }
 }
 
 void Thermostat::initializeBrownianMotion(double brownian_motion_avg_velocity) {
-  for (auto &p : particles) {
-    p.setV(p.getV() + maxwellBoltzmannDistributedVelocity(brownian_motion_avg_velocity, (is2D ? 2 : 3)));
+#pragma omp parallel for
+  for (size_t i = 0; i < particles.size(); i++) {
+    Particle &p = particles[i];
+    p.setV(p.getV() + maxwellBoltzmannDistributedVelocity(brownian_motion_avg_velocity, (is2D ? 2 : 3), i));
   }
 }
@@ -59,6 +59,23 @@ class Thermostat {
    */
   void updateTemperature(int alive_particles);
 
+  /**
+   * @brief Updates the current temperature from an already computed kinetic energy and returns the scaling factor
+   *
+   * Allows the simulation to accumulate the kinetic energy in its own pass over the particles (e.g. fused into the
+   * velocity update) and to scale the velocities itself
+   * @param ekin Sum of the kinetic energy of all alive particles
+   * @param alive_particles The amount of particles still alive which is needed for the calculation
+   * @return scaling factor beta, already capped by the maximum temperature change
+   */
+  double updateScalingFactor(double ekin, int alive_particles);
+
+  /**
+   * @param iteration current iteration of the simulation
+   * @return true if the thermostat has to be applied in the given iteration
+   */
+  [[nodiscard]] bool isDue(int iteration) const { return iteration > 0 && iteration % n == 0; }
+
   /**
    *
    * @return getter for attribute n
@@ -66,11 +83,17 @@ class Thermostat {
   int getN() { return n; }
 
  private:
+  /**
+   * @brief Calculates the temperature of a system with the given kinetic energy
+   * @return temperature of the system
+   */
+  double calculateTemperature(double ekin, int alive_particles) const;
+
   /**
    * @brief Calculates the scaling factor beta based on the target temperature
    * @return scaling factor beta
    */
-  double calculateScalingFactor(int alive_particles);
+  double calculateScalingFactor();
 
   /**
    * @brief Calculates the maximum possible scaling factor that the simulation is able to use
@@ -79,7 +102,7 @@ class Thermostat {
   double calculateMaximumScalingFactor();
 
   /**
-   * @brief Calculates the kinetic energy of the simulation (sum of energy of all particles)
+   * @brief Calculates the kinetic energy of the simulation (sum of energy of all particles) as a parallel reduction
    * @return Sum of the kinetic energy of all the particles
    */
   double calculateEkin();
@@ -95,7 +118,7 @@ class Thermostat {
   void initializeBrownianMotion(double brownian_motion_avg_velocity);
 
   /**
-   * Calculates the amount of particles still alive (state > 0)
+   * Calculates the amount of particles still alive (state == 0) as a parallel reduction
    * @return Count of alive particles
    */
   int calculateAliveParticles();
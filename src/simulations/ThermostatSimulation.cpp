@@ -7,17 +7,31 @@
 #include "utils/MaxwellBoltzmannDistribution.h"
 
 void ThermostatSimulation::updateV() {
-  linkedCells.applyToParticles([this](Particle &p) { p.setV(Physics::StoermerVerlet::velocity(p, delta_t)); });
-
-  if (current_iteration % thermostat.getN() == 0 && current_iteration > 0) {
-    thermostat.updateTemperature(linkedCells.alive_particles);
-    SPDLOG_INFO("Updated Temperature");
+  PhaseTimers::ScopedTimer timer(PhaseTimers::UPDATE_V);
+  if (!thermostat.isDue(current_iteration)) {
+    linkedCells.applyToMobileParticles([this](Particle &p) { p.setV(Physics::StoermerVerlet::velocity(p, delta_t)); });
+    return;
   }
+
+  // the kinetic energy is accumulated in the same parallel pass as the velocity update
+  const double ekin = linkedCells.reduceMobileParticles([this](Particle &p) {
+    p.setV(Physics::StoermerVerlet::velocity(p, delta_t));
+    return p.getState() < 0 ? 0.0 : Physics::kineticEnergy(p);
+  });
+  timer.stop();
+
+  PhaseTimers::ScopedTimer thermostat_timer(PhaseTimers::THERMOSTAT);
+  const double scaling_factor = thermostat.updateScalingFactor(ekin, linkedCells.alive_particles);
+  linkedCells.applyToMobileParticles([scaling_factor](Particle &p) { p.setV(scaling_factor * p.getV()); });
+  SPDLOG_INFO("Updated Temperature");
 }
 
 void ThermostatSimulation::updateF() {
-  // set the force of all particles to zero
-  linkedCells.applyToParticles([this](Particle &p) { p.setF({0, g_grav * p.getM(), 0}); });
+  {
+    // set the force of all particles to zero
+    PhaseTimers::ScopedTimer timer(PhaseTimers::RESET_F);
+    linkedCells.applyToParticles([this](Particle &p) { p.setF({0, g_grav * p.getM(), 0}); });
+  }
 
   linkedCells.applyToPairs([this](Particle &p1, Particle &p2) {
     interactionParams params = mixing_table[p1.getType() * num_types + p2.getType()];
@@ -29,8 +43,11 @@ void ThermostatSimulation::updateF() {
 }
 
 void ThermostatSimulation::initializeBrownianMotionWithTemperature(const double init_temperature) {
-  linkedCells.applyToParticles([this, init_temperature](Particle &p) {
-    p.setV(p.getV() + maxwellBoltzmannDistributedVelocity(sqrt(init_temperature / p.getM()), (is2D ? 2 : 3)));
+  const std::uint32_t stream = random_stream++;
+  linkedCells.applyToMobileParticles([this, init_temperature, stream](Particle &p) {
+    const size_t id = &p - particles.data();
+    const double factor = sqrt(init_temperature / p.getM());
+    p.setV(p.getV() + maxwellBoltzmannDistributedVelocity(factor, (is2D ? 2 : 3), id, stream));
   });
 }
 
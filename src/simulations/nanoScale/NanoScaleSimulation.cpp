@@ -8,50 +8,53 @@
 #include "simulations/Physics.h"
 #include "utils/MaxwellBoltzmannDistribution.h"
 
+void NanoScaleSimulation::initializeStaticParticles() {
+  int static_particles = 0;
+  for (auto &p : particles) {
+    if (p.getState() < 0 || p.getType() >= MAX_STATIC_TYPE) continue;
+    p.setState(1);
+    p.setV({0, 0, 0});
+    static_particles++;
+  }
+  linkedCells.sortParticlesIntoCells();
+  SPDLOG_INFO("{} particles are static", static_particles);
+}
+
 void NanoScaleSimulation::updateX() {
-  linkedCells.applyToParticles([this](Particle &p) {
+  PhaseTimers::ScopedTimer timer(PhaseTimers::UPDATE_X);
+  linkedCells.applyToMobileParticles([this](Particle &p) {
     if (p.getState() < 0) return;
-    if (p.getType() < 1) return;
 
     p.setX(Physics::StoermerVerlet::position(p, delta_t));
   });
+  timer.stop();
 
   linkedCells.moveParticles();
 }
 
-void NanoScaleSimulation::updateV() {
-  linkedCells.applyToParticles([this](Particle &p) {
-    if (p.getType() < MAX_STATIC_TYPE) return;
-    p.setV(Physics::StoermerVerlet::velocity(p, delta_t));
-  });
-
-  if (current_iteration % thermostat.getN() == 0 && current_iteration > 0) {
-    thermostat.updateTemperature(linkedCells.alive_particles);
-    spdlog::info("Updated Temperature");
-  }
-}
-
 void NanoScaleSimulation::updateF() {
-  // set the force of all particles to zero
-  linkedCells.applyToParticles([this](Particle &p) { p.setF({0, g_grav * p.getM(), 0}); });
+  {
+    // set the force of all particles to zero
+    PhaseTimers::ScopedTimer timer(PhaseTimers::RESET_F);
+    linkedCells.applyToMobileParticles([this](Particle &p) { p.setF({0, g_grav * p.getM(), 0}); });
+  }
 
+  // static particles are stored separately, so wall-wall pairs are never evaluated
   linkedCells.applyToPairs([this](Particle &p1, Particle &p2) {
     interactionParams params = mixing_table[p1.getType() * num_types + p2.getType()];
 
     Vector3 f = Physics::LennardJones::fastForce(p1, p2, params.sigma2, params.epsilon24);
-    p1.addF(f);
-    p2.subF(f);
-  });
-
-  linkedCells.applyToParticles([this](Particle &p) {
-    if (p.getType() < MAX_STATIC_TYPE) p.setF({0, 0, 0});
+    if (!p1.isStatic()) p1.addF(f);
+    if (!p2.isStatic()) p2.subF(f);
   });
 }
 
 void NanoScaleSimulation::initializeBrownianMotionWithTemperature(const double init_temperature) {
-  linkedCells.applyToParticles([this, init_temperature](Particle &p) {
-    if (p.getType() < MAX_STATIC_TYPE) return;
-    p.setV(p.getV() + maxwellBoltzmannDistributedVelocity(sqrt(init_temperature / p.getM()), (is2D ? 2 : 3)));
+  const std::uint32_t stream = random_stream++;
+  linkedCells.applyToMobileParticles([this, init_temperature, stream](Particle &p) {
+    const size_t id = &p - particles.data();
+    const double factor = sqrt(init_temperature / p.getM());
+    p.setV(p.getV() + maxwellBoltzmannDistributedVelocity(factor, (is2D ? 2 : 3), id, stream));
   });
 }
 
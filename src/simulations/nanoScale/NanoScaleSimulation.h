@@ -5,14 +5,14 @@
 #include "Particle.h"
 #include "container/linkedCells/Cell.h"
 #include "simulations/ThermostatSimulation.h"
-#include "simulations/nanoScale/NanoScaleThermostat.h"
 
 /**
  * @class NanoScaleSimulation
  * @brief Simulation for Assignment 5
  *
  * This class calculates timesteps for a particle simulation with a cutoff radius, different boundary types, different
- * particle types, a thermostat. Particles with a type less than MAX_STATIC_TYPE are not moved and have no velocity
+ * particle types, a thermostat. Particles with a type less than MAX_STATIC_TYPE are static: they are stored separately
+ * in the linked cells, so they never interact with each other and are skipped by the integrator
  *
  * @see Physics::calculateV
  * @see Physics::calculateX
@@ -20,7 +20,7 @@
  */
 class NanoScaleSimulation : public ThermostatSimulation {
  public:
-  /** Particles with a type less or equal to this will not be moved */
+  /** Particles with a type less than this are static */
   const static int MAX_STATIC_TYPE = 1;
   /** Amount of bins to use in calculateStatistics */
   const unsigned int BINS = 50;
@@ -35,6 +35,7 @@ class NanoScaleSimulation : public ThermostatSimulation {
     // also sets types of the particles
     initializeParticleTypes();
     initializeMixingTable();
+    initializeStaticParticles();
     if (t_initial.has_value()) {
       initializeBrownianMotionWithTemperature(t_initial.value());
     }
@@ -43,14 +44,14 @@ class NanoScaleSimulation : public ThermostatSimulation {
   virtual ~NanoScaleSimulation() = default;
 
   /**
-   * @copydoc ThermostatSimulation::updateX()
+   * @brief Marks all particles with a type less than MAX_STATIC_TYPE as static and resorts the linked cells
    */
-  void updateX() override;
+  void initializeStaticParticles();
 
   /**
-   * @copydoc ThermostatSimulation::updateV()
+   * @copydoc ThermostatSimulation::updateX()
    */
-  void updateV() override;
+  void updateX() override;
 
   /**
    * @copydoc ThermostatSimulation::updateF()
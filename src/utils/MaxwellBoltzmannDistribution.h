@@ -8,26 +8,36 @@
 #pragma once
 
 #include <array>
-#include <random>
+#include <cstdint>
+
+#include "utils/Philox.h"
 
 /**
  * Generate a random velocity vector according to the Maxwell-Boltzmann distribution, with a given average velocity.
  *
+ * The velocity is drawn with the counter-based generator Philox::philox4x32, so it only depends on the arguments and
+ * this function can be called from parallel loops. Particles with different ids get independent velocities, the same
+ * particle gets an independent velocity for every stream.
+ *
  * @param averageVelocity The average velocity of the brownian motion for the system.
  * @param dimensions Number of dimensions for which the velocity vector shall be generated. Set this to 2 or 3.
+ * @param id Id of the particle, e.g. its index in the particles vector.
+ * @param stream Number of the draw for this particle, to draw multiple independent velocities for the same particle.
+ * @param seed Seed of the generator. We use a constant seed for repeatability.
  * @return Array containing the generated velocity vector.
  */
-inline std::array<double, 3> maxwellBoltzmannDistributedVelocity(double averageVelocity, size_t dimensions) {
-  // we use a constant seed for repeatability.
-  // random engine needs static lifetime otherwise it would be recreated for every call.
-  static std::default_random_engine randomEngine(42);
+inline std::array<double, 3> maxwellBoltzmannDistributedVelocity(double averageVelocity, size_t dimensions,
+                                                                  std::uint64_t id, std::uint32_t stream = 0,
+                                                                  std::uint64_t seed = 42) {
+  const Philox::Counter counter = {static_cast<std::uint32_t>(id), static_cast<std::uint32_t>(id >> 32), stream, 0};
+  const Philox::Key key = {static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32)};
 
   // when adding independent normally distributed values to all velocity components
   // the velocity change is maxwell boltzmann distributed
-  std::normal_distribution<double> normalDistribution{0, 1};
+  const std::array<double, 4> normal = Philox::normal(counter, key);
   std::array<double, 3> randomVelocity{};
   for (size_t i = 0; i < dimensions; ++i) {
-    randomVelocity[i] = averageVelocity * normalDistribution(randomEngine);
+    randomVelocity[i] = averageVelocity * normal[i];
   }
   return randomVelocity;
 }
@@ -0,0 +1,115 @@
+#include "utils/MemoryUsage.h"
+
+#include <spdlog/fmt/fmt.h>
+
+#include <algorithm>
+#include <fstream>
+
+namespace Memory {
+
+namespace {
+Usage last;
+Usage highest;
+std::size_t highest_total = 0;
+
+/**
+ * @brief Reads a value in kB from /proc/self/status
+ * @param key Name of the value including the colon, e.g. `VmRSS:`
+ * @return Value in bytes, 0 if it does not exist
+ */
+std::size_t readStatus(const std::string &key) {
+  std::ifstream status("/proc/self/status");
+  std::string word;
+  while (status >> word) {
+    if (word != key) continue;
+    std::size_t kilobytes = 0;
+    status >> kilobytes;
+    return kilobytes * 1024;
+  }
+  return 0;
+}
+}  // namespace
+
+std::size_t Usage::total() const {
+  std::size_t sum = 0;
+  for (const auto value : bytes) sum += value;
+  return sum;
+}
+
+const char *name(const Subsystem subsystem) {
+  switch (subsystem) {
+    case PARTICLES:
+      return "particles";
+    case CELLS:
+      return "cells";
+    case GHOSTS:
+      return "ghost particles";
+    case NEIGHBOURS:
+      return "neighbours";
+    case BONDS:
+      return "bonds";
+    case OUTPUT:
+      return "output buffers";
+    case DIAGNOSTICS:
+      return "diagnostics";
+    default:
+      return "unknown";
+  }
+}
+
+void record(const Usage &usage) {
+  last = usage;
+  for (int subsystem = 0; subsystem < SUBSYSTEM_COUNT; subsystem++) {
+    highest[subsystem] = std::max(highest[subsystem], usage[subsystem]);
+  }
+  highest_total = std::max(highest_total, usage.total());
+}
+
+Usage current() { return last; }
+
+Usage peak() { return highest; }
+
+std::size_t peakTotal() { return highest_total; }
+
+void reset() {
+  last = Usage{};
+  highest = Usage{};
+  highest_total = 0;
+}
+
+Process process() {
+#ifdef __linux__
+  return {readStatus("VmRSS:"), readStatus("VmHWM:")};
+#else
+  return {};
+#endif
+}
+
+std::string formatBytes(const std::size_t bytes) {
+  const char *units[] = {"B", "KiB", "MiB", "GiB", "TiB"};
+  double value = static_cast<double>(bytes);
+  int unit = 0;
+  while (value >= 1024 && unit < 4) {
+    value /= 1024;
+    unit++;
+  }
+  return unit == 0 ? fmt::format("{} B", bytes) : fmt::format("{:.2f} {}", value, units[unit]);
+}
+
+std::string format() {
+  std::string result = fmt::format("{:<18}{:>14}{:>14}\n", "subsystem", "current", "peak");
+  for (int subsystem = 0; subsystem < SUBSYSTEM_COUNT; subsystem++) {
+    if (highest[subsystem] == 0) continue;
+    result += fmt::format("{:<18}{:>14}{:>14}\n", name(static_cast<Subsystem>(subsystem)),
+                          formatBytes(last[subsystem]), formatBytes(highest[subsystem]));
+  }
+  result += fmt::format("{:<18}{:>14}{:>14}\n", "total", formatBytes(last.total()), formatBytes(highest_total));
+  const Process memory = process();
+  if (memory.resident > 0) {
+    result += fmt::format("{:<18}{:>14}{:>14}\n", "process (RSS)", formatBytes(memory.resident),
+                          formatBytes(memory.peak_resident));
+  }
+  return result;
+}
+
+}  // namespace Memory
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <string>
+
+/**
+ * @brief Accounting of the memory held by the subsystems of a simulation
+ *
+ * The subsystems report the capacity of their containers, which record() collects together with the highest value
+ * seen so far. The accounting does not hook into the allocator, so it only knows the containers that are measured, the
+ * resident set size of the process shows everything else.
+ */
+namespace Memory {
+
+/**
+ * @brief Parts of the simulation whose memory is accounted separately
+ */
+enum Subsystem : int {
+  /** @brief The particle vector */
+  PARTICLES,
+  /** @brief Cells of the linked cells with their particle pointers and index lists */
+  CELLS,
+  /** @brief Ghost particles of the linked cells */
+  GHOSTS,
+  /** @brief Neighbour indices of the linked cells */
+  NEIGHBOURS,
+  /** @brief Membrane bonds and force groups */
+  BONDS,
+  /** @brief Particle snapshots waiting to be written */
+  OUTPUT,
+  /** @brief Cell costs and other measurements */
+  DIAGNOSTICS,
+  SUBSYSTEM_COUNT
+};
+
+/**
+ * @struct Usage
+ * @brief Bytes of every subsystem
+ */
+struct Usage {
+  /** @brief Bytes indexed by Subsystem */
+  std::array<std::size_t, SUBSYSTEM_COUNT> bytes{};
+
+  std::size_t &operator[](const int subsystem) { return bytes[subsystem]; }
+  std::size_t operator[](const int subsystem) const { return bytes[subsystem]; }
+
+  /**
+   * @return Sum of all subsystems
+   */
+  [[nodiscard]] std::size_t total() const;
+};
+
+/**
+ * @struct Process
+ * @brief Memory of the whole process as seen by the operating system, 0 if it is not known
+ */
+struct Process {
+  /** @brief Current resident set size in bytes */
+  std::size_t resident = 0;
+  /** @brief Highest resident set size in bytes */
+  std::size_t peak_resident = 0;
+};
+
+/**
+ * @param subsystem Subsystem
+ * @return Name of the subsystem as shown in the report
+ */
+const char *name(Subsystem subsystem);
+
+/**
+ * @brief Stores a new measurement and raises the high-water marks
+ * @param usage Bytes of every subsystem
+ */
+void record(const Usage &usage);
+
+/**
+ * @return The last recorded measurement
+ */
+Usage current();
+
+/**
+ * @return Highest recorded value of every subsystem and of the total, which may be less than the sum of the subsystems
+ * if they reached their maximum at different times
+ */
+Usage peak();
+
+/**
+ * @return Highest recorded total
+ */
+std::size_t peakTotal();
+
+/**
+ * @brief Forgets all measurements
+ */
+void reset();
+
+/**
+ * @return Resident set size of the process, read from /proc/self/status on Linux
+ */
+Process process();
+
+/**
+ * @param bytes Number of bytes
+ * @return The number with a binary unit, e.g. `1.50 MiB`
+ */
+std::string formatBytes(std::size_t bytes);
+
+/**
+ * @return Table with the current and the peak bytes of every subsystem and the resident set size of the process
+ */
+std::string format();
+
+}  // namespace Memory
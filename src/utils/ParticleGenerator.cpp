@@ -2,121 +2,124 @@
 
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
+#include <cstdint>
+
 #include "Particle.h"
+#include "simulations/Physics.h"
 #include "utils/ArrayUtils.h"
 
 void ParticleGenerator::cuboid(std::vector<Particle> &particles, const Vector3 pos, const std::array<unsigned int, 3> n,
                                const double distance, const double mass, const std::optional<double> epsilon,
                                std::optional<double> sigma, const Vector3 v) {
-  // Reserve space for new particles
-  SPDLOG_TRACE("Reserving {} particles", n[0] * n[1] * n[2]);
-  particles.reserve(particles.size() + n[0] * n[1] * n[2]);
+  const size_t first = particles.size();
+  const size_t count = static_cast<size_t>(n[0]) * n[1] * n[2];
+  SPDLOG_TRACE("Generating {} particles", count);
+  particles.resize(first + count);
 
-  // Generate cuboid
-  for (unsigned int x = 0; x < n[0]; x += 1)
-    for (unsigned int y = 0; y < n[1]; y += 1)
-      for (unsigned int z = 0; z < n[2]; z += 1) {
-        Vector3 new_pos = pos + distance * std::array<double, 3>{static_cast<double>(x), static_cast<double>(y),
-                                                                 static_cast<double>(z)};
-        particles.emplace_back(new_pos, v, mass, epsilon, sigma);
-      }
+  // Generate cuboid, the particles are ordered by x, then y, then z
+#pragma omp parallel for schedule(static)
+  for (size_t i = 0; i < count; i++) {
+    const size_t z = i % n[2];
+    const size_t y = i / n[2] % n[1];
+    const size_t x = i / n[2] / n[1];
+    const Vector3 new_pos =
+        pos + distance * std::array<double, 3>{static_cast<double>(x), static_cast<double>(y), static_cast<double>(z)};
+    particles[first + i] = Particle(new_pos, v, mass, epsilon, sigma);
+  }
 }
 
 void ParticleGenerator::membrane(std::vector<Particle> &particles, const Vector3 pos,
                                  const std::array<unsigned int, 3> n, const double distance, const double mass,
                                  const std::optional<double> epsilon, std::optional<double> sigma, Vector3 v,
-                                 std::vector<Particle *> &upwardsParticles,
-                                 std::vector<std::array<int, 2>> upwardsParticlesIndexes) {
-  // Reserve space for new particles
-  SPDLOG_TRACE("Reserving {} particles", n[0] * n[1] * n[2]);
-  particles.reserve(particles.size() + n[0] * n[1] * n[2]);
+                                 const double r0, BondList &bonds) {
+  const size_t first = particles.size();
+  const size_t nx = n[0];
+  const size_t ny = n[1];
+  if (nx == 0 || ny == 0) return;
+  SPDLOG_TRACE("Generating {} particles", nx * ny);
+  particles.resize(first + nx * ny);
 
-  // Generate cuboid
-  Particle *rowsFirst = nullptr;
-  Particle *left = nullptr;
-  Particle *lower = nullptr;
-  for (unsigned int y = 0; y < n[1]; y += 1)
-    for (unsigned int x = 0; x < n[0]; x += 1) {
-      // Membranes can only be flat, so the z-offset to the start Position is always 0
-      Vector3 new_pos = pos + distance * std::array<double, 3>{static_cast<double>(x), static_cast<double>(y), 0.0};
-      particles.emplace_back(new_pos, v, mass, epsilon, sigma);
-      // Set Neighbors
-      //            y   +-------------+---------+--------------+
-      //            ^   | Left Upper  | Upper   | Right Upper  |
-      //            |   |     0       |    1    |      2       |
-      //            |   +-------------+---------+--------------+
-      //            |   | Left        |  OWN    | Right        |
-      //            |   |     3       |         |      4       |
-      //            |   +-------------+---------+--------------+
-      //            |   | Left Lower  | Lower   | Right Lower  |
-      //            |   |     5       |    6    |      7       |
-      //            |   +-------------+---------+--------------+
-      //            ----------------------------------------> x
+  // Each bond is only stored once, by the particle with the lower y (or lower x in the same row)
+  //            y   +-------------+---------+--------------+
+  //            ^   | Left Upper  | Upper   | Right Upper  |
+  //            |   |  diagonal   |straight |   diagonal   |
+  //            |   +-------------+---------+--------------+
+  //            |   |             |  OWN    | Right        |
+  //            |   |             |         |   straight   |
+  //            |   +-------------+---------+--------------+
+  //            ----------------------------------------> x
+  // The number of bonds of a particle only depends on its position in the grid, so the position of its first bond in
+  // the bond list can be calculated directly: every row except the last has nx - 1 right, nx upper and 2 (nx - 1)
+  // diagonal bonds, the last row only the nx - 1 right bonds.
+  const size_t bonds_per_row = 4 * nx - 3;
+  const size_t first_bond = bonds.size();
+  bonds.bonds.resize(first_bond + (ny - 1) * bonds_per_row + (nx - 1));
 
-      Particle *current = &particles.back();
-      // Set the lower one to the last lower one and update the first in a row to the current Particle
-      if (x == 0) {
-        lower = rowsFirst;
-        rowsFirst = current;
-      }
-      // Set lower for current
-      current->setNeighbour(lower, 6);
-      // Set Left for current
-      current->setNeighbour(left, 3);
-      // Set right for left
-      if (left != nullptr) left->setNeighbour(current, 4);
+  const auto index = [first, nx](const size_t x, const size_t y) { return first + y * nx + x; };
+  const double diagonal = Physics::harmonicPotential::sqrt2 * r0;
 
-      if (lower != nullptr) {
-        // Set upper for lower
-        lower->setNeighbour(current, 1);
-        // Set right lower for current
-        Particle *rightLower = lower->getNeighbor(4);
-        current->setNeighbour(rightLower, 7);
-        // Set left upper for right lower
-        if (rightLower != nullptr) rightLower->setNeighbour(current, 0);
-        // Set left lower for current
-        Particle *leftLower = lower->getNeighbor(3);
-        current->setNeighbour(leftLower, 5);
-        // Set right upper for left lower
-        if (leftLower != nullptr) leftLower->setNeighbour(current, 2);
-        // Hier auswerten
-      }
-      // Update left
-      if (x != n[0] - 1)
-        left = current;
-      else
-        left = nullptr;
-      if (lower) lower = lower->getNeighbor(4);
+  // Generate membrane, the particles are ordered by y, then x
+#pragma omp parallel for schedule(static)
+  for (size_t i = 0; i < nx * ny; i++) {
+    const size_t x = i % nx;
+    const size_t y = i / nx;
+    // Membranes can only be flat, so the z-offset to the start Position is always 0
+    const Vector3 new_pos = pos + distance * std::array<double, 3>{static_cast<double>(x), static_cast<double>(y), 0.0};
+    particles[first + i] = Particle(new_pos, v, mass, epsilon, sigma);
 
-      // Save upwardsParticles
-      if (std::find(upwardsParticlesIndexes.begin(), upwardsParticlesIndexes.end(),
-                    std::array<int, 2>{static_cast<int>(x), static_cast<int>(y)}) != upwardsParticlesIndexes.end()) {
-        upwardsParticles.emplace_back(current);
-      }
+    const bool has_right = x + 1 < nx;
+    const bool has_upper = y + 1 < ny;
+    // bonds of the particles left of this one in the same row
+    size_t b = first_bond + y * bonds_per_row;
+    if (has_upper) {
+      if (x > 0) b += (nx > 1 ? 3 : 1) + 4 * (x - 1);
+    } else {
+      b += x;
     }
+
+    const auto add = [&bonds, &b](size_t p1, size_t p2, BondType type, double rest_length) {
+      bonds.bonds[b++] = {static_cast<std::uint32_t>(p1), static_cast<std::uint32_t>(p2), type, rest_length};
+    };
+    if (has_right) add(index(x, y), index(x + 1, y), BondType::STRAIGHT, r0);
+    if (has_upper) add(index(x, y), index(x, y + 1), BondType::STRAIGHT, r0);
+    if (has_right && has_upper) add(index(x, y), index(x + 1, y + 1), BondType::DIAGONAL, diagonal);
+    if (x > 0 && has_upper) add(index(x, y), index(x - 1, y + 1), BondType::DIAGONAL, diagonal);
+  }
 }
 
 void ParticleGenerator::disc(std::vector<Particle> &particles, const Vector3 position, const int radius,
                              const double distance, const double mass, const std::optional<double> epsilon,
                              std::optional<double> sigma, const Vector3 velocity) {
-  // A Disk covers at most ¼π ≈ 78.54% of the original grid
-  const unsigned int particles_to_reserve = (radius * 2 * radius * 2 * 78) / 100;
-  SPDLOG_TRACE("Reserving {} particles", particles_to_reserve);
-  particles.reserve(particles.size() + particles_to_reserve);
+  const auto displacement = [distance](const int x, const int y) {
+    return distance * std::array<double, 3>{static_cast<double>(x), static_cast<double>(y), 0};
+  };
+  // We compare with `radius - 1` because the first particle is at the relative position (0,0)
+  const auto inside = [&](const int x, const int y) {
+    return ArrayUtils::L2Norm(displacement(x, y)) <= static_cast<double>(radius - 1) * distance;
+  };
+  const int rows = std::max(2 * radius - 1, 0);
 
-  // Generate disk
-  for (int x = -radius + 1; x < radius; x += 1) {
-    for (int y = -radius + 1; y < radius; y += 1) {
-      Vector3 displacement = distance * std::array<double, 3>{static_cast<double>(x), static_cast<double>(y), 0};
+  // count the particles of every row first, so every row can be written to its final position
+  std::vector<size_t> row_offset(rows + 1, 0);
+#pragma omp parallel for schedule(static)
+  for (int row = 0; row < rows; row++) {
+    for (int y = -radius + 1; y < radius; y += 1) row_offset[row + 1] += inside(row - radius + 1, y);
+  }
+  for (int row = 0; row < rows; row++) row_offset[row + 1] += row_offset[row];
 
-      // We compare with `radius - 1` because the first particle is at the relative position (0,0)
-      if (ArrayUtils::L2Norm(displacement) > static_cast<double>(radius - 1) * distance) continue;
+  const size_t first = particles.size();
+  SPDLOG_TRACE("Generating {} particles", row_offset[rows]);
+  particles.resize(first + row_offset[rows]);
 
-      Vector3 new_pos = position + displacement;
-      particles.emplace_back(new_pos, velocity, mass, epsilon, sigma);
+  // Generate disk
+#pragma omp parallel for schedule(static)
+  for (int row = 0; row < rows; row++) {
+    const int x = row - radius + 1;
+    size_t i = first + row_offset[row];
+    for (int y = -radius + 1; y < radius; y += 1) {
+      if (!inside(x, y)) continue;
+      particles[i++] = Particle(position + displacement(x, y), velocity, mass, epsilon, sigma);
     }
   }
-
-  // In case that we reserved too much space. Should not really happen
-  particles.shrink_to_fit();
 }
@@ -4,6 +4,7 @@
 #include <vector>
 
 #include "Particle.h"
+#include "container/bonds/BondList.h"
 
 /**
  * @class ParticleGenerator
@@ -12,6 +13,8 @@
  * This class provides static methods for generating particles in various arrangements
  * The first argument of any generator should always be a reference to the particle vector.
  * New particles should always be appended, not replaced.
+ * The particles are generated in parallel: the vector is resized once and the position of every particle in it is
+ * calculated from its lattice indices.
  */
 class ParticleGenerator {
  public:
@@ -33,7 +36,7 @@ class ParticleGenerator {
                      std::optional<double> sigma, Vector3 v);
   /**
    * @brief Generate a membrane of particles
-   * Creates a membrane of particles with a given distance and sets the correct neighbor Particles in each direction
+   * Creates a membrane of particles with a given distance and bonds each particle to its (diagonal) neighbours
    *
    * @param[in, out] particles Vector to append the generated particles
    * @param[in] x Left corner of the cuboid
@@ -43,14 +46,13 @@ class ParticleGenerator {
    * @param[in] epsilon Default epsilon for each particle
    * @param[in] sigma Default sigma for each particle
    * @param[in] v Default Velocity for each particle
-   * @param[out] upwardsParticles Vector, where the upwardParticles should be stored in
-   * @param[in] upwardsParticlesIndexes  Indexes to find the upwardsParticles
+   * @param[in] r0 Rest length of the straight bonds. Diagonal bonds have a rest length of sqrt(2) * r0
+   * @param[out] bonds Bond list to append the bonds of the membrane to
    */
 
   static void membrane(std::vector<Particle> &particles, const Vector3 x, const std::array<unsigned int, 3> n,
                        const double distance, const double mass, const std::optional<double> epsilon,
-                       std::optional<double> sigma, Vector3 v, std::vector<Particle *> &upwardsParticles,
-                       std::vector<std::array<int, 2>> upwardsParticlesIndexes);
+                       std::optional<double> sigma, Vector3 v, const double r0, BondList &bonds);
   /**
    * @brief Generate a disc of particles
    *
@@ -0,0 +1,187 @@
+#include "utils/PerfCounters.h"
+
+#include <spdlog/spdlog.h>
+
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace PerfCounters {
+
+bool enabled = false;
+
+namespace {
+/** @brief Incremented by enable(), so every thread opens its counters again with the new events */
+std::atomic<unsigned int> current_generation{0};
+/** @brief Config of the RAW event, 0 if it is not counted */
+std::uint64_t raw = 0;
+/** @brief Events that could be opened by enable() */
+std::array<bool, EVENT_COUNT> opened{};
+
+/**
+ * @brief Counter group of one thread
+ */
+struct Group {
+  /** @brief Generation the group was opened in, 0 if it was never opened */
+  unsigned int generation = 0;
+  /** @brief File descriptor of the group leader, -1 if no event could be opened */
+  int leader = -1;
+  /** @brief File descriptors of all events, including the leader */
+  std::vector<int> fds;
+  /** @brief Event of every value of a group read, in the order the events were opened */
+  std::vector<Event> events;
+  /** @brief errno of the first event that could not be opened */
+  int error = 0;
+
+  ~Group() { close(); }
+
+  void open();
+  void close();
+};
+
+thread_local Group group;
+
+#ifdef __linux__
+int openEvent(const std::uint32_t type, const std::uint64_t config, const int group_fd) {
+  perf_event_attr attr{};
+  attr.size = sizeof(attr);
+  attr.type = type;
+  attr.config = config;
+  // user space only, which is allowed up to perf_event_paranoid 2
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+  // pid 0 and cpu -1 count the calling thread on any cpu
+  return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, PERF_FLAG_FD_CLOEXEC));
+}
+#endif
+
+void Group::open() {
+  close();
+  generation = current_generation;
+#ifdef __linux__
+  const std::array<std::pair<std::uint32_t, std::uint64_t>, EVENT_COUNT> configs = {{
+      {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_TASK_CLOCK},
+      {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+      {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+      {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_REFERENCES},
+      {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+      {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+      {PERF_TYPE_RAW, raw},
+  }};
+  for (int event = 0; event < EVENT_COUNT; event++) {
+    if (event == RAW && raw == 0) continue;
+    const int fd = openEvent(configs[event].first, configs[event].second, leader);
+    if (fd < 0) {
+      if (error == 0) error = errno;
+      continue;
+    }
+    if (leader < 0) leader = fd;
+    fds.push_back(fd);
+    events.push_back(static_cast<Event>(event));
+  }
+#endif
+}
+
+void Group::close() {
+#ifdef __linux__
+  // the leader is closed last, closing it first would turn the other events into single events
+  for (auto fd = fds.rbegin(); fd != fds.rend(); ++fd) ::close(*fd);
+#endif
+  fds.clear();
+  events.clear();
+  leader = -1;
+  error = 0;
+}
+}  // namespace
+
+const char *name(const Event event) {
+  switch (event) {
+    case TASK_CLOCK:
+      return "task_clock";
+    case CYCLES:
+      return "cycles";
+    case INSTRUCTIONS:
+      return "instructions";
+    case CACHE_REFERENCES:
+      return "cache_references";
+    case CACHE_MISSES:
+      return "cache_misses";
+    case BRANCH_MISSES:
+      return "branch_misses";
+    case RAW:
+      return "raw";
+    default:
+      return "unknown";
+  }
+}
+
+Counts Counts::operator-(const Counts &begin) const {
+  Counts result = *this;
+  for (int event = 0; event < EVENT_COUNT; event++) result[event] -= begin[event];
+  return result;
+}
+
+Counts &Counts::operator+=(const Counts &other) {
+  for (int event = 0; event < EVENT_COUNT; event++) values[event] += other[event];
+  return *this;
+}
+
+bool enable(const std::uint64_t raw_config) {
+  raw = raw_config;
+  current_generation++;
+  enabled = true;
+
+  group.open();
+  opened.fill(false);
+  for (const Event event : group.events) opened[event] = true;
+  if (group.leader < 0) {
+#ifdef __linux__
+    SPDLOG_WARN("Performance counters are not available: {}", std::strerror(group.error));
+#else
+    SPDLOG_WARN("Performance counters are only available on Linux");
+#endif
+    enabled = false;
+    return false;
+  }
+  if (!opened[CYCLES] || !opened[INSTRUCTIONS]) {
+    SPDLOG_WARN("Hardware performance counters are not available ({}), only the CPU time is counted",
+                std::strerror(group.error));
+  }
+  if (raw != 0 && !opened[RAW]) SPDLOG_WARN("Raw event {:#x} could not be opened", raw);
+  return true;
+}
+
+void disable() { enabled = false; }
+
+bool available(const Event event) { return opened[event]; }
+
+Counts read() {
+  Counts result;
+  if (!enabled) return result;
+  if (group.generation != current_generation) group.open();
+  if (group.leader < 0) return result;
+
+#ifdef __linux__
+  // number of values, time enabled, time running and the values in the order the events were opened
+  std::array<std::uint64_t, 3 + EVENT_COUNT> buffer{};
+  if (::read(group.leader, buffer.data(), sizeof(buffer)) < 0) return result;
+  // the kernel multiplexes the counters if there are not enough of them
+  const double scale =
+      buffer[2] > 0 && buffer[2] < buffer[1] ? static_cast<double>(buffer[1]) / static_cast<double>(buffer[2]) : 1.0;
+  for (size_t i = 0; i < group.events.size() && i < buffer[0]; i++) {
+    result[group.events[i]] = static_cast<double>(buffer[3 + i]) * scale;
+  }
+#endif
+  return result;
+}
+
+}  // namespace PerfCounters
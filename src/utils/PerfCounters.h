@@ -0,0 +1,89 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+/**
+ * @brief Hardware performance counters of the calling thread, read with Linux perf_event_open
+ *
+ * Every thread opens its own counter group the first time it reads the counters after enable(). The group is led by
+ * the task clock, which is always available, the hardware events are added if the CPU and the permissions allow it
+ * (see /proc/sys/kernel/perf_event_paranoid). If the kernel multiplexes the counters, the values are scaled to the
+ * time the group was enabled. On other systems the counters are never available.
+ */
+namespace PerfCounters {
+
+/**
+ * @brief Counted events
+ */
+enum Event : int {
+  /** @brief CPU time of the thread in nanoseconds */
+  TASK_CLOCK,
+  CYCLES,
+  INSTRUCTIONS,
+  /** @brief Accesses of the last level cache */
+  CACHE_REFERENCES,
+  /** @brief Misses of the last level cache */
+  CACHE_MISSES,
+  BRANCH_MISSES,
+  /** @brief CPU specific event, e.g. the retired vector instructions */
+  RAW,
+  EVENT_COUNT
+};
+
+/**
+ * @struct Counts
+ * @brief Value of every event
+ */
+struct Counts {
+  /** @brief Values indexed by Event */
+  std::array<double, EVENT_COUNT> values{};
+
+  double &operator[](const int event) { return values[event]; }
+  double operator[](const int event) const { return values[event]; }
+
+  /**
+   * @return Difference of two readings
+   */
+  Counts operator-(const Counts &begin) const;
+
+  /**
+   * @brief Adds the values of other
+   */
+  Counts &operator+=(const Counts &other);
+};
+
+/** @brief If the counters are read. Use enable() and disable() to change it */
+extern bool enabled;
+
+/**
+ * @param event Event
+ * @return Name of the event as shown in the summary
+ */
+const char *name(Event event);
+
+/**
+ * @brief Enables the counters and checks which events can be opened on the calling thread
+ *
+ * @param raw_config Config of the RAW event as given to `perf stat -e r<config>`, 0 to not count it
+ * @return If the counters could be opened
+ */
+bool enable(std::uint64_t raw_config = 0);
+
+/**
+ * @brief Disables the counters. The threads keep their counters open until they exit or enable() is called again
+ */
+void disable();
+
+/**
+ * @param event Event
+ * @return If the event was opened by enable()
+ */
+bool available(Event event);
+
+/**
+ * @return Current values of the counters of the calling thread, all 0 if they are disabled or could not be opened
+ */
+Counts read();
+
+}  // namespace PerfCounters
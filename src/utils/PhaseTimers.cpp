@@ -0,0 +1,256 @@
+#include "utils/PhaseTimers.h"
+
+#include <omp.h>
+#include <spdlog/fmt/fmt.h>
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <mutex>
+
+#include "utils/Tracing.h"
+
+namespace PhaseTimers {
+
+bool enabled = false;
+
+namespace {
+/**
+ * @brief Busy times of one thread, aligned so threads do not write to the same cache line
+ */
+struct alignas(64) ThreadBusy {
+  std::array<double, PHASE_COUNT> seconds{};
+  std::array<PerfCounters::Counts, PHASE_COUNT> counters{};
+};
+
+/** @brief Wall times and calls, only written outside of parallel regions */
+Totals totals;
+/** @brief Busy times of all threads */
+std::vector<ThreadBusy> busy;
+/** @brief Phase of the innermost running ScopedTimer */
+Phase current = STEP;
+
+double elapsed(std::chrono::steady_clock::time_point begin) {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+}
+}  // namespace
+
+const char *name(const Phase phase) {
+  switch (phase) {
+    case STEP:
+      return "step";
+    case UPDATE_X:
+      return "updateX";
+    case MOVE_PARTICLES:
+      return "moveParticles";
+    case UPDATE_GHOST:
+      return "updateGhost";
+    case RESET_F:
+      return "resetF";
+    case BONDS:
+      return "bonds";
+    case PAIRS_CELL:
+      return "pairs (cell)";
+    case PAIRS_INNER:
+      return "pairs (inner)";
+    case PAIRS_BORDER:
+      return "pairs (border)";
+    case FORCE_GROUPS:
+      return "forceGroups";
+    case UPDATE_V:
+      return "updateV";
+    case THERMOSTAT:
+      return "thermostat";
+    case OUTPUT:
+      return "output";
+    default:
+      return "unknown";
+  }
+}
+
+Totals Totals::operator-(const Totals &other) const {
+  Totals result = *this;
+  for (int phase = 0; phase < PHASE_COUNT; phase++) {
+    result.wall[phase] -= other.wall[phase];
+    result.calls[phase] -= other.calls[phase];
+    for (size_t thread = 0; thread < std::min(result.busy.size(), other.busy.size()); thread++) {
+      result.busy[thread][phase] -= other.busy[thread][phase];
+    }
+    for (size_t thread = 0; thread < std::min(result.counters.size(), other.counters.size()); thread++) {
+      result.counters[thread][phase] = result.counters[thread][phase] - other.counters[thread][phase];
+    }
+  }
+  return result;
+}
+
+Totals &Totals::operator+=(const Totals &other) {
+  if (busy.size() < other.busy.size()) busy.resize(other.busy.size());
+  if (counters.size() < other.counters.size()) counters.resize(other.counters.size());
+  for (int phase = 0; phase < PHASE_COUNT; phase++) {
+    wall[phase] += other.wall[phase];
+    calls[phase] += other.calls[phase];
+    for (size_t thread = 0; thread < other.busy.size(); thread++) busy[thread][phase] += other.busy[thread][phase];
+    for (size_t thread = 0; thread < other.counters.size(); thread++) {
+      counters[thread][phase] += other.counters[thread][phase];
+    }
+  }
+  return *this;
+}
+
+void enable() {
+  totals = Totals{};
+  busy.assign(omp_get_max_threads(), ThreadBusy{});
+  current = STEP;
+  enabled = true;
+}
+
+void disable() { enabled = false; }
+
+Totals snapshot() {
+  Totals result = totals;
+  result.busy.reserve(busy.size());
+  for (const auto &thread : busy) result.busy.push_back(thread.seconds);
+  if (PerfCounters::enabled) {
+    result.counters.reserve(busy.size());
+    for (const auto &thread : busy) result.counters.push_back(thread.counters);
+  }
+  return result;
+}
+
+std::string format(const Totals &totals) {
+  const double step = totals.wall[STEP];
+  const std::uint64_t steps = totals.calls[STEP];
+  std::string result = fmt::format("{:<16}{:>12}{:>14}{:>10}{:>14}{:>14}{:>11}\n", "phase", "total [s]",
+                                   "per step [ms]", "share", "busy avg [s]", "busy max [s]", "imbalance");
+
+  const auto row = [&](const std::string &phase_name, double wall, const double *thread_busy) {
+    const double per_step = steps > 0 ? wall / static_cast<double>(steps) * 1e3 : 0;
+    const double share = step > 0 ? wall / step * 100 : 0;
+    result += fmt::format("{:<16}{:>12.4f}{:>14.4f}{:>9.1f}%", phase_name, wall, per_step, share);
+    if (thread_busy == nullptr || totals.busy.empty()) {
+      result += "\n";
+      return;
+    }
+    double sum = 0;
+    double max = 0;
+    for (size_t thread = 0; thread < totals.busy.size(); thread++) {
+      sum += thread_busy[thread];
+      max = std::max(max, thread_busy[thread]);
+    }
+    const double average = sum / static_cast<double>(totals.busy.size());
+    result += fmt::format("{:>14.4f}{:>14.4f}{:>11.2f}\n", average, max, average > 0 ? max / average : 0);
+  };
+
+  double covered = 0;
+  std::vector<double> thread_busy(totals.busy.size());
+  for (int phase = STEP + 1; phase < PHASE_COUNT; phase++) {
+    if (totals.calls[phase] == 0) continue;
+    if (phase != OUTPUT) covered += totals.wall[phase];
+    bool parallel = false;
+    for (size_t thread = 0; thread < totals.busy.size(); thread++) {
+      thread_busy[thread] = totals.busy[thread][phase];
+      parallel |= thread_busy[thread] > 0;
+    }
+    row(name(static_cast<Phase>(phase)), totals.wall[phase], parallel ? thread_busy.data() : nullptr);
+  }
+  if (steps > 0) {
+    row("other", std::max(0.0, step - covered), nullptr);
+    row(name(STEP), step, nullptr);
+  }
+  return result;
+}
+
+std::array<PerfCounters::Counts, PHASE_COUNT> counterTotals(const Totals &totals) {
+  std::array<PerfCounters::Counts, PHASE_COUNT> sums{};
+  for (size_t thread = 0; thread < totals.counters.size(); thread++) {
+    for (int phase = 0; phase < PHASE_COUNT; phase++) {
+      sums[phase] += totals.counters[thread][phase];
+      // the first thread counts the whole step itself
+      if (thread > 0 && phase != STEP && phase != OUTPUT) sums[STEP] += totals.counters[thread][phase];
+    }
+  }
+  return sums;
+}
+
+std::string formatCounters(const Totals &totals) {
+  if (totals.counters.empty()) return "";
+  using PerfCounters::available;
+  const bool raw = available(PerfCounters::RAW);
+  std::string result = fmt::format("{:<16}{:>8}{:>12}{:>14}{:>8}{:>14}{:>11}{:>15}", "phase", "thread", "cpu [s]",
+                                   "instructions", "IPC", "cache misses", "miss rate", "branch misses");
+  result += raw ? fmt::format("{:>14}\n", "raw") : "\n";
+
+  const auto count = [](const PerfCounters::Counts &counts, const PerfCounters::Event event) {
+    return available(event) ? fmt::format("{:.4g}", counts[event]) : std::string("-");
+  };
+  const auto row = [&](const std::string &phase_name, const std::string &thread, const PerfCounters::Counts &counts) {
+    std::string ipc = "-";
+    if (available(PerfCounters::CYCLES) && available(PerfCounters::INSTRUCTIONS) && counts[PerfCounters::CYCLES] > 0) {
+      ipc = fmt::format("{:.2f}", counts[PerfCounters::INSTRUCTIONS] / counts[PerfCounters::CYCLES]);
+    }
+    std::string miss_rate = "-";
+    if (available(PerfCounters::CACHE_MISSES) && counts[PerfCounters::CACHE_REFERENCES] > 0) {
+      const double rate = counts[PerfCounters::CACHE_MISSES] / counts[PerfCounters::CACHE_REFERENCES];
+      miss_rate = fmt::format("{:.1f}%", rate * 100);
+    }
+    result += fmt::format("{:<16}{:>8}{:>12.4f}{:>14}{:>8}{:>14}{:>11}{:>15}", phase_name, thread,
+                          counts[PerfCounters::TASK_CLOCK] * 1e-9, count(counts, PerfCounters::INSTRUCTIONS), ipc,
+                          count(counts, PerfCounters::CACHE_MISSES), miss_rate,
+                          count(counts, PerfCounters::BRANCH_MISSES));
+    result += raw ? fmt::format("{:>14}\n", count(counts, PerfCounters::RAW)) : "\n";
+  };
+
+  const auto sums = counterTotals(totals);
+  for (int phase = STEP + 1; phase < PHASE_COUNT; phase++) {
+    if (totals.calls[phase] == 0) continue;
+    row(name(static_cast<Phase>(phase)), "all", sums[phase]);
+    if (totals.counters.size() < 2) continue;
+    for (size_t thread = 0; thread < totals.counters.size(); thread++) {
+      row("", std::to_string(thread), totals.counters[thread][phase]);
+    }
+  }
+  if (totals.calls[STEP] > 0) row(name(STEP), "all", sums[STEP]);
+  return result;
+}
+
+void ScopedTimer::start(const Phase measured_phase) {
+  // phases start outside of parallel regions, so the busy times can grow if the number of threads was raised
+  if (!omp_in_parallel()) {
+    const auto threads = static_cast<size_t>(omp_get_max_threads());
+    if (busy.size() < threads) busy.resize(threads);
+  }
+  active = true;
+  phase = measured_phase;
+  previous = current;
+  current = phase;
+  if (PerfCounters::enabled) counters_begin = PerfCounters::read();
+  begin = std::chrono::steady_clock::now();
+}
+
+void ScopedTimer::finish() {
+  if (Tracing::active) Tracing::record(name(phase), "phase", begin, std::chrono::steady_clock::now());
+  totals.wall[phase] += elapsed(begin);
+  totals.calls[phase]++;
+  if (PerfCounters::enabled && !busy.empty()) busy[0].counters[phase] += PerfCounters::read() - counters_begin;
+  current = previous;
+}
+
+void ThreadTimer::start() {
+  active = true;
+  // the first thread is already counted by the ScopedTimer
+  if (PerfCounters::enabled && omp_get_thread_num() != 0) counters_begin = PerfCounters::read();
+  begin = std::chrono::steady_clock::now();
+}
+
+void ThreadTimer::stop() {
+  const auto thread = static_cast<size_t>(omp_get_thread_num());
+  if (thread >= busy.size()) {
+    static std::once_flag warned;
+    std::call_once(warned, [thread] { SPDLOG_WARN("Thread {} has no phase timers, its time is not counted", thread); });
+    return;
+  }
+  if (Tracing::active) Tracing::record(name(current), "busy", begin, std::chrono::steady_clock::now());
+  busy[thread].seconds[current] += elapsed(begin);
+  if (PerfCounters::enabled && thread != 0) busy[thread].counters[current] += PerfCounters::read() - counters_begin;
+}
+
+}  // namespace PhaseTimers
@@ -0,0 +1,205 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "utils/PerfCounters.h"
+
+/**
+ * @brief Wall time and per thread busy time of the phases of an iteration
+ *
+ * The timers are always compiled in. While they are disabled a timer only checks a flag, so they can stay in the hot
+ * paths of release builds. A ScopedTimer measures the wall time of a phase on the thread that starts the parallel
+ * loops. Inside a parallel region, a ThreadTimer measures how long each thread works on the current phase until it
+ * runs out of iterations. The difference between the slowest and the average thread shows the load imbalance.
+ * If PerfCounters are enabled as well, the timers also read the hardware counters of their thread for every phase.
+ */
+namespace PhaseTimers {
+
+/**
+ * @brief Measured phases. STEP covers a complete iteration, the others are parts of it
+ */
+enum Phase : int {
+  STEP,
+  UPDATE_X,
+  MOVE_PARTICLES,
+  UPDATE_GHOST,
+  RESET_F,
+  BONDS,
+  PAIRS_CELL,
+  PAIRS_INNER,
+  PAIRS_BORDER,
+  FORCE_GROUPS,
+  UPDATE_V,
+  THERMOSTAT,
+  /** @brief Handing the particles to the writers, measured between the iterations and not part of STEP */
+  OUTPUT,
+  PHASE_COUNT
+};
+
+/**
+ * @param phase Phase
+ * @return Name of the phase as shown in the summary
+ */
+const char *name(Phase phase);
+
+/**
+ * @struct Totals
+ * @brief Accumulated times of all phases
+ */
+struct Totals {
+  /** @brief Wall time in seconds */
+  std::array<double, PHASE_COUNT> wall{};
+  /** @brief Number of times the phase was measured */
+  std::array<std::uint64_t, PHASE_COUNT> calls{};
+  /** @brief Busy time in seconds of every thread, indexed by thread and phase */
+  std::vector<std::array<double, PHASE_COUNT>> busy;
+  /**
+   * @brief Performance counters of every thread, indexed by thread and phase. Empty if PerfCounters are disabled
+   *
+   * The first thread counts everything it does while the ScopedTimer of the phase runs, the other threads only their
+   * share of the parallel regions.
+   */
+  std::vector<std::array<PerfCounters::Counts, PHASE_COUNT>> counters;
+
+  /**
+   * @return Times accumulated between other and this
+   */
+  Totals operator-(const Totals &other) const;
+
+  /**
+   * @brief Adds the times of other
+   */
+  Totals &operator+=(const Totals &other);
+};
+
+/** @brief If the timers record anything. Use enable() and disable() to change it */
+extern bool enabled;
+
+/**
+ * @brief Resets all times and enables the timers for the current number of OpenMP threads
+ *
+ * If the number of threads is raised later, the next ScopedTimer adds the missing threads.
+ */
+void enable();
+
+/**
+ * @brief Disables the timers, the recorded times are kept
+ */
+void disable();
+
+/**
+ * @return Copy of the times recorded since enable()
+ */
+Totals snapshot();
+
+/**
+ * @brief Formats the times as a table with one row per phase
+ *
+ * Phases that were never measured are left out. The wall time of the step that is not covered by a phase is shown as
+ * "other".
+ * @param totals Recorded times
+ * @return Table with total and per step wall time, share of the step and busy time of the threads
+ */
+std::string format(const Totals &totals);
+
+/**
+ * @brief Sums up the performance counters of all threads
+ *
+ * The other threads only count inside of the phases, so their share of STEP is the sum of all their phases.
+ * @param totals Recorded times and counters
+ * @return Counters of every phase, all 0 if no counters were recorded
+ */
+std::array<PerfCounters::Counts, PHASE_COUNT> counterTotals(const Totals &totals);
+
+/**
+ * @brief Formats the performance counters as a table with one row per phase and one per phase and thread
+ *
+ * Shows the CPU time, the instructions per cycle and the cache and branch misses. A low number of instructions per
+ * cycle together with many cache misses shows a memory bound phase.
+ * @param totals Recorded times and counters
+ * @return Table of the counters, empty if no counters were recorded
+ */
+std::string formatCounters(const Totals &totals);
+
+/**
+ * @class ScopedTimer
+ * @brief Adds the wall time until its destruction to a phase
+ *
+ * Must be created outside of parallel regions. ThreadTimers started while it exists add to its phase.
+ */
+class ScopedTimer {
+ public:
+  /**
+   * @param phase Phase the time is added to
+   */
+  explicit ScopedTimer(Phase phase) {
+    if (enabled) start(phase);
+  }
+
+  ~ScopedTimer() { stop(); }
+
+  ScopedTimer(const ScopedTimer &) = delete;
+  ScopedTimer &operator=(const ScopedTimer &) = delete;
+
+  /**
+   * @brief Adds the time to the phase before the end of the scope. Later calls have no effect
+   */
+  void stop() {
+    if (!active) return;
+    active = false;
+    finish();
+  }
+
+ private:
+  /** @brief If the timer was started */
+  bool active = false;
+  /** @brief Measured phase */
+  Phase phase = STEP;
+  /** @brief Phase of the enclosing timer, restored on destruction */
+  Phase previous = STEP;
+  /** @brief Start of the measurement */
+  std::chrono::steady_clock::time_point begin;
+  /** @brief Performance counters at the start of the measurement */
+  PerfCounters::Counts counters_begin;
+
+  void start(Phase measured_phase);
+  void finish();
+};
+
+/**
+ * @class ThreadTimer
+ * @brief Adds the time until its destruction to the busy time of the calling thread in the current phase
+ *
+ * Create it at the start of a parallel region and end the worksharing loop with `nowait`, so every thread stops its
+ * timer as soon as it has no more work.
+ */
+class ThreadTimer {
+ public:
+  ThreadTimer() {
+    if (enabled) start();
+  }
+
+  ~ThreadTimer() {
+    if (active) stop();
+  }
+
+  ThreadTimer(const ThreadTimer &) = delete;
+  ThreadTimer &operator=(const ThreadTimer &) = delete;
+
+ private:
+  /** @brief If the timer was started */
+  bool active = false;
+  /** @brief Start of the measurement */
+  std::chrono::steady_clock::time_point begin;
+  /** @brief Performance counters at the start of the measurement */
+  PerfCounters::Counts counters_begin;
+
+  void start();
+  void stop();
+};
+
+}  // namespace PhaseTimers
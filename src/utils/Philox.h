@@ -0,0 +1,84 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+
+/**
+ * @brief Counter-based random number generator Philox4x32-10
+ *
+ * Salmon et al., "Parallel Random Numbers: As Easy as 1, 2, 3" (SC '11).
+ * Every call maps a (counter, key) pair to four random 32 bit integers without any internal state. Using e.g. the
+ * particle index as counter and the seed as key, random numbers can be drawn in parallel and the result does not
+ * depend on the number of threads or the iteration order.
+ */
+namespace Philox {
+
+/** @brief 128 bit counter, which is also the shape of the result */
+using Counter = std::array<std::uint32_t, 4>;
+/** @brief 64 bit key */
+using Key = std::array<std::uint32_t, 2>;
+
+/** @brief Multiplier of the first and the third word */
+constexpr std::uint32_t M0 = 0xD2511F53;
+/** @brief Multiplier of the second and the fourth word */
+constexpr std::uint32_t M1 = 0xCD9E8D57;
+/** @brief Weyl sequence constant to bump the first key word (golden ratio) */
+constexpr std::uint32_t W0 = 0x9E3779B9;
+/** @brief Weyl sequence constant to bump the second key word (sqrt(3) - 1) */
+constexpr std::uint32_t W1 = 0xBB67AE85;
+/** @brief Number of rounds, 10 is the recommended value that passes BigCrush with a safety margin */
+constexpr int ROUNDS = 10;
+
+/**
+ * @brief Maps a counter and a key to four random 32 bit integers
+ * @param counter counter, e.g. {particle index (low), particle index (high), stream, 0}
+ * @param key key, e.g. the seed
+ * @return four independent, uniformly distributed 32 bit integers
+ */
+constexpr Counter philox4x32(Counter counter, Key key) {
+  for (int round = 0; round < ROUNDS; round++) {
+    const std::uint64_t product0 = static_cast<std::uint64_t>(M0) * counter[0];
+    const std::uint64_t product1 = static_cast<std::uint64_t>(M1) * counter[2];
+    const auto hi0 = static_cast<std::uint32_t>(product0 >> 32);
+    const auto lo0 = static_cast<std::uint32_t>(product0);
+    const auto hi1 = static_cast<std::uint32_t>(product1 >> 32);
+    const auto lo1 = static_cast<std::uint32_t>(product1);
+
+    counter = {hi1 ^ counter[1] ^ key[0], lo1, hi0 ^ counter[3] ^ key[1], lo0};
+    key = {key[0] + W0, key[1] + W1};
+  }
+  return counter;
+}
+
+/**
+ * @brief Converts a random integer to a double in the open interval (0, 1)
+ * @param x random 32 bit integer
+ * @return uniformly distributed double, never exactly 0 or 1
+ */
+constexpr double toUniform(std::uint32_t x) { return (static_cast<double>(x) + 0.5) * 0x1p-32; }
+
+/**
+ * @brief Draws four independent standard normal distributed numbers with the Box-Muller transform
+ *
+ * \f[
+ *   z_0 = \sqrt{-2 \ln u_0} \cos(2 \pi u_1), \quad z_1 = \sqrt{-2 \ln u_0} \sin(2 \pi u_1)
+ * \f]
+ *
+ * @param counter counter of the draw
+ * @param key key of the draw
+ * @return four independent numbers with mean 0 and variance 1
+ */
+inline std::array<double, 4> normal(const Counter &counter, const Key &key) {
+  const Counter bits = philox4x32(counter, key);
+  std::array<double, 4> result{};
+  for (int i = 0; i < 4; i += 2) {
+    const double radius = std::sqrt(-2 * std::log(toUniform(bits[i])));
+    const double angle = 2 * M_PI * toUniform(bits[i + 1]);
+    result[i] = radius * std::cos(angle);
+    result[i + 1] = radius * std::sin(angle);
+  }
+  return result;
+}
+
+}  // namespace Philox
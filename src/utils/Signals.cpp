@@ -0,0 +1,29 @@
+#include "utils/Signals.h"
+
+#include <signal.h>
+
+#include <initializer_list>
+
+namespace Signals {
+
+namespace {
+/** @brief First received signal, only written by the handler */
+volatile sig_atomic_t received_signal = 0;
+
+void handle(const int signal) {
+  if (received_signal == 0) received_signal = signal;
+}
+}  // namespace
+
+void installHandlers() {
+  struct sigaction action {};
+  action.sa_handler = handle;
+  sigemptyset(&action.sa_mask);
+  // restore the default action after the first signal, so a second one terminates immediately
+  action.sa_flags = SA_RESETHAND | SA_RESTART;
+  for (const int signal : {SIGTERM, SIGINT, SIGUSR1}) sigaction(signal, &action, nullptr);
+}
+
+int received() { return received_signal; }
+
+}  // namespace Signals
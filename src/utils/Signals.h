@@ -0,0 +1,21 @@
+#pragma once
+
+/**
+ * @brief Handling of termination requests from the job scheduler or the user
+ *
+ * The handlers only record the signal, the simulation checks it between two iterations, writes a checkpoint and stops.
+ * A second signal of the same kind uses the default action, so a hanging simulation can still be terminated.
+ */
+namespace Signals {
+
+/**
+ * @brief Installs the handlers for SIGTERM, SIGINT and SIGUSR1
+ */
+void installHandlers();
+
+/**
+ * @return Number of the first received signal, or 0 if none was received
+ */
+int received();
+
+}  // namespace Signals
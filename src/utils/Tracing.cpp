@@ -0,0 +1,198 @@
+#include "utils/Tracing.h"
+
+#include <omp.h>
+#include <spdlog/fmt/fmt.h>
+#include <spdlog/spdlog.h>
+
+#include <fstream>
+#include <mutex>
+#include <vector>
+
+namespace Tracing {
+
+bool active = false;
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+/** @brief Events each thread can record. Later events are dropped, so recording never allocates */
+constexpr size_t CAPACITY = 1 << 15;
+
+/**
+ * @brief Completed event, times in nanoseconds since enable()
+ */
+struct Event {
+  const char *name;
+  const char *category;
+  std::int64_t begin;
+  std::int64_t end;
+  /** @brief First iteration of a chunk */
+  std::uint64_t first = 0;
+  /** @brief Number of iterations of a chunk, 0 for other events */
+  std::uint64_t count = 0;
+};
+
+/**
+ * @brief Events of one thread. Only written by its thread, aligned so threads do not write to the same cache line
+ */
+struct alignas(64) ThreadBuffer {
+  std::vector<Event> events;
+  /** @brief Events that did not fit into the buffer */
+  std::uint64_t dropped = 0;
+
+  /** @brief If a chunk was started and not yet added to the events */
+  bool chunk_open = false;
+  const char *chunk_loop = nullptr;
+  std::uint64_t chunk_first = 0;
+  std::uint64_t chunk_last = 0;
+  std::int64_t chunk_begin = 0;
+  std::int64_t chunk_end = 0;
+
+  void add(const Event &event) {
+    if (events.size() < events.capacity()) {
+      events.push_back(event);
+    } else {
+      dropped++;
+    }
+  }
+
+  void closeChunk() {
+    if (!chunk_open) return;
+    chunk_open = false;
+    add({chunk_loop, "chunk", chunk_begin, chunk_end, chunk_first, chunk_last - chunk_first + 1});
+  }
+};
+
+std::vector<ThreadBuffer> buffers;
+std::filesystem::path file;
+std::uint64_t window_first = 0;
+std::uint64_t window_last = 0;
+/** @brief If the trace still has to be written */
+bool enabled = false;
+/** @brief Time zero of the trace */
+Clock::time_point origin;
+
+std::int64_t since(const Clock::time_point time) {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(time - origin).count();
+}
+
+/**
+ * @return Buffer of the calling thread, nullptr if the thread has none, e.g. in a nested parallel region
+ */
+ThreadBuffer *buffer() {
+  const auto thread = static_cast<size_t>(omp_get_thread_num());
+  if (thread < buffers.size()) return &buffers[thread];
+  if (!buffers.empty()) {
+    static std::once_flag warned;
+    std::call_once(warned, [thread] { SPDLOG_WARN("Thread {} has no trace buffer, its events are dropped", thread); });
+  }
+  return nullptr;
+}
+
+/**
+ * @brief Adds buffers for threads that were added since the last call. Only called outside of parallel regions
+ */
+void growBuffers() {
+  const auto threads = static_cast<size_t>(omp_get_max_threads());
+  if (buffers.size() >= threads) return;
+  buffers.resize(threads);
+  for (auto &thread : buffers) thread.events.reserve(CAPACITY);
+}
+
+void write() {
+  std::ofstream out(file);
+  if (!out.is_open()) {
+    SPDLOG_ERROR("Error opening {}", file.string());
+    return;
+  }
+
+  size_t count = 0;
+  std::uint64_t dropped = 0;
+  bool first = true;
+  const auto separate = [&out, &first]() {
+    out << (first ? "" : ",\n");
+    first = false;
+  };
+  out << "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [\n";
+  for (size_t thread = 0; thread < buffers.size(); thread++) {
+    separate();
+    out << fmt::format(R"(  {{"name": "thread_name", "ph": "M", "pid": 1, "tid": {}, )", thread)
+        << fmt::format(R"("args": {{"name": "thread {}"}}}})", thread);
+  }
+  for (size_t thread = 0; thread < buffers.size(); thread++) {
+    dropped += buffers[thread].dropped;
+    for (const auto &event : buffers[thread].events) {
+      separate();
+      // the trace format uses microseconds
+      out << fmt::format(R"(  {{"name": "{}", "cat": "{}", "ph": "X", "pid": 1, "tid": {}, )", event.name,
+                         event.category, thread)
+          << fmt::format(R"("ts": {:.3f}, "dur": {:.3f})", event.begin * 1e-3, (event.end - event.begin) * 1e-3);
+      if (event.count > 0) out << fmt::format(R"(, "args": {{"first": {}, "count": {}}})", event.first, event.count);
+      out << "}";
+      count++;
+    }
+  }
+  out << "\n]}\n";
+
+  SPDLOG_INFO("Wrote {} trace events of iterations {} to {} to {}", count, window_first, window_last, file.string());
+  if (dropped > 0) SPDLOG_WARN("{} trace events did not fit into the buffers, shorten the step window", dropped);
+}
+}  // namespace
+
+void enable(const std::filesystem::path &filename, const std::uint64_t first, const std::uint64_t last) {
+  file = filename;
+  window_first = first;
+  window_last = last;
+  buffers.clear();
+  growBuffers();
+  origin = Clock::now();
+  active = false;
+  enabled = true;
+}
+
+void step(const std::uint64_t iteration) {
+  if (!enabled) return;
+  // the number of threads may have been raised since the last iteration
+  growBuffers();
+  active = iteration >= window_first && iteration <= window_last;
+  if (iteration > window_last) finish();
+}
+
+void finish() {
+  if (!enabled) return;
+  active = false;
+  enabled = false;
+  closeChunks();
+  write();
+  buffers.clear();
+  buffers.shrink_to_fit();
+}
+
+void record(const char *name, const char *category, const Clock::time_point begin, const Clock::time_point end) {
+  if (auto *thread = buffer()) thread->add({name, category, since(begin), since(end)});
+}
+
+void closeChunks() {
+  for (auto &thread : buffers) thread.closeChunk();
+}
+
+void Iteration::begin(const char *loop, const std::uint64_t index) {
+  auto *thread = buffer();
+  if (thread == nullptr) return;
+  started = true;
+  // the scheduler handed out the next iteration of the same loop, so this is still the same chunk
+  if (thread->chunk_open && thread->chunk_loop == loop && index == thread->chunk_last + 1) {
+    thread->chunk_last = index;
+    return;
+  }
+  thread->closeChunk();
+  thread->chunk_open = true;
+  thread->chunk_loop = loop;
+  thread->chunk_first = index;
+  thread->chunk_last = index;
+  thread->chunk_begin = since(Clock::now());
+}
+
+void Iteration::end() { buffer()->chunk_end = since(Clock::now()); }
+
+}  // namespace Tracing
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+
+/**
+ * @brief Timeline of the phases and loop chunks of every thread, exported in the Chrome trace format
+ *
+ * Every OpenMP thread writes into its own preallocated buffer, so recording needs neither locks nor allocations.
+ * Events are only recorded for the iterations of the step window. The phases come from the PhaseTimers, which must be
+ * enabled as well. The loops of the pair traversal additionally record which thread worked on which chunk of cells.
+ * The file can be opened in https://ui.perfetto.dev or chrome://tracing to see idle threads and stragglers.
+ */
+namespace Tracing {
+
+/** @brief If the current iteration is inside the step window. Only changed by step() */
+extern bool active;
+
+/**
+ * @brief Prepares the buffers for the current number of OpenMP threads
+ *
+ * If the number of threads is raised later, step() adds the missing buffers.
+ * @param filename File the trace is written to at the end of the window or by finish()
+ * @param first First traced iteration, counted from the start of the run
+ * @param last Last traced iteration, counted from the start of the run
+ */
+void enable(const std::filesystem::path &filename, std::uint64_t first, std::uint64_t last);
+
+/**
+ * @brief Starts an iteration. Enables the recording inside the step window and writes the trace after it
+ * @param iteration Iteration counted from the start of the run
+ */
+void step(std::uint64_t iteration);
+
+/**
+ * @brief Writes the trace if the run ended before the end of the window and disables the tracing
+ */
+void finish();
+
+/**
+ * @brief Records a completed event on the calling thread
+ *
+ * @param name Name of the event, must outlive the tracing
+ * @param category Category of the event, must outlive the tracing
+ * @param begin Start of the event
+ * @param end End of the event
+ */
+void record(const char *name, const char *category, std::chrono::steady_clock::time_point begin,
+            std::chrono::steady_clock::time_point end);
+
+/**
+ * @brief Ends the open chunks of all threads. Call it outside of parallel regions after the traced loops
+ */
+void closeChunks();
+
+/**
+ * @class Iteration
+ * @brief Marks one iteration of a traced loop
+ *
+ * Consecutive iterations on the same thread are merged into one chunk, so the trace shows how the scheduler
+ * distributed the loop.
+ */
+class Iteration {
+ public:
+  /**
+   * @param loop Name of the loop, must outlive the tracing
+   * @param index Index of the iteration
+   */
+  Iteration(const char *loop, const std::uint64_t index) {
+    if (active) begin(loop, index);
+  }
+
+  ~Iteration() {
+    if (started) end();
+  }
+
+  Iteration(const Iteration &) = delete;
+  Iteration &operator=(const Iteration &) = delete;
+
+ private:
+  /** @brief If the iteration was recorded */
+  bool started = false;
+
+  void begin(const char *loop, std::uint64_t index);
+  void end();
+};
+
+}  // namespace Tracing
@@ -0,0 +1,119 @@
+/**
+ * @file TestAsyncWriter.cpp
+ *
+ * Contains tests for the asynchronous output writer
+ */
+
+#include <gtest/gtest.h>
+#include <omp.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "outputWriter/AsyncWriter.h"
+
+/**
+ * @test All frames are written in submission order, with the particles at the time of submission
+ */
+TEST(AsyncWriter, WritesSnapshotsInOrder) {
+  std::vector<Particle> particles;
+  particles.emplace_back(Vector3{0, 0, 0}, Vector3{0, 0, 0}, 1.0, 0);
+
+  std::vector<int> iterations;
+  std::vector<double> positions;
+  {
+    outputWriter::AsyncWriter writer([&](outputWriter::AsyncWriter::Frame &frame) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      iterations.push_back(frame.iteration);
+      positions.push_back(frame.particles.x[0][0]);
+    });
+
+    for (int i = 0; i < 10; i++) {
+      particles[0].setX({static_cast<double>(i), 0, 0});
+      writer.submit(particles, "test", i, 0.1 * i);
+    }
+  }
+
+  ASSERT_EQ(iterations.size(), 10);
+  for (int i = 0; i < 10; i++) {
+    EXPECT_EQ(iterations[i], i);
+    EXPECT_DOUBLE_EQ(positions[i], i);
+  }
+}
+
+/**
+ * @test submit() blocks if all buffers are in use, so never more than the given number of frames are in flight
+ */
+TEST(AsyncWriter, Backpressure) {
+  std::vector<Particle> particles(10);
+  std::atomic<int> submitted = 0;
+  std::atomic<int> written = 0;
+  std::atomic<int> max_in_flight = 0;
+
+  outputWriter::AsyncWriter writer(
+      [&](outputWriter::AsyncWriter::Frame &) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        max_in_flight = std::max(max_in_flight.load(), submitted - written);
+        written++;
+      },
+      2);
+
+  for (int i = 0; i < 20; i++) {
+    writer.submit(particles, "test", i, 0);
+    submitted++;
+  }
+  writer.flush();
+
+  EXPECT_EQ(written, 20);
+  EXPECT_LE(max_in_flight, 2);
+  EXPECT_GT(writer.getStallTime().count(), 0);
+}
+
+/**
+ * @test Parallel regions of the writers run with a single thread, so they do not compete with the simulation
+ */
+TEST(AsyncWriter, WritesWithOneThread) {
+  std::vector<Particle> particles(1);
+  int team = 0;
+  {
+    outputWriter::AsyncWriter writer([&](outputWriter::AsyncWriter::Frame &) {
+#pragma omp parallel
+#pragma omp single
+      team = omp_get_num_threads();
+    });
+    writer.submit(particles, "test", 0, 0);
+  }
+  EXPECT_EQ(team, 1);
+}
+
+/**
+ * @test A snapshot holds the written fields of every particle and keeps its memory when reused for fewer particles
+ */
+TEST(AsyncWriter, SnapshotCopiesWrittenFields) {
+  std::vector<Particle> particles;
+  for (int i = 0; i < 5; i++) {
+    particles.emplace_back(Vector3{1.0 * i, 0, 0}, Vector3{0, 2.0 * i, 0}, 0.5 * i, i);
+    particles.back().setF({0, 0, 3.0 * i});
+    particles.back().setState(i % 2);
+  }
+
+  outputWriter::ParticleSnapshot snapshot(particles);
+  ASSERT_EQ(snapshot.size(), particles.size());
+  for (size_t i = 0; i < particles.size(); i++) {
+    EXPECT_EQ(snapshot.x[i], particles[i].getX());
+    EXPECT_EQ(snapshot.v[i], particles[i].getV());
+    EXPECT_EQ(snapshot.f[i], particles[i].getF());
+    EXPECT_DOUBLE_EQ(snapshot.m[i], particles[i].getM());
+    EXPECT_EQ(snapshot.type[i], particles[i].getType());
+    EXPECT_EQ(snapshot.state[i], particles[i].getState());
+  }
+
+  const size_t bytes = snapshot.memoryUsage();
+  EXPECT_GE(bytes, particles.size() * outputWriter::ParticleSnapshot::BYTES_PER_PARTICLE);
+  particles.pop_back();
+  snapshot.assign(particles);
+  EXPECT_EQ(snapshot.size(), particles.size());
+  EXPECT_EQ(snapshot.memoryUsage(), bytes);
+}
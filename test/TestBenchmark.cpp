@@ -0,0 +1,71 @@
+/**
+ * @file TestBenchmark.cpp
+ *
+ * Contains tests for the benchmark mode
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "benchmark/Benchmark.h"
+
+/**
+ * @test Median, mean and sample standard deviation of known samples
+ */
+TEST(Benchmark, Statistics) {
+  const auto odd = Benchmark::summarize(std::vector<double>{4, 1, 3});
+  EXPECT_DOUBLE_EQ(odd.median, 3);
+  EXPECT_DOUBLE_EQ(odd.mean, 8.0 / 3.0);
+  EXPECT_DOUBLE_EQ(odd.min, 1);
+  EXPECT_DOUBLE_EQ(odd.max, 4);
+
+  const auto even = Benchmark::summarize(std::vector<double>{2, 4, 4, 4, 5, 5, 7, 9});
+  EXPECT_DOUBLE_EQ(even.median, 4.5);
+  EXPECT_DOUBLE_EQ(even.mean, 5);
+  EXPECT_DOUBLE_EQ(even.stddev, std::sqrt(32.0 / 7.0));
+
+  EXPECT_DOUBLE_EQ(Benchmark::summarize(std::vector<double>{1.5}).stddev, 0);
+}
+
+/**
+ * @test Every repetition starts from the unchanged input and splits the iterations into warmup and measured ones
+ */
+TEST(Benchmark, Repetitions) {
+  std::vector<Particle> particles;
+  for (int i = 0; i < 16; i++) {
+    particles.emplace_back(Vector3{1.0 + 1.2 * (i % 4), 1.0 + 1.2 * (i / 4), 0.5}, Vector3{0.1 * (i % 3), 0, 0}, 1.0,
+                           0);
+  }
+  const std::vector<Particle> input = particles;
+
+  Settings settings(particles);
+  settings.simulation.worksheet = 3;
+  // exactly representable, so the simulation has exactly 50 iterations
+  settings.simulation.delta_t = 1.0 / 256;
+  settings.simulation.end_time = 50.0 / 256;
+  settings.simulation.domain = {8, 8, 1};
+  settings.simulation.cutoff_radius = 2.5;
+  settings.simulation.is2D = true;
+  settings.simulation.borders = std::array<BorderType, 6>{BorderType::REFLECTION, BorderType::REFLECTION,
+                                                          BorderType::REFLECTION, BorderType::REFLECTION,
+                                                          BorderType::REFLECTION, BorderType::REFLECTION};
+  settings.benchmark.emplace();
+  settings.benchmark->warmup = 10;
+
+  for (int repetition = 0; repetition < 2; repetition++) {
+    const auto result = Benchmark::runOnce(particles, settings);
+    EXPECT_EQ(result.warmup_steps, 10);
+    EXPECT_EQ(result.measured_steps, 40);
+    EXPECT_GT(result.measured, 0);
+  }
+  for (size_t i = 0; i < particles.size(); i++) {
+    EXPECT_EQ(particles[i].getX(), input[i].getX());
+    EXPECT_EQ(particles[i].getV(), input[i].getV());
+  }
+
+  const auto phases = Benchmark::summarize({Benchmark::runOnce(particles, settings)}, particles.size());
+  ASSERT_EQ(phases.size(), 3);
+  EXPECT_EQ(phases[2].name, "measured");
+  EXPECT_GT(phases[2].mups.median, 0);
+}
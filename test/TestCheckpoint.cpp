@@ -0,0 +1,210 @@
+/**
+ * @file TestCheckpoint.cpp
+ *
+ * Contains tests for writing and restoring binary checkpoints
+ */
+
+#include <gtest/gtest.h>
+#include <omp.h>
+
+#include <filesystem>
+#include <sstream>
+
+#include "Settings.h"
+#include "container/linkedCells/LinkedCells.h"
+#include "inputReader/CheckpointReader.h"
+#include "inputReader/YAMLReader.h"
+#include "outputWriter/CheckpointWriter.h"
+#include "simulations/CutoffSimulation.h"
+
+/**
+ * @test A checkpoint restores the complete particle state, the membrane bonds, force groups and settings
+ */
+TEST(Checkpoint, RoundTrip) {
+  std::vector<Particle> particles;
+  Settings settings(particles);
+
+  std::stringstream input;
+  input << "simulation:\n"
+           "  worksheet: 5\n"
+           "  end_time: 20\n"
+           "  delta_t: 0.01\n"
+           "  temp_initial: 40\n"
+           "  brown_motion_avg_velocity: 0.1\n"
+           "particles:\n"
+           "  - membrane:\n"
+           "      position: [0, 0, 0]\n"
+           "      size: [3, 3, 1]\n"
+           "      distance: 1.0\n"
+           "      mass: 1.0\n"
+           "      velocity: [0, 0, 0]\n"
+           "      k: 300\n"
+           "      r0: 1.2\n"
+           "      f_zUp: 0.8\n"
+           "      upwards_particles_indexes: [[1, 1]]\n";
+  YAMLReader::parse(particles, input, settings);
+
+  particles[2] = Particle({1, 2, 3}, {4, 5, 6}, 7, 0.5, 1.5, {8, 9, 10}, {11, 12, 13}, 3);
+  particles[3].setState(1);
+  particles[4].setState(-1);
+
+  const auto filename = std::filesystem::temp_directory_path() / "molsim_test_checkpoint.bin";
+  ASSERT_TRUE(outputWriter::writeCheckpoint(particles, settings, filename, 1234, 12.34, 0.02));
+
+  std::vector<Particle> restored;
+  Settings restored_settings(restored);
+  EXPECT_EQ(CheckpointReader::readFile(restored, filename, restored_settings), 1234);
+  ASSERT_TRUE(restored_settings.restart.has_value());
+  EXPECT_EQ(restored_settings.restart->delta_t, 0.02);
+  std::filesystem::remove(filename);
+
+  ASSERT_EQ(restored.size(), particles.size());
+  for (size_t i = 0; i < particles.size(); i++) {
+    EXPECT_EQ(restored[i].getX(), particles[i].getX());
+    EXPECT_EQ(restored[i].getV(), particles[i].getV());
+    EXPECT_EQ(restored[i].getF(), particles[i].getF());
+    EXPECT_EQ(restored[i].getOldF(), particles[i].getOldF());
+    EXPECT_EQ(restored[i].getM(), particles[i].getM());
+    EXPECT_EQ(restored[i].getEpsilon(), particles[i].getEpsilon());
+    EXPECT_EQ(restored[i].getSigma(), particles[i].getSigma());
+    EXPECT_EQ(restored[i].getType(), particles[i].getType());
+    EXPECT_EQ(restored[i].getState(), particles[i].getState());
+  }
+
+  const auto &bonds = settings.membrane.bonds.bonds;
+  const auto &restored_bonds = restored_settings.membrane.bonds.bonds;
+  ASSERT_EQ(restored_bonds.size(), bonds.size());
+  for (size_t b = 0; b < bonds.size(); b++) {
+    EXPECT_EQ(restored_bonds[b].i, bonds[b].i);
+    EXPECT_EQ(restored_bonds[b].j, bonds[b].j);
+    EXPECT_EQ(restored_bonds[b].type, bonds[b].type);
+    EXPECT_EQ(restored_bonds[b].rest_length, bonds[b].rest_length);
+  }
+  EXPECT_EQ(restored_settings.membrane.r0, 1.2);
+  EXPECT_EQ(restored_settings.membrane.k, 300);
+
+  ASSERT_EQ(restored_settings.force_groups.size(), 1);
+  EXPECT_EQ(restored_settings.force_groups[0].indices, settings.force_groups[0].indices);
+
+  // the simulation continues at the time of the checkpoint without reinitializing the velocities
+  EXPECT_EQ(restored_settings.simulation.start_time, 12.34);
+  EXPECT_EQ(restored_settings.simulation.end_time, 20);
+  EXPECT_FALSE(restored_settings.simulation.t_initial.has_value());
+  EXPECT_EQ(restored_settings.simulation.t_final, 40);
+  EXPECT_FALSE(restored_settings.simulation.brown_motion_avg_velocity.has_value());
+}
+
+/**
+ * @test A simulation continued from a checkpoint ends in exactly the same state as an uninterrupted one
+ */
+TEST(Checkpoint, ResumeIsBitIdentical) {
+  const Vector3 domain = {10, 10, 1};
+  const std::array<BorderType, 6> borders = {BorderType::PERIODIC, BorderType::PERIODIC, BorderType::PERIODIC,
+                                             BorderType::PERIODIC, BorderType::PERIODIC, BorderType::PERIODIC};
+  // with several threads the forces are not summed up in a reproducible order
+  const int threads = omp_get_max_threads();
+  omp_set_num_threads(1);
+
+  std::vector<Particle> uninterrupted;
+  for (int i = 0; i < 36; i++) {
+    uninterrupted.emplace_back(Vector3{1.0 + 1.4 * (i % 6), 1.0 + 1.4 * (i / 6), 0.5},
+                               Vector3{0.5 * (i * 7 % 5 - 2), 0.5 * (i * 3 % 4 - 1.5), 0}, 1.0, 0);
+  }
+  std::vector<Particle> interrupted = uninterrupted;
+
+  LinkedCells cells(uninterrupted, domain, 2.5, true, borders);
+  CutoffSimulation(cells, 0, 2, 0.005, std::nullopt, domain, 2.5, borders, true, 0).run([](unsigned int) {});
+
+  const auto filename = std::filesystem::temp_directory_path() / "molsim_test_resume.bin";
+  {
+    std::vector<Particle> particles_copy;
+    Settings settings(particles_copy);
+    LinkedCells first_cells(interrupted, domain, 2.5, true, borders);
+    CutoffSimulation first(first_cells, 0, 1, 0.005, std::nullopt, domain, 2.5, borders, true, 0);
+    first.run([](unsigned int) {});
+    ASSERT_TRUE(outputWriter::writeCheckpoint(interrupted, settings, filename, first.getCurrentIteration(),
+                                              first.getCurrentTime(), first.getDeltaT(), first_cells.getCellOrder()));
+  }
+
+  std::vector<Particle> restored;
+  Settings settings(restored);
+  CheckpointReader::readFile(restored, filename, settings);
+  std::filesystem::remove(filename);
+
+  LinkedCells restored_cells(restored, domain, 2.5, true, borders);
+  ASSERT_TRUE(restored_cells.setCellOrder(settings.restart->cell_order));
+  CutoffSimulation second(restored_cells, settings.simulation.start_time, 2, 0.005, std::nullopt, domain, 2.5, borders,
+                          true, 0);
+  second.resume(settings.restart->iteration, settings.restart->delta_t);
+  second.run([](unsigned int) {});
+  omp_set_num_threads(threads);
+
+  ASSERT_EQ(restored.size(), uninterrupted.size());
+  for (size_t i = 0; i < restored.size(); i++) {
+    EXPECT_EQ(restored[i].getX(), uninterrupted[i].getX());
+    EXPECT_EQ(restored[i].getV(), uninterrupted[i].getV());
+  }
+}
+
+/**
+ * @test Records are written in chunks, a checkpoint with several chunks of particles and cell entries is restored
+ * completely and in order
+ */
+TEST(Checkpoint, SeveralChunks) {
+  // 64 KiB hold 512 particle records and 8192 cell records
+  const size_t n = 10000;
+  std::vector<Particle> particles;
+  std::vector<std::pair<std::uint32_t, std::uint32_t>> cell_order;
+  for (size_t i = 0; i < n; i++) {
+    const auto x = static_cast<double>(i);
+    particles.emplace_back(Vector3{x, -x, 0.5 * x}, Vector3{0, 1, 2}, 1.0, static_cast<int>(i % 3));
+    cell_order.emplace_back(static_cast<std::uint32_t>(i / 4), static_cast<std::uint32_t>(i));
+  }
+  Settings settings(particles);
+
+  const auto filename = std::filesystem::temp_directory_path() / "molsim_test_checkpoint_chunks.bin";
+  ASSERT_TRUE(outputWriter::writeCheckpoint(particles, settings, filename, 1, 0.1, 0.01, cell_order));
+
+  std::vector<Particle> restored;
+  Settings restored_settings(restored);
+  CheckpointReader::readFile(restored, filename, restored_settings);
+  std::filesystem::remove(filename);
+
+  ASSERT_EQ(restored.size(), n);
+  ASSERT_EQ(restored_settings.restart->cell_order.size(), n);
+  for (size_t i = 0; i < n; i++) {
+    EXPECT_EQ(restored[i].getX(), particles[i].getX());
+    EXPECT_EQ(restored[i].getType(), particles[i].getType());
+    EXPECT_EQ(restored_settings.restart->cell_order[i], cell_order[i]);
+  }
+}
+
+/**
+ * @test A cell order that does not describe the current particles and cells is rejected and the sorted order is kept
+ */
+TEST(Checkpoint, MismatchedCellOrderIsIgnored) {
+  const Vector3 domain = {4, 4, 4};
+  std::vector<Particle> particles;
+  particles.emplace_back(Vector3{0.5, 0.5, 0.5}, Vector3{0, 0, 0}, 1.0, 0);
+  particles.emplace_back(Vector3{2.5, 2.5, 2.5}, Vector3{0, 0, 0}, 1.0, 0);
+  std::vector<std::pair<std::uint32_t, std::uint32_t>> order;
+  {
+    LinkedCells cells(particles, domain, 1.0, false);
+    order = cells.getCellOrder();
+  }
+
+  // a particle added after the checkpoint, e.g. from another input file
+  particles.emplace_back(Vector3{3.5, 0.5, 0.5}, Vector3{0, 0, 0}, 1.0, 0);
+  LinkedCells added(particles, domain, 1.0, false);
+  EXPECT_FALSE(added.setCellOrder(order));
+  EXPECT_EQ(added.getCellOrder().size(), 3);
+
+  // a different cutoff changes the cells
+  particles.pop_back();
+  LinkedCells coarser(particles, domain, 2.0, false);
+  EXPECT_FALSE(coarser.setCellOrder(order));
+  EXPECT_EQ(coarser.getCellOrder().size(), 2);
+
+  LinkedCells same(particles, domain, 1.0, false);
+  EXPECT_TRUE(same.setCellOrder(order));
+}
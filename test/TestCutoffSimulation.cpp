@@ -177,3 +177,73 @@ TEST_F(TestCutoffSimulation, GravityEffectsParticles) {
   EXPECT_NEAR(f[0], 0.0, 1e-5);
   EXPECT_NEAR(f[2], 0.0, 1e-5);
 }
+
+/**
+ * A fast particle should shrink the timestep so that it does not travel further than max_displacement
+ */
+TEST_F(TestCutoffSimulation, AdaptiveTimestepLimitsDisplacement) {
+  particles.emplace_back(Vector3{5.0, 5.0, 5.0}, Vector3{100.0, 0.0, 0.0}, 1.0, 0);
+  initSimulation();
+  sim->setAdaptiveTimestep({1e-6, 0.01, 0.01});
+
+  sim->adaptTimestep();
+
+  EXPECT_NEAR(sim->getDeltaT(), 1e-4, 1e-12) << "A particle with |v| = 100 may only move 0.01 per step";
+}
+
+/**
+ * Without any motion the timestep should grow, but at most by a factor of two per iteration and never beyond the bound
+ */
+TEST_F(TestCutoffSimulation, AdaptiveTimestepGrowsWithinBounds) {
+  particles.emplace_back(Vector3{5.0, 5.0, 5.0}, Vector3{0.0, 0.0, 0.0}, 1.0, 0);
+  initSimulation();
+  sim->setAdaptiveTimestep({1e-6, 0.005, 0.01});
+
+  sim->adaptTimestep();
+  EXPECT_DOUBLE_EQ(sim->getDeltaT(), 2 * delta_t);
+
+  for (int i = 0; i < 10; i++) sim->adaptTimestep();
+  EXPECT_DOUBLE_EQ(sim->getDeltaT(), 0.005);
+}
+
+/**
+ * The taskloop traversal of LinkedCellsV2 (useAlternateParallelisation) has to compute the same forces as the default
+ * traversal, including the pairs across periodic borders and the repulsion of reflective borders
+ */
+TEST_F(TestCutoffSimulation, TaskloopTraversalMatchesDefault) {
+  // periodic in x, reflective in y and z
+  borders = {BorderType::PERIODIC, BorderType::REFLECTION, BorderType::REFLECTION,
+             BorderType::PERIODIC, BorderType::REFLECTION, BorderType::REFLECTION};
+  end_time = 0.05;
+
+  // the outermost particles interact across the periodic border and with the ghosts of the reflective borders
+  for (int i = 0; i < 216; i++) {
+    const double offset = 0.05 * (i * 7 % 5 - 2);
+    const Vector3 x = {0.5 + 1.6 * (i % 6) + offset, 0.5 + 1.6 * (i / 6 % 6), 0.5 + 1.6 * (i / 36) - offset};
+    particles.emplace_back(x, Vector3{0.2 * (i * 3 % 4 - 1.5), 0, 0}, 1.0, 0);
+  }
+  const std::vector<Particle> initial = particles;
+
+  std::vector<Particle> results[2];
+  std::vector<Vector3> forces[2];
+  for (const bool taskloops : {false, true}) {
+    particles = initial;
+    initSimulation(taskloops);
+    callUpdateGhost();
+    sim->updateF();
+    for (const auto &p : particles) forces[taskloops].push_back(p.getF());
+
+    sim->run([](unsigned int) {});
+    results[taskloops] = particles;
+  }
+
+  for (size_t i = 0; i < initial.size(); i++) {
+    for (int d = 0; d < 3; d++) {
+      EXPECT_NEAR(forces[1][i][d], forces[0][i][d], 1e-9) << "Force of particle " << i;
+      EXPECT_NEAR(results[1][i].getX()[d], results[0][i].getX()[d], 1e-9) << "Position of particle " << i;
+    }
+  }
+  // make sure both kinds of borders took part
+  EXPECT_GT(std::abs(forces[0][0][0]), 0);
+  EXPECT_GT(std::abs(forces[0][0][1]), 0);
+}
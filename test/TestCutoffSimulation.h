@@ -6,6 +6,7 @@
 #include <vector>
 
 #include "Particle.h"
+#include "container/linkedCells/LinkedCellsV2.h"
 #include "simulations/CutoffSimulation.h"
 
 class TestCutoffSimulation : public ::testing::Test {
@@ -35,8 +36,12 @@ class TestCutoffSimulation : public ::testing::Test {
     particles.clear();
     particles.reserve(100);
   }
-  void initSimulation() {
-    linkedCells = std::make_unique<LinkedCells>(particles, domain, cutoff, is2D, borders);
+  void initSimulation(bool taskloops = false) {
+    if (taskloops) {
+      linkedCells = std::make_unique<LinkedCellsV2>(particles, domain, cutoff, is2D, borders);
+    } else {
+      linkedCells = std::make_unique<LinkedCells>(particles, domain, cutoff, is2D, borders);
+    }
     sim = std::make_unique<CutoffSimulation>(*linkedCells, start_time, end_time, delta_t, std::nullopt, domain, cutoff,
                                              borders, is2D, gravity);
   }
@@ -34,3 +34,51 @@ TEST(Reader, XYZ) {
 
   EXPECT_DOUBLE_EQ(mass, particles[0].getM());
 }
+
+/**
+ * @test Read many particles from file
+ *
+ * Large files are parsed in chunks, this checks that the chunks keep the order of the particles
+ */
+TEST(Reader, XYZLarge) {
+  std::vector<Particle> particles;
+
+  std::stringstream mockInput;
+  mockInput << "# comment\n\n10000\n";
+  for (int i = 0; i < 10000; i++) {
+    mockInput << i << " " << -0.5 * i << " +1e-3\t0 0 " << 2 * i << " 1.5\n";
+  }
+  // lines after the particles are ignored
+  mockInput << "unused";
+
+  XYZReader::parse(particles, mockInput);
+
+  ASSERT_EQ(particles.size(), 10000);
+  for (int i = 0; i < 10000; i++) {
+    EXPECT_EQ(particles[i].getX(), (Vector3{static_cast<double>(i), -0.5 * i, 1e-3}));
+    EXPECT_EQ(particles[i].getV(), (Vector3{0, 0, 2.0 * i}));
+    EXPECT_EQ(particles[i].getM(), 1.5);
+  }
+}
+
+/**
+ * @test Read cuboids from file, with and without epsilon and sigma
+ */
+TEST(Reader, Cuboid) {
+  std::vector<Particle> particles;
+
+  std::stringstream mockInput;
+  mockInput << "# xyz-coord     n.o.particles   distance    mass    velocity\n";
+  mockInput << "15.0 15.0 0.0   8 8 1           1.1225      1.0     0.0 -10.0 0.0\n";
+  mockInput << "0.0 0.0 0.0     4 2 1           1.1225      2.0     3.0 0.5     1.0 0.0 0.0\n";
+
+  CuboidReader::parse(particles, mockInput);
+
+  ASSERT_EQ(particles.size(), 72);
+  EXPECT_EQ(particles[0].getX(), (Vector3{15.0, 15.0, 0.0}));
+  EXPECT_EQ(particles[0].getV(), (Vector3{0.0, -10.0, 0.0}));
+  EXPECT_EQ(particles[64].getM(), 2.0);
+  EXPECT_EQ(particles[64].getEpsilon(), 3.0);
+  EXPECT_EQ(particles[64].getSigma(), 0.5);
+  EXPECT_EQ(particles[64].getV(), (Vector3{1.0, 0.0, 0.0}));
+}
@@ -4,10 +4,16 @@
 
 #include "TestLinkedCells.h"
 
+#include <omp.h>
+
 #include <algorithm>
+#include <filesystem>
+#include <fstream>
 #include <memory>
 #include <vector>
 
+#include "container/linkedCells/LinkedCellsV2.h"
+#include "outputWriter/CellCostWriter.h"
 #include "utils/ArrayUtils.h"
 
 /***
@@ -122,4 +128,174 @@ TEST_F(TestLinkedCells, ParticleBinning) {
   // Check Cell 2 (3,3,3)
   int cell2Index = callIndex3dToIndex1d(3, 3, 3);
   EXPECT_EQ(linked_cells->cells[cell2Index].particles.size(), 1);
-}
\ No newline at end of file
+}
+/**
+ * @brief Static particles are stored separately: pairs of two static particles are never visited, but static-mobile
+ * pairs are visited once, and applyToMobileParticles skips the static particles
+ */
+TEST_F(TestLinkedCells, StaticParticlesSkipStaticPairs) {
+  setUpCenterCluster();
+  particles[0].setState(1);
+  particles[1].setState(1);
+  linked_cells->sortParticlesIntoCells();
+
+  int pairs = 0;
+  int static_pairs = 0;
+  linked_cells->applyToPairs([&pairs, &static_pairs](Particle &p1, Particle &p2) {
+#pragma omp atomic
+    pairs++;
+    if (p1.isStatic() && p2.isStatic()) {
+#pragma omp atomic
+      static_pairs++;
+    }
+  });
+  EXPECT_EQ(static_pairs, 0);
+  EXPECT_EQ(pairs, 5);
+
+  int mobile = 0;
+  linked_cells->applyToMobileParticles([&mobile](Particle &p) {
+    EXPECT_FALSE(p.isStatic());
+#pragma omp atomic
+    mobile++;
+  });
+  EXPECT_EQ(mobile, 2);
+  EXPECT_EQ(linked_cells->alive_particles, 2);
+}
+
+/**
+ * @brief The cell costs count every distance test and interaction once, attributed to the traversed cell, and are
+ * written as a grid with one value per cell
+ */
+TEST_F(TestLinkedCells, CellCosts) {
+  setUpCenterCluster();
+  linked_cells->sortParticlesIntoCells();
+  linked_cells->measureCellCosts();
+
+  int pairs = 0;
+  linked_cells->applyToPairs([&pairs](Particle &, Particle &) {
+#pragma omp atomic
+    pairs++;
+  });
+
+  const auto &costs = linked_cells->cell_costs;
+  ASSERT_EQ(costs.size(), linked_cells->cells.size());
+  // three pairs inside the center cell, three pairs with the particle in the cell to the right
+  const int center = callIndex3dToIndex1d(2, 2, 2);
+  EXPECT_EQ(costs[center].pair_tests, 6);
+  std::uint64_t pair_tests = 0;
+  std::uint64_t interactions = 0;
+  for (const auto &cost : costs) {
+    pair_tests += cost.pair_tests;
+    interactions += cost.interactions;
+  }
+  EXPECT_EQ(pair_tests, 6);
+  EXPECT_EQ(interactions, pairs);
+  EXPECT_EQ(costs[center].interactions, pairs);
+  EXPECT_GT(costs[center].seconds, 0);
+
+  const auto filename = (std::filesystem::temp_directory_path() / "MolSimTestCosts").string();
+  ASSERT_TRUE(outputWriter::writeCellCosts(*linked_cells, filename, 7, 1, CellCostFormat::CSV));
+  std::ifstream csv(filename + "_cells_0007.csv");
+  std::string line;
+  size_t lines = 0;
+  while (std::getline(csv, line)) lines++;
+  // comment, header and one line per cell
+  EXPECT_EQ(lines, linked_cells->cells.size() + 2);
+
+  ASSERT_TRUE(outputWriter::writeCellCosts(*linked_cells, filename, 7, 1, CellCostFormat::VTI));
+  std::ifstream vti(filename + "_cells_0007.vti");
+  const std::string content((std::istreambuf_iterator<char>(vti)), std::istreambuf_iterator<char>());
+  EXPECT_NE(content.find(R"(WholeExtent="0 5 0 5 0 5")"), std::string::npos);
+  EXPECT_NE(content.find(R"(Name="pair_tests")"), std::string::npos);
+  std::filesystem::remove(filename + "_cells_0007.csv");
+  std::filesystem::remove(filename + "_cells_0007.vti");
+
+  linked_cells->resetCellCosts();
+  EXPECT_EQ(linked_cells->cell_costs[center].pair_tests, 0);
+  linked_cells->measureCellCosts(false);
+  EXPECT_TRUE(linked_cells->cell_costs.empty());
+}
+
+/**
+ * @brief Both traversals count the same distance tests, interactions and occupancy in the pair statistics
+ */
+TEST_F(TestLinkedCells, PairStatistics) {
+  setUpCenterCluster();
+  LinkedCellsV2 taskloops(particles, domain, cutoff, false, borders);
+
+  for (LinkedCells *container : std::vector<LinkedCells *>{linked_cells.get(), &taskloops}) {
+    container->sortParticlesIntoCells();
+    container->collectPairStatistics();
+    int pairs = 0;
+    for (int i = 0; i < 2; i++) {
+      container->applyToPairs([&pairs](Particle &, Particle &) {
+#pragma omp atomic
+        pairs++;
+      });
+    }
+
+    const PairStatistics statistics = container->pairStatistics();
+    EXPECT_EQ(statistics.traversals, 2);
+    EXPECT_EQ(statistics.pair_tests, 12);
+    EXPECT_EQ(statistics.interactions, pairs);
+    EXPECT_EQ(statistics.ghost_pair_tests, 0);
+    // 3 x 3 x 3 cells without the ghost layer, two of them are occupied
+    EXPECT_EQ(statistics.cells, 2 * 27);
+    EXPECT_EQ(statistics.empty_cells, 2 * 25);
+    EXPECT_EQ(statistics.particles, 2 * 4);
+    EXPECT_EQ(statistics.max_occupancy, 3);
+    EXPECT_NE(statistics.format().find("tests in cutoff"), std::string::npos);
+
+    container->collectPairStatistics(false);
+    EXPECT_TRUE(container->pair_statistics.empty());
+  }
+}
+
+/**
+ * @brief A particle next to a reflective border is tested against and interacts with its ghost, which is also counted
+ * in the ghost pair statistics
+ */
+TEST_F(TestLinkedCells, PairStatisticsCountGhosts) {
+  particles.clear();
+  // the ghost is mirrored to x = -0.3, closer than the repulsing distance
+  particles.emplace_back(std::array<double, 3>{0.3, 1.5, 1.5}, std::array<double, 3>{0, 0, 0}, 1.0, 0);
+  LinkedCellsV2 taskloops(particles, domain, cutoff, false, borders);
+
+  for (LinkedCells *container : std::vector<LinkedCells *>{linked_cells.get(), &taskloops}) {
+    container->sortParticlesIntoCells();
+    callUpdateGhost(*container);
+    container->collectPairStatistics();
+    int pairs = 0;
+    container->applyToPairs([&pairs](Particle &, Particle &) {
+#pragma omp atomic
+      pairs++;
+    });
+
+    const PairStatistics statistics = container->pairStatistics();
+    EXPECT_EQ(pairs, 1);
+    // the only pair is the one with the ghost
+    EXPECT_EQ(statistics.pair_tests, 1);
+    EXPECT_EQ(statistics.interactions, 1);
+    EXPECT_EQ(statistics.ghost_pair_tests, 1);
+    EXPECT_EQ(statistics.ghost_interactions, 1);
+    container->collectPairStatistics(false);
+  }
+}
+
+/**
+ * @brief Threads added after the pair statistics were enabled still count their pairs
+ */
+TEST_F(TestLinkedCells, PairStatisticsGrowWithThreads) {
+  const int threads = omp_get_max_threads();
+  setUpCenterCluster();
+  linked_cells->sortParticlesIntoCells();
+  omp_set_num_threads(1);
+  linked_cells->collectPairStatistics();
+  omp_set_num_threads(4);
+  linked_cells->applyToPairs([](Particle &, Particle &) {});
+  omp_set_num_threads(threads);
+
+  EXPECT_EQ(linked_cells->pair_statistics.size(), 4);
+  EXPECT_EQ(linked_cells->pairStatistics().pair_tests, 6);
+  EXPECT_EQ(linked_cells->pairStatistics().particles, 4);
+}
@@ -35,6 +35,18 @@ class TestLinkedCells : public ::testing::Test {
     linked_cells = std::make_unique<LinkedCells>(particles, domain, cutoff, false, borders);
   }
 
+  // Replaces the particles with three close particles in the center cell and one in the cell to its right
+  void setUpCenterCluster() {
+    particles.clear();
+    particles.emplace_back(std::array<double, 3>{1.4, 1.5, 1.5}, std::array<double, 3>{0, 0, 0}, 1.0, 0);
+    particles.emplace_back(std::array<double, 3>{1.6, 1.5, 1.5}, std::array<double, 3>{0, 0, 0}, 1.0, 0);
+    particles.emplace_back(std::array<double, 3>{1.5, 1.9, 1.5}, std::array<double, 3>{0, 0, 0}, 1.0, 0);
+    particles.emplace_back(std::array<double, 3>{2.5, 1.5, 1.5}, std::array<double, 3>{0, 0, 0}, 1.0, 0);
+  }
+
+  // Wrapper for updateGhost
+  void callUpdateGhost(LinkedCells &container) { container.updateGhost(); }
+
   // Wrapper for index3dToIndex1d
   int callIndex3dToIndex1d(int x, int y, int z) { return linked_cells->index3dToIndex1d(x, y, z); }
 
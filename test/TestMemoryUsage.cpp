@@ -0,0 +1,68 @@
+/**
+ * @file TestMemoryUsage.cpp
+ *
+ * Contains tests for the memory accounting
+ */
+
+#include <gtest/gtest.h>
+
+#include "container/linkedCells/LinkedCells.h"
+#include "utils/MemoryUsage.h"
+
+/**
+ * @test The high-water marks keep the largest value of every subsystem and of the total
+ */
+TEST(MemoryUsage, HighWaterMarks) {
+  Memory::reset();
+  Memory::Usage usage;
+  usage[Memory::PARTICLES] = 1000;
+  usage[Memory::GHOSTS] = 500;
+  Memory::record(usage);
+  usage[Memory::PARTICLES] = 2000;
+  usage[Memory::GHOSTS] = 100;
+  Memory::record(usage);
+  usage[Memory::PARTICLES] = 1500;
+  Memory::record(usage);
+
+  EXPECT_EQ(Memory::current()[Memory::PARTICLES], 1500);
+  EXPECT_EQ(Memory::peak()[Memory::PARTICLES], 2000);
+  EXPECT_EQ(Memory::peak()[Memory::GHOSTS], 500);
+  EXPECT_EQ(Memory::peakTotal(), 2100);
+
+  const std::string table = Memory::format();
+  EXPECT_NE(table.find("ghost particles"), std::string::npos);
+  EXPECT_EQ(table.find("output buffers"), std::string::npos);
+  Memory::reset();
+  EXPECT_EQ(Memory::peakTotal(), 0);
+}
+
+/**
+ * @test Sizes are shown with binary units
+ */
+TEST(MemoryUsage, FormatBytes) {
+  EXPECT_EQ(Memory::formatBytes(512), "512 B");
+  EXPECT_EQ(Memory::formatBytes(1536), "1.50 KiB");
+  EXPECT_EQ(Memory::formatBytes(3ull << 30), "3.00 GiB");
+}
+
+/**
+ * @test The linked cells account for every cell, its neighbour indices and the preallocated ghost particles
+ */
+TEST(MemoryUsage, LinkedCells) {
+  std::vector<Particle> particles;
+  particles.emplace_back(Vector3{0.5, 0.5, 0.5}, Vector3{0, 0, 0}, 1.0, 0);
+  LinkedCells cells(particles, {3, 3, 3}, 1.0, false);
+
+  Memory::Usage usage;
+  cells.addMemoryUsage(usage);
+  EXPECT_EQ(usage[Memory::NEIGHBOURS], cells.cells.capacity() * sizeof(NeighBourIndices));
+  EXPECT_GE(usage[Memory::GHOSTS], cells.ghostCells.size() * 32 * sizeof(Particle));
+  EXPECT_GE(usage[Memory::CELLS], cells.cells.size() * (sizeof(Cell) - sizeof(NeighBourIndices)));
+  EXPECT_EQ(usage[Memory::PARTICLES], 0);
+  EXPECT_EQ(usage[Memory::DIAGNOSTICS], 0);
+
+  cells.measureCellCosts();
+  Memory::Usage with_costs;
+  cells.addMemoryUsage(with_costs);
+  EXPECT_EQ(with_costs[Memory::DIAGNOSTICS], cells.cells.size() * sizeof(CellCost));
+}
@@ -1,6 +1,9 @@
 
 #include <gtest/gtest.h>
 
+#include <set>
+
+#include "utils/ArrayUtils.h"
 #include "utils/ParticleGenerator.h"
 
 /**
@@ -65,3 +68,91 @@ TEST(GenerateCuboid, Velocity) {
     EXPECT_EQ(velocity, p.getV());
   }
 }
+
+/**
+ * @test Membrane bond topology
+ *
+ * Tests if every pair of (diagonal) neighbours in a 3x3 membrane is bonded exactly once with the correct rest length.
+ * Particles generated before the membrane must not be referenced by any bond.
+ */
+TEST(GenerateMembrane, Bonds) {
+  std::vector<Particle> particles;
+  particles.emplace_back(Vector3{-5, -5, 0}, Vector3{0, 0, 0}, 1.0, 0);
+  BondList bonds;
+  const double r0 = 2.2;
+  ParticleGenerator::membrane(particles, {0, 0, 0}, {3, 3, 1}, 2.2, 1, std::nullopt, std::nullopt, {0, 0, 0}, r0,
+                              bonds);
+
+  EXPECT_EQ(particles.size(), 10);
+  // 6 horizontal + 6 vertical + 8 diagonal
+  EXPECT_EQ(bonds.size(), 20);
+
+  std::set<std::pair<size_t, size_t>> unique;
+  std::vector<int> degree(particles.size(), 0);
+  for (const Bond &bond : bonds.bonds) {
+    EXPECT_GT(bond.i, 0);
+    EXPECT_GT(bond.j, 0);
+    unique.insert({std::min(bond.i, bond.j), std::max(bond.i, bond.j)});
+    degree[bond.i]++;
+    degree[bond.j]++;
+
+    const double distance = ArrayUtils::L2Norm(particles[bond.i].getX() - particles[bond.j].getX());
+    EXPECT_DOUBLE_EQ(bond.rest_length, distance);
+    EXPECT_EQ(bond.type, bond.rest_length > r0 ? BondType::DIAGONAL : BondType::STRAIGHT);
+  }
+  EXPECT_EQ(unique.size(), bonds.size());
+  // center particle (1, 1) is bonded to all 8 neighbours, corners to 3
+  EXPECT_EQ(degree[1 + 1 * 3 + 1], 8);
+  EXPECT_EQ(degree[1], 3);
+}
+
+/**
+ * @test Membrane bond order
+ *
+ * The bonds are written in parallel to precomputed positions, this checks that every particle stores its right, upper
+ * and diagonal bonds in this order, row by row
+ */
+TEST(GenerateMembrane, BondOrder) {
+  for (const auto [nx, ny] : {std::array<unsigned int, 2>{7, 5}, {1, 4}, {6, 1}, {1, 1}}) {
+    std::vector<Particle> particles(3);
+    BondList bonds;
+    ParticleGenerator::membrane(particles, {0, 0, 0}, {nx, ny, 1}, 1, 1, std::nullopt, std::nullopt, {0, 0, 0}, 1,
+                                bonds);
+    ASSERT_EQ(particles.size(), 3 + nx * ny);
+
+    std::vector<std::pair<size_t, size_t>> expected;
+    for (size_t y = 0; y < ny; y++) {
+      for (size_t x = 0; x < nx; x++) {
+        const size_t own = 3 + y * nx + x;
+        if (x + 1 < nx) expected.emplace_back(own, own + 1);
+        if (y + 1 < ny) expected.emplace_back(own, own + nx);
+        if (x + 1 < nx && y + 1 < ny) expected.emplace_back(own, own + nx + 1);
+        if (x > 0 && y + 1 < ny) expected.emplace_back(own, own + nx - 1);
+      }
+    }
+    ASSERT_EQ(bonds.size(), expected.size());
+    for (size_t b = 0; b < expected.size(); b++) {
+      EXPECT_EQ(bonds.bonds[b].i, expected[b].first);
+      EXPECT_EQ(bonds.bonds[b].j, expected[b].second);
+    }
+  }
+}
+
+/**
+ * @test Disc size
+ *
+ * Checks that every generated particle of a disc lies within the radius and that no particle is missing
+ */
+TEST(GenerateDisc, Size) {
+  std::vector<Particle> particles(1);
+  ParticleGenerator::disc(particles, {10, 10, 0}, 15, 1.1225, 1, std::nullopt, std::nullopt, {0, 0, 0});
+
+  // the lattice points within the radius, counted serially
+  size_t expected = 0;
+  for (int x = -14; x < 15; x++)
+    for (int y = -14; y < 15; y++) expected += x * x + y * y <= 14 * 14;
+  ASSERT_EQ(particles.size(), 1 + expected);
+  for (size_t i = 1; i < particles.size(); i++) {
+    EXPECT_LE(ArrayUtils::L2Norm(particles[i].getX() - Vector3{10, 10, 0}), 14 * 1.1225 + 1e-9);
+  }
+}
@@ -0,0 +1,161 @@
+/**
+ * @file TestPhaseTimers.cpp
+ *
+ * Contains tests for the per phase timers
+ */
+
+#include <gtest/gtest.h>
+#include <omp.h>
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+#include "container/linkedCells/LinkedCellsV2.h"
+#include "simulations/CutoffSimulation.h"
+#include "utils/PhaseTimers.h"
+#include "utils/Tracing.h"
+
+/**
+ * @brief Runs a small linked cells simulation with 20 iterations
+ * @param taskloops If the LinkedCellsV2 container is used
+ */
+static void runSimulation(const bool taskloops = false) {
+  const Vector3 domain = {10, 10, 1};
+  const std::array<BorderType, 6> borders = {BorderType::REFLECTION, BorderType::PERIODIC, BorderType::OUTFLOW,
+                                             BorderType::REFLECTION, BorderType::PERIODIC, BorderType::OUTFLOW};
+  std::vector<Particle> particles;
+  for (int i = 0; i < 36; i++) {
+    particles.emplace_back(Vector3{1.0 + 1.4 * (i % 6), 1.0 + 1.4 * (i / 6), 0.5}, Vector3{0.1, 0.2, 0}, 1.0, 0);
+  }
+  std::unique_ptr<LinkedCells> cells;
+  if (taskloops) {
+    cells = std::make_unique<LinkedCellsV2>(particles, domain, 2.5, true, borders);
+  } else {
+    cells = std::make_unique<LinkedCells>(particles, domain, 2.5, true, borders);
+  }
+  // exactly representable, so the simulation has exactly 20 iterations
+  CutoffSimulation(*cells, 0, 20.0 / 256, 1.0 / 256, std::nullopt, domain, 2.5, borders, true, 0).run([](unsigned) {});
+}
+
+/**
+ * @test Every phase of a linked cells iteration is measured once per iteration and nothing while disabled
+ */
+TEST(PhaseTimers, CountsPhases) {
+  PhaseTimers::enable();
+  PhaseTimers::disable();
+  runSimulation();
+  EXPECT_EQ(PhaseTimers::snapshot().calls[PhaseTimers::STEP], 0);
+
+  PhaseTimers::enable();
+  runSimulation();
+  const auto first = PhaseTimers::snapshot();
+  runSimulation();
+  const auto totals = PhaseTimers::snapshot() - first;
+  PhaseTimers::disable();
+
+  for (const auto phase : {PhaseTimers::STEP, PhaseTimers::UPDATE_X, PhaseTimers::MOVE_PARTICLES,
+                           PhaseTimers::RESET_F, PhaseTimers::PAIRS_CELL, PhaseTimers::PAIRS_INNER,
+                           PhaseTimers::PAIRS_BORDER, PhaseTimers::UPDATE_V}) {
+    EXPECT_EQ(totals.calls[phase], 20) << PhaseTimers::name(phase);
+  }
+  EXPECT_EQ(totals.calls[PhaseTimers::THERMOSTAT], 0);
+  EXPECT_GT(totals.wall[PhaseTimers::STEP], totals.wall[PhaseTimers::UPDATE_X]);
+
+  ASSERT_EQ(totals.busy.size(), omp_get_max_threads());
+  EXPECT_GT(totals.busy[0][PhaseTimers::PAIRS_INNER], 0);
+
+  const std::string table = PhaseTimers::format(totals);
+  EXPECT_NE(table.find("pairs (inner)"), std::string::npos);
+  EXPECT_NE(table.find("other"), std::string::npos);
+  EXPECT_EQ(table.find("thermostat"), std::string::npos);
+}
+
+/**
+ * @test Threads added after the timers and the trace were enabled are measured and traced as well
+ */
+TEST(PhaseTimers, GrowWithThreads) {
+  const int threads = omp_get_max_threads();
+  const auto filename = std::filesystem::temp_directory_path() / "molsim_test_grow_trace.json";
+  omp_set_num_threads(1);
+  PhaseTimers::enable();
+  Tracing::enable(filename, 0, 1);
+  omp_set_num_threads(3);
+  runSimulation();
+  omp_set_num_threads(threads);
+  const auto totals = PhaseTimers::snapshot();
+  PhaseTimers::disable();
+
+  ASSERT_EQ(totals.busy.size(), 3);
+  for (size_t thread = 0; thread < 3; thread++) EXPECT_GT(totals.busy[thread][PhaseTimers::PAIRS_CELL], 0);
+
+  std::ifstream file(filename);
+  const std::string trace((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+  std::filesystem::remove(filename);
+  EXPECT_NE(trace.find(R"("args": {"name": "thread 2"})"), std::string::npos);
+}
+
+/**
+ * @test The performance counters of every thread are added to the phases. Skipped if the counters can't be opened
+ */
+TEST(PhaseTimers, PerfCounters) {
+  if (!PerfCounters::enable()) GTEST_SKIP() << "perf_event_open is not available";
+  PhaseTimers::enable();
+  runSimulation();
+  const auto totals = PhaseTimers::snapshot();
+  PhaseTimers::disable();
+  PerfCounters::disable();
+
+  ASSERT_EQ(totals.counters.size(), omp_get_max_threads());
+  EXPECT_GT(totals.counters[0][PhaseTimers::STEP][PerfCounters::TASK_CLOCK], 0);
+  EXPECT_GT(totals.counters[0][PhaseTimers::PAIRS_INNER][PerfCounters::TASK_CLOCK], 0);
+  // the step contains the phases
+  EXPECT_GE(totals.counters[0][PhaseTimers::STEP][PerfCounters::TASK_CLOCK],
+            totals.counters[0][PhaseTimers::PAIRS_INNER][PerfCounters::TASK_CLOCK]);
+  if (PerfCounters::available(PerfCounters::INSTRUCTIONS)) {
+    EXPECT_GT(totals.counters[0][PhaseTimers::PAIRS_INNER][PerfCounters::INSTRUCTIONS], 0);
+  }
+
+  const std::string table = PhaseTimers::formatCounters(totals);
+  EXPECT_NE(table.find("pairs (inner)"), std::string::npos);
+  EXPECT_EQ(PhaseTimers::formatCounters(PhaseTimers::Totals{}), "");
+}
+
+/**
+ * @brief Counts the occurrences of a string
+ */
+static size_t count(const std::string &text, const std::string &pattern) {
+  size_t result = 0;
+  for (auto pos = text.find(pattern); pos != std::string::npos; pos = text.find(pattern, pos + 1)) result++;
+  return result;
+}
+
+/**
+ * @test The trace contains the phases and the loop chunks of the step window, for both containers
+ */
+TEST(PhaseTimers, Trace) {
+  const auto file = std::filesystem::temp_directory_path() / "MolSimTestTrace.json";
+  for (const bool taskloops : {false, true}) {
+    std::filesystem::remove(file);
+    PhaseTimers::enable();
+    Tracing::enable(file, 2, 4);
+    runSimulation(taskloops);
+    // the trace was already written at the end of the window
+    EXPECT_FALSE(Tracing::active);
+    ASSERT_TRUE(std::filesystem::exists(file));
+    Tracing::finish();
+    PhaseTimers::disable();
+
+    std::ifstream in(file);
+    std::stringstream buffer;
+    buffer << in.rdbuf();
+    const std::string trace = buffer.str();
+    EXPECT_EQ(trace.rfind(R"({"displayTimeUnit": "ns", "traceEvents": [)", 0), 0);
+    EXPECT_EQ(count(trace, R"("name": "step", "cat": "phase")"), 3);
+    EXPECT_EQ(count(trace, R"json("name": "pairs (inner)", "cat": "phase")json"), 3);
+    EXPECT_GE(count(trace, R"json("name": "pairs (cell)", "cat": "chunk")json"), 3) << "taskloops " << taskloops;
+    EXPECT_NE(trace.find(R"("args": {"first": 0, )"), std::string::npos);
+    EXPECT_EQ(trace.substr(trace.size() - 3), "]}\n");
+  }
+  std::filesystem::remove(file);
+}
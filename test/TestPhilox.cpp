@@ -0,0 +1,65 @@
+/**
+ * @file TestPhilox.cpp
+ *
+ * Contains tests for the counter-based random number generator
+ */
+
+#include <gtest/gtest.h>
+
+#include "utils/MaxwellBoltzmannDistribution.h"
+#include "utils/Philox.h"
+
+/**
+ * @test Known answer tests from the Random123 reference implementation
+ */
+TEST(Philox, KnownAnswer) {
+  EXPECT_EQ(Philox::philox4x32({0, 0, 0, 0}, {0, 0}),
+            (Philox::Counter{0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8}));
+  EXPECT_EQ(Philox::philox4x32({0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff}, {0xffffffff, 0xffffffff}),
+            (Philox::Counter{0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd}));
+  EXPECT_EQ(Philox::philox4x32({0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344}, {0xa4093822, 0x299f31d0}),
+            (Philox::Counter{0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}));
+}
+
+/**
+ * @test The uniform conversion never returns the bounds, so the logarithm in the Box-Muller transform is finite
+ */
+TEST(Philox, UniformOpenInterval) {
+  EXPECT_GT(Philox::toUniform(0), 0.0);
+  EXPECT_LT(Philox::toUniform(0xffffffff), 1.0);
+}
+
+/**
+ * @test The normal distributed numbers have mean 0 and variance 1
+ */
+TEST(Philox, NormalMoments) {
+  const int draws = 100000;
+  double sum = 0;
+  double sum2 = 0;
+  for (std::uint32_t i = 0; i < draws; i++) {
+    for (const double z : Philox::normal({i, 0, 0, 0}, {42, 0})) {
+      sum += z;
+      sum2 += z * z;
+    }
+  }
+  const double mean = sum / (4 * draws);
+  const double variance = sum2 / (4 * draws) - mean * mean;
+  EXPECT_NEAR(mean, 0.0, 0.01);
+  EXPECT_NEAR(variance, 1.0, 0.01);
+}
+
+/**
+ * @test Velocities only depend on particle id, stream and seed, so they are reproducible in any order
+ */
+TEST(Philox, VelocityReproducible) {
+  const auto v = maxwellBoltzmannDistributedVelocity(1.0, 3, 7);
+  EXPECT_EQ(v, maxwellBoltzmannDistributedVelocity(1.0, 3, 7));
+  EXPECT_NE(v, maxwellBoltzmannDistributedVelocity(1.0, 3, 8));
+  EXPECT_NE(v, maxwellBoltzmannDistributedVelocity(1.0, 3, 7, 1));
+  EXPECT_NE(v, maxwellBoltzmannDistributedVelocity(1.0, 3, 7, 0, 43));
+
+  const auto v2D = maxwellBoltzmannDistributedVelocity(1.0, 2, 7);
+  EXPECT_EQ(v2D[0], v[0]);
+  EXPECT_EQ(v2D[1], v[1]);
+  EXPECT_EQ(v2D[2], 0.0);
+}
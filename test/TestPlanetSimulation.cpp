@@ -0,0 +1,119 @@
+/**
+ * @file TestPlanetSimulation.cpp
+ *
+ * Contains tests for the integrators of the direct sum simulations
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+#include "Particle.h"
+#include "simulations/PlanetSimulation.h"
+#include "utils/ArrayUtils.h"
+
+/**
+ * @brief Total energy of a gravitational system
+ * @param particles
+ * @return kinetic + potential energy
+ */
+static double totalEnergy(const std::vector<Particle> &particles) {
+  double energy = 0;
+  for (size_t i = 0; i < particles.size(); i++) {
+    const Vector3 &v = particles[i].getV();
+    energy += 0.5 * particles[i].getM() * (v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+    for (size_t j = i + 1; j < particles.size(); j++) {
+      energy -= particles[i].getM() * particles[j].getM() /
+                ArrayUtils::L2Norm(particles[i].getX() - particles[j].getX());
+    }
+  }
+  return energy;
+}
+
+/**
+ * @brief Integrates one period of an eccentric Kepler orbit
+ *
+ * @param integrator
+ * @param steps number of timesteps per orbit
+ * @return maximum relative energy error during the orbit
+ */
+static double keplerEnergyError(const Integrator integrator, const int steps) {
+  // semi-major axis 1/(2 - 0.25) for a planet starting at distance 1 with speed 0.5
+  const double period = 2 * M_PI * std::pow(1 / 1.75, 1.5);
+  std::vector<Particle> particles;
+  particles.emplace_back(Vector3{0, 0, 0}, Vector3{0, 0, 0}, 1.0, 0);
+  particles.emplace_back(Vector3{1, 0, 0}, Vector3{0, 0.5, 0}, 1e-6, 0);
+
+  PlanetSimulation simulation(particles, 0, period, period / steps);
+  simulation.setIntegrator(integrator, 6, 1e-4);
+  simulation.updateF();
+
+  const double e0 = totalEnergy(particles);
+  double max_error = 0;
+  for (int i = 0; i < steps; i++) {
+    simulation.iteration();
+    max_error = std::max(max_error, std::abs((totalEnergy(particles) - e0) / e0));
+  }
+  return max_error;
+}
+
+/**
+ * @test The 4th order integrators conserve the energy of an eccentric orbit much better than Stoermer-Verlet
+ */
+TEST(PlanetSimulation, HigherOrderIntegratorsConserveEnergy) {
+  const double verlet = keplerEnergyError(Integrator::STOERMER_VERLET, 200);
+  const double yoshida = keplerEnergyError(Integrator::YOSHIDA4, 200);
+  const double pefrl = keplerEnergyError(Integrator::PEFRL, 200);
+
+  EXPECT_LT(yoshida, verlet / 10);
+  EXPECT_LT(pefrl, yoshida);
+}
+
+/**
+ * @test Halving the timestep reduces the energy error of the triple jump by about 2^4
+ */
+TEST(PlanetSimulation, Yoshida4IsFourthOrder) {
+  const double coarse = keplerEnergyError(Integrator::YOSHIDA4, 400);
+  const double fine = keplerEnergyError(Integrator::YOSHIDA4, 800);
+
+  EXPECT_NEAR(coarse / fine, 16, 4);
+}
+
+/**
+ * @test Block timesteps resolve the pericenter passage with substeps where a single Stoermer-Verlet step is too coarse
+ */
+TEST(PlanetSimulation, BlockTimestepsResolvePericenter) {
+  const double verlet = keplerEnergyError(Integrator::STOERMER_VERLET, 50);
+  const double block = keplerEnergyError(Integrator::BLOCK, 50);
+
+  EXPECT_LT(block, verlet / 10);
+}
+
+/**
+ * @test Particles with weak forces stay on the coarsest level, so their trajectory is unchanged by the block scheme
+ */
+TEST(PlanetSimulation, BlockTimestepsMatchVerletOnCoarsestLevel) {
+  std::vector<Particle> block_particles;
+  block_particles.emplace_back(Vector3{0, 0, 0}, Vector3{0, 0, 0}, 1.0, 0);
+  block_particles.emplace_back(Vector3{100, 0, 0}, Vector3{0, 0.1, 0}, 1.0, 0);
+  std::vector<Particle> verlet_particles = block_particles;
+
+  PlanetSimulation block(block_particles, 0, 10, 0.1);
+  block.setIntegrator(Integrator::BLOCK, 4, 1.0);
+  PlanetSimulation verlet(verlet_particles, 0, 10, 0.1);
+  block.updateF();
+  verlet.updateF();
+
+  for (int i = 0; i < 100; i++) {
+    block.iteration();
+    verlet.iteration();
+  }
+
+  for (size_t i = 0; i < block_particles.size(); i++) {
+    for (int d = 0; d < 3; d++) {
+      EXPECT_NEAR(block_particles[i].getX()[d], verlet_particles[i].getX()[d], 1e-12);
+      EXPECT_NEAR(block_particles[i].getV()[d], verlet_particles[i].getV()[d], 1e-12);
+    }
+  }
+}
@@ -0,0 +1,69 @@
+/**
+ * @file TestScaling.cpp
+ *
+ * Contains tests for the scaling study
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "benchmark/Scaling.h"
+
+/**
+ * @test The generated cuboid has at least the requested particles and fills its domain with the requested density
+ */
+TEST(Scaling, Scenario) {
+  std::vector<Particle> input;
+  Settings settings(input);
+  settings.simulation.cutoff_radius = 2.5;
+  settings.scaling.emplace();
+  settings.scaling->density = 0.8;
+
+  std::vector<Particle> particles;
+  Scaling::generateScenario(particles, settings, 1000, {});
+  EXPECT_EQ(particles.size(), 1000);
+  const Vector3 domain = settings.simulation.domain.value();
+  EXPECT_NEAR(particles.size() / (domain[0] * domain[1] * domain[2]), 0.8, 1e-9);
+  for (const auto &p : particles) {
+    for (int axis = 0; axis < 3; axis++) {
+      EXPECT_GT(p.getX()[axis], 0);
+      EXPECT_LT(p.getX()[axis], domain[axis]);
+    }
+  }
+
+  // 2D scenarios keep the depth of the input domain
+  settings.simulation.is2D = true;
+  settings.simulation.domain = Vector3{10, 10, 1};
+  settings.scaling->shape = Settings::Scaling::Shape::DISC;
+  particles.clear();
+  Scaling::generateScenario(particles, settings, 500, {});
+  EXPECT_GE(particles.size(), 500);
+  EXPECT_LT(particles.size(), 600);
+  EXPECT_DOUBLE_EQ(settings.simulation.domain.value()[2], 1);
+}
+
+/**
+ * @test Efficiency of strong and weak scaling compared to the first run
+ */
+TEST(Scaling, Efficiency) {
+  std::vector<ScalingRun> runs(3);
+  runs[0].threads = 1;
+  runs[0].particles = 1000;
+  runs[0].seconds_per_step[PhaseTimers::STEP] = 1.0;
+  // strong scaling: half the time with twice the threads is ideal
+  runs[1].threads = 2;
+  runs[1].particles = 1000;
+  runs[1].seconds_per_step[PhaseTimers::STEP] = 0.5;
+  // weak scaling: four times the particles on four threads in 1.25 times the time
+  runs[2].threads = 4;
+  runs[2].particles = 4000;
+  runs[2].seconds_per_step[PhaseTimers::STEP] = 1.25;
+
+  Scaling::calculateEfficiency(runs);
+  EXPECT_DOUBLE_EQ(runs[0].efficiency[PhaseTimers::STEP], 1.0);
+  EXPECT_DOUBLE_EQ(runs[1].efficiency[PhaseTimers::STEP], 1.0);
+  EXPECT_DOUBLE_EQ(runs[2].efficiency[PhaseTimers::STEP], 0.8);
+  // phases that were not measured have no efficiency
+  EXPECT_DOUBLE_EQ(runs[1].efficiency[PhaseTimers::BONDS], 0);
+}
@@ -0,0 +1,106 @@
+/**
+ * @file TestTrajectory.cpp
+ *
+ * Contains tests for writing and reading binary trajectories
+ */
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+
+#include "inputReader/TrajectoryReader.h"
+#include "outputWriter/TrajectoryWriter.h"
+#include "utils/ArrayUtils.h"
+
+/**
+ * @brief Writes frames of particles moving with constant velocity to a trajectory
+ */
+static std::vector<std::vector<Particle>> writeTrajectory(const std::filesystem::path &filename,
+                                                          const TrajectoryOptions &options, int frames) {
+  std::vector<Particle> particles;
+  for (int i = 0; i < 5; i++) {
+    particles.emplace_back(Vector3{0.1 * i, 1.0 / 3.0, -2.0 * i}, Vector3{0.01, -0.3 * i, 1.0 / 7.0}, 1.0, i % 2);
+  }
+
+  std::vector<std::vector<Particle>> written;
+  outputWriter::TrajectoryWriter writer(filename, options);
+  for (int frame = 0; frame < frames; frame++) {
+    for (auto &p : particles) p.setX(p.getX() + 0.37 * p.getV());
+    writer.writeFrame(outputWriter::ParticleSnapshot(particles), 10 * frame, 0.5 * frame);
+    written.push_back(particles);
+  }
+  return written;
+}
+
+/**
+ * @brief Checks that the decoded frames match the written particles up to the given tolerance
+ */
+static void expectFrames(const TrajectoryReader &reader, const std::vector<std::vector<Particle>> &written,
+                         double tolerance) {
+  ASSERT_EQ(reader.frameCount(), written.size());
+  // read backwards to check random access
+  for (size_t frame = written.size(); frame-- > 0;) {
+    const TrajectoryFrame decoded = reader.readFrame(frame);
+    EXPECT_EQ(decoded.iteration, 10 * frame);
+    EXPECT_DOUBLE_EQ(decoded.time, 0.5 * frame);
+    ASSERT_EQ(decoded.positions.size(), written[frame].size());
+    for (size_t i = 0; i < decoded.positions.size(); i++) {
+      for (int d = 0; d < 3; d++) {
+        EXPECT_NEAR(decoded.positions[i][d], written[frame][i].getX()[d], tolerance);
+        EXPECT_NEAR(decoded.velocities[i][d], written[frame][i].getV()[d], tolerance);
+      }
+      EXPECT_EQ(decoded.types[i], written[frame][i].getType());
+    }
+  }
+}
+
+/**
+ * @test Double precision frames are stored exactly
+ */
+TEST(Trajectory, DoublePrecision) {
+  const auto filename = std::filesystem::temp_directory_path() / "molsim_test_double.trj";
+  const auto written = writeTrajectory(filename, {false, false, 16}, 5);
+
+  TrajectoryReader reader(filename);
+  EXPECT_FALSE(reader.getHeader().flags & trajectory::SINGLE_PRECISION);
+  expectFrames(reader, written, 0);
+  std::filesystem::remove(filename);
+}
+
+/**
+ * @test Single precision frames with delta encoding do not accumulate rounding errors
+ */
+TEST(Trajectory, DeltaEncoding) {
+  const auto filename = std::filesystem::temp_directory_path() / "molsim_test_delta.trj";
+  const auto written = writeTrajectory(filename, {true, true, 4}, 50);
+
+  TrajectoryReader reader(filename);
+  expectFrames(reader, written, 1e-5);
+  std::filesystem::remove(filename);
+}
+
+/**
+ * @test Frames of a trajectory that was not closed can still be read
+ */
+TEST(Trajectory, MissingIndex) {
+  const auto filename = std::filesystem::temp_directory_path() / "molsim_test_recover.trj";
+  const auto written = writeTrajectory(filename, {true, true, 4}, 10);
+
+  // remove the index and reset its offset, like a simulation that crashed before closing the trajectory
+  trajectory::FileHeader header{};
+  {
+    std::ifstream file(filename, std::ios::binary);
+    file.read(reinterpret_cast<char *>(&header), sizeof(header));
+  }
+  std::filesystem::resize_file(filename, header.index_offset);
+  header.index_offset = 0;
+  {
+    std::fstream file(filename, std::ios::binary | std::ios::in | std::ios::out);
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  }
+
+  TrajectoryReader reader(filename);
+  expectFrames(reader, written, 1e-5);
+  std::filesystem::remove(filename);
+}
@@ -0,0 +1,48 @@
+/**
+ * @file TestXYZWriter.cpp
+ *
+ * Contains tests for the xyz output
+ */
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+
+#include "outputWriter/XYZWriter.h"
+
+/**
+ * @test The written file contains the particle count, a comment and one line per particle in order
+ */
+TEST(XYZWriter, WritesAllParticles) {
+  std::vector<Particle> particles;
+  for (int i = 0; i < 1000; i++) {
+    particles.emplace_back(Vector3{0.5 * i, -1.0 / 3.0, 1e-7 * i}, Vector3{0, 0, 0}, 1.0, 0);
+  }
+
+  const auto prefix = std::filesystem::temp_directory_path() / "molsim_test";
+  outputWriter::XYZWriter writer;
+  writer.plotParticles(outputWriter::ParticleSnapshot(particles), prefix.string(), 7);
+
+  const auto filename = std::filesystem::temp_directory_path() / "molsim_test_0007.xyz";
+  std::ifstream file(filename);
+  size_t count = 0;
+  file >> count;
+  EXPECT_EQ(count, particles.size());
+  std::string comment;
+  std::getline(file, comment);
+  std::getline(file, comment);
+  EXPECT_EQ(comment.rfind("Generated by MolSim", 0), 0);
+
+  for (const auto &p : particles) {
+    std::string name;
+    Vector3 x;
+    file >> name >> x[0] >> x[1] >> x[2];
+    EXPECT_EQ(name, "Ar");
+    for (int d = 0; d < 3; d++) EXPECT_NEAR(x[d], p.getX()[d], 1e-5 * std::abs(p.getX()[d]));
+  }
+  std::string rest;
+  file >> rest;
+  EXPECT_TRUE(file.eof());
+  std::filesystem::remove(filename);
+}
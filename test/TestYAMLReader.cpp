@@ -176,3 +176,99 @@ TEST_F(TestYAMLReader, SimulationDomain) {
   EXPECT_DOUBLE_EQ(settings.simulation.domain.value()[1], domain[1]);
   EXPECT_DOUBLE_EQ(settings.simulation.domain.value()[2], domain[2]);
 }
+
+/**
+ * @test force groups
+ *
+ * Tests if force groups select the particles of tagged entries inside a region, and if the membrane upwards force is
+ * converted into a force group with the absolute particle indices
+ */
+TEST_F(TestYAMLReader, ForceGroups) {
+  std::stringstream input;
+  input << "particles:\n"
+           "  - cuboid:\n"
+           "      position: [0, 0, 0]\n"
+           "      size: [4, 1, 1]\n"
+           "      distance: 1.0\n"
+           "      mass: 1.0\n"
+           "      velocity: [0, 0, 0]\n"
+           "      tag: left\n"
+           "  - membrane:\n"
+           "      position: [10, 0, 0]\n"
+           "      size: [3, 3, 1]\n"
+           "      distance: 1.0\n"
+           "      mass: 1.0\n"
+           "      velocity: [0, 0, 0]\n"
+           "      k: 300\n"
+           "      r0: 1.0\n"
+           "      f_zUp: 0.8\n"
+           "      upwards_particles_indexes: [[1, 2], [0, 0]]\n"
+           "force_groups:\n"
+           "  - select:\n"
+           "      tag: left\n"
+           "      region: {min: [1.5, -1, -1], max: [10, 1, 1]}\n"
+           "    force: [1, 0, 0]\n"
+           "    force_end: [0, 0, 0]\n"
+           "    end_time: 10\n";
+
+  YAMLReader::parse(particles, input, settings);
+
+  ASSERT_EQ(particles.size(), 13);
+  ASSERT_EQ(settings.force_groups.size(), 2);
+
+  const ForceGroup &upwards = settings.force_groups[0];
+  EXPECT_EQ(upwards.indices, (std::vector<size_t>{4, 4 + 2 * 3 + 1}));
+  EXPECT_TRUE(upwards.isActive(149));
+  EXPECT_FALSE(upwards.isActive(150));
+
+  const ForceGroup &left = settings.force_groups[1];
+  EXPECT_EQ(left.indices, (std::vector<size_t>{2, 3}));
+  EXPECT_DOUBLE_EQ(left.forceAt(0)[0], 1);
+  EXPECT_DOUBLE_EQ(left.forceAt(5)[0], 0.5);
+
+  left.apply(particles, 5);
+  EXPECT_DOUBLE_EQ(particles[2].getF()[0], 0.5);
+  EXPECT_DOUBLE_EQ(particles[1].getF()[0], 0);
+}
+
+/**
+ * @test Single particles
+ *
+ * Tests if single particles in flow and block style keep all their properties and their order between generators
+ */
+TEST_F(TestYAMLReader, SingleParticles) {
+  std::stringstream input;
+  input << "particles:\n"
+           "  - single:\n"
+           "      position: [1.5, -2, 3e-3]\n"
+           "      velocity:\n"
+           "        - 4\n"
+           "        - 5\n"
+           "        - 6\n"
+           "      force: [0.1, 0.2, 0.3]\n"
+           "      old_force: [0.4, 0.5, 0.6]\n"
+           "      mass: 2.5\n"
+           "      sigma: 1.2\n"
+           "      epsilon: 3\n"
+           "      type: 7\n"
+           "  - cuboid: {position: [0, 0, 0], size: [2, 1, 1], distance: 1, mass: 1, velocity: [0, 0, 0], tag: box}\n"
+           "  - single: {position: [9, 9, 9], velocity: [1, 1, 1], mass: 1, static: true}\n"
+           "simulation:\n"
+           "  worksheet: 3\n";
+
+  YAMLReader::parse(particles, input, settings);
+
+  ASSERT_EQ(particles.size(), 4);
+  EXPECT_EQ(particles[0].getX(), (Vector3{1.5, -2, 3e-3}));
+  EXPECT_EQ(particles[0].getV(), (Vector3{4, 5, 6}));
+  EXPECT_EQ(particles[0].getF(), (Vector3{0.1, 0.2, 0.3}));
+  EXPECT_EQ(particles[0].getOldF(), (Vector3{0.4, 0.5, 0.6}));
+  EXPECT_EQ(particles[0].getM(), 2.5);
+  EXPECT_EQ(particles[0].getSigma(), 1.2);
+  EXPECT_EQ(particles[0].getEpsilon(), 3);
+  EXPECT_EQ(particles[0].getType(), 7);
+  EXPECT_EQ(particles[2].getX(), (Vector3{1, 0, 0}));
+  EXPECT_TRUE(particles[3].isStatic());
+  EXPECT_EQ(particles[3].getV(), (Vector3{0, 0, 0}));
+  EXPECT_EQ(settings.simulation.worksheet, 3);
+}